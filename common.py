@@ -70,6 +70,7 @@ def get_sources(env, is_editor_build):
         "util/memory/*.cpp",
         "util/noise/fast_noise_lite/*.cpp",
         "util/noise/gd_noise_range.cpp",
+        "util/noise/spot_noise.cpp",
         "util/noise/spot_noise_gd.cpp",
         "util/string/*.cpp",
         "util/thread/thread.cpp",
@@ -312,7 +312,7 @@ void VoxelTool::smooth_sphere(Vector3 sphere_center, float sphere_radius, int bl
 		return;
 	}
 
-	VoxelBuffer buffer(VoxelBuffer::ALLOCATOR_POOL);
+	VoxelBuffer buffer(VoxelBuffer::ALLOCATOR_TEMP);
 	buffer.create(padded_voxel_box.size);
 
 	if (_channel == VoxelBuffer::CHANNEL_SDF) {
@@ -320,7 +320,7 @@ void VoxelTool::smooth_sphere(Vector3 sphere_center, float sphere_radius, int bl
 
 		copy(padded_voxel_box.position, buffer, (1 << VoxelBuffer::CHANNEL_SDF));
 
-		VoxelBuffer smooth_buffer(VoxelBuffer::ALLOCATOR_POOL);
+		VoxelBuffer smooth_buffer(VoxelBuffer::ALLOCATOR_TEMP);
 		const Vector3f relative_sphere_center = to_vec3f(sphere_center - to_vec3(voxel_box.position));
 		ops::box_blur(buffer, smooth_buffer, blur_radius, relative_sphere_center, sphere_radius);
 
@@ -346,7 +346,7 @@ void VoxelTool::grow_sphere(Vector3 sphere_center, float sphere_radius, float st
 		return;
 	}
 
-	VoxelBuffer buffer(VoxelBuffer::ALLOCATOR_POOL);
+	VoxelBuffer buffer(VoxelBuffer::ALLOCATOR_TEMP);
 	buffer.create(voxel_box.size);
 
 	if (_channel == VoxelBuffer::CHANNEL_SDF) {
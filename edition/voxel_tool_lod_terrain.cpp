@@ -978,7 +978,7 @@ void VoxelToolLodTerrain::do_graph(Ref<VoxelGeneratorGraph> graph, Transform3D t
 
 	const unsigned int channel_index = VoxelBuffer::CHANNEL_SDF;
 
-	VoxelBuffer buffer(VoxelBuffer::ALLOCATOR_POOL);
+	VoxelBuffer buffer(VoxelBuffer::ALLOCATOR_TEMP);
 	buffer.create(box.size);
 	data.copy(box.position, buffer, 1 << channel_index);
 
@@ -8,7 +8,7 @@ struct Node {
     const char *description;
 };
 
-static const unsigned int COUNT = 59;
+static const unsigned int COUNT = 60;
 static const Node g_data[COUNT] = {
     {"Abs", "Math", "If [code]x[/code] is negative, returns [code]x[/code] as a positive number. Otherwise, returns [code]x[/code]."},
     {"Add", "Ops", "Returns the sum of [code]a[/code] and [code]b[/code]"},
@@ -37,6 +37,7 @@ static const Node g_data[COUNT] = {
     {"InputX", "Input", "Outputs the X coordinate of the current voxel."},
     {"InputY", "Input", "Outputs the Y coordinate of the current voxel."},
     {"InputZ", "Input", "Outputs the Z coordinate of the current voxel."},
+    {"LowFrequencyFunction", "Misc", "Runs a custom function at a lower resolution, which is faster for functions varying slowly in space, such as continent shapes or biome masks. The function is evaluated on a grid aligned to multiples of [code]stride[/code], and results are interpolated linearly between grid points. The function can only have [code]x[/code], [code]y[/code] and [code]z[/code] as inputs, and only its first output is used. If it doesn't use one of these coordinates, interpolation will not happen along that axis.\nDetails smaller than [code]stride[/code] will be lost. When positions are too far apart (for example at high LOD levels), the function is evaluated directly at every position."},
     {"Max", "Math", "Returns the highest value between [code]a[/code] and [code]b[/code]."},
     {"Min", "Math", "Returns the lowest value between [code]a[/code] and [code]b[/code]."},
     {"Mix", "Math", "Interpolates between [code]a[/code] and [code]b[/code], using parameter value [code]t[/code]. If [code]t[/code] is [code]0[/code], [code]a[/code] will be returned. If [code]t[/code] is [code]1[/code], [code]b[/code] will be returned. If [code]t[/code] is beyond the [code][0..1][/code] range, the returned value will be an extrapolation."},
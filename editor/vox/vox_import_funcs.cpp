@@ -1,5 +1,13 @@
 #include "vox_import_funcs.h"
+#include "../../engine/voxel_engine.h"
+#include "../../meshers/cubes/voxel_mesher_cubes.h"
+#include "../../storage/funcs.h"
+#include "../../streams/vox/vox_data.h"
 #include "../../util/godot/classes/array_mesh.h"
+#include "../../util/io/log.h"
+#include "../../util/profiling.h"
+#include "../../util/tasks/async_dependency_tracker.h"
+#include "../../util/thread/thread.h"
 
 namespace zylann {
 
@@ -11,7 +19,12 @@ Ref<Mesh> build_mesh(const VoxelBuffer &voxels, VoxelMesher &mesher, StdVector<u
 	VoxelMesher::Output output;
 	VoxelMesher::Input input = { voxels, nullptr, nullptr, Vector3i(), 0, false };
 	mesher.build(output, input);
+	return build_mesh(output, surface_index_to_material, out_atlas, p_scale, p_offset);
+}
 
+Ref<Mesh> build_mesh(VoxelMesher::Output &output, StdVector<unsigned int> &surface_index_to_material,
+		Ref<Image> &out_atlas, float p_scale, Vector3 p_offset) {
+	//
 	if (output.surfaces.size() == 0) {
 		return Ref<ArrayMesh>();
 	}
@@ -51,5 +64,80 @@ Ref<Mesh> build_mesh(const VoxelBuffer &voxels, VoxelMesher &mesher, StdVector<u
 	return mesh;
 }
 
+namespace {
+
+class MeshModelTask : public IThreadedTask {
+public:
+	MeshModelTask(const Model &model, Ref<VoxelMesher> mesher, unsigned int output_index,
+			std::shared_ptr<ModelMeshingOutputs> outputs, std::shared_ptr<AsyncDependencyTracker> tracker) :
+			_model(model),
+			_mesher(mesher),
+			_output_index(output_index),
+			_outputs(outputs),
+			_tracker(tracker) {}
+
+	void run(ThreadedTaskContext &ctx) override {
+		ZN_PROFILE_SCOPE();
+
+		VoxelBuffer voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+		voxels.create(_model.size + Vector3iUtil::create(VoxelMesherCubes::PADDING * 2));
+		voxels.decompress_channel(VoxelBuffer::CHANNEL_COLOR);
+
+		Span<uint8_t> dst_color_indices;
+		if (voxels.get_channel_raw(VoxelBuffer::CHANNEL_COLOR, dst_color_indices)) {
+			Span<const uint8_t> src_color_indices = to_span_const(_model.color_indexes);
+			copy_3d_region_zxy(dst_color_indices, voxels.get_size(), Vector3iUtil::create(VoxelMesherCubes::PADDING),
+					src_color_indices, _model.size, Vector3i(), _model.size);
+
+			VoxelMesher::Input input = { voxels, nullptr, nullptr, Vector3i(), 0, false };
+			_mesher->build(_outputs->outputs[_output_index], input);
+		} else {
+			ZN_PRINT_ERROR("Failed to access color channel");
+		}
+
+		_outputs->padded_sizes[_output_index] = voxels.get_size();
+		_tracker->post_complete();
+	}
+
+	const char *get_debug_name() const override {
+		return "MeshVoxModel";
+	}
+
+private:
+	// The model is owned by the caller of `mesh_models`, which waits for all tasks to complete
+	const Model &_model;
+	Ref<VoxelMesher> _mesher;
+	const unsigned int _output_index;
+	std::shared_ptr<ModelMeshingOutputs> _outputs;
+	std::shared_ptr<AsyncDependencyTracker> _tracker;
+};
+
+} // namespace
+
+std::shared_ptr<ModelMeshingOutputs> mesh_models(Span<const Model *const> models, Ref<VoxelMesher> mesher) {
+	ZN_PROFILE_SCOPE();
+
+	std::shared_ptr<ModelMeshingOutputs> outputs = make_shared_instance<ModelMeshingOutputs>();
+	outputs->outputs.resize(models.size());
+	outputs->padded_sizes.resize(models.size());
+
+	std::shared_ptr<AsyncDependencyTracker> tracker =
+			make_shared_instance<AsyncDependencyTracker>(models.size());
+
+	StdVector<IThreadedTask *> tasks;
+	tasks.reserve(models.size());
+	for (unsigned int i = 0; i < models.size(); ++i) {
+		ZN_ASSERT(models[i] != nullptr);
+		tasks.push_back(ZN_NEW(MeshModelTask(*models[i], mesher, i, outputs, tracker)));
+	}
+	VoxelEngine::get_singleton().push_async_tasks(to_span(tasks));
+
+	while (!tracker->is_complete()) {
+		Thread::sleep_usec(1000);
+	}
+
+	return outputs;
+}
+
 } // namespace voxel::magica
 } // namespace zylann
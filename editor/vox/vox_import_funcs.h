@@ -2,7 +2,9 @@
 #define VOX_IMPORT_FUNCS_H
 
 #include "../../meshers/voxel_mesher.h"
+#include "../../util/containers/span.h"
 #include "../../util/containers/std_vector.h"
+#include <memory>
 
 // Some common functions to vox importers
 
@@ -11,6 +13,22 @@ namespace zylann::voxel::magica {
 Ref<Mesh> build_mesh(const VoxelBuffer &voxels, VoxelMesher &mesher, StdVector<unsigned int> &surface_index_to_material,
 		Ref<Image> &out_atlas, float p_scale, Vector3 p_offset);
 
+// Same as above, from the output of a mesher that already ran (which can be done in a thread)
+Ref<Mesh> build_mesh(VoxelMesher::Output &output, StdVector<unsigned int> &surface_index_to_material,
+		Ref<Image> &out_atlas, float p_scale, Vector3 p_offset);
+
+struct Model;
+
+// Results are not stored in tasks, because the thread pool deletes them on its own
+struct ModelMeshingOutputs {
+	StdVector<VoxelMesher::Output> outputs;
+	StdVector<Vector3i> padded_sizes;
+};
+
+// Meshes the given models in parallel using the thread pool of the voxel engine, and waits for all of them to finish.
+// Outputs are in the same order as `models`.
+std::shared_ptr<ModelMeshingOutputs> mesh_models(Span<const Model *const> models, Ref<VoxelMesher> mesher);
+
 } // namespace zylann::voxel::magica
 
 #endif // VOX_IMPORT_FUNCS_H
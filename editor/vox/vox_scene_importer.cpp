@@ -285,23 +285,29 @@ Error VoxelVoxSceneImporter::_zn_import(const String &p_source_file, const Strin
 	}
 	materials[1]->set_transparency(StandardMaterial3D::TRANSPARENCY_ALPHA);
 
-	// Build meshes from voxel models
-	for (unsigned int model_index = 0; model_index < data.get_model_count(); ++model_index) {
-		const magica::Model &model = data.get_model(model_index);
+	// Identical models are only meshed once, and share the same mesh resource
+	StdVector<unsigned int> model_to_unique;
+	find_unique_models(data, model_to_unique);
+
+	StdVector<unsigned int> unique_model_indices;
+	StdVector<const Model *> unique_models;
+	for (unsigned int model_index = 0; model_index < model_to_unique.size(); ++model_index) {
+		if (model_to_unique[model_index] == model_index) {
+			unique_model_indices.push_back(model_index);
+			unique_models.push_back(&data.get_model(model_index));
+		}
+	}
 
-		VoxelBuffer voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
-		voxels.create(model.size + Vector3iUtil::create(VoxelMesherCubes::PADDING * 2));
-		voxels.decompress_channel(VoxelBuffer::CHANNEL_COLOR);
+	// Build meshes from voxel models
+	std::shared_ptr<ModelMeshingOutputs> meshing_outputs = mesh_models(to_span_const(unique_models), mesher);
 
-		Span<uint8_t> dst_color_indices;
-		ERR_FAIL_COND_V(!voxels.get_channel_raw(VoxelBuffer::CHANNEL_COLOR, dst_color_indices), ERR_BUG);
-		Span<const uint8_t> src_color_indices = to_span_const(model.color_indexes);
-		copy_3d_region_zxy(dst_color_indices, voxels.get_size(), Vector3iUtil::create(VoxelMesherCubes::PADDING),
-				src_color_indices, model.size, Vector3i(), model.size);
+	for (unsigned int i = 0; i < unique_model_indices.size(); ++i) {
+		const unsigned int model_index = unique_model_indices[i];
 
 		StdVector<unsigned int> surface_index_to_material;
 		Ref<Image> atlas;
-		Ref<Mesh> mesh = magica::build_mesh(voxels, **mesher, surface_index_to_material, atlas, p_scale, Vector3());
+		Ref<Mesh> mesh =
+				magica::build_mesh(meshing_outputs->outputs[i], surface_index_to_material, atlas, p_scale, Vector3());
 
 		if (mesh.is_null()) {
 			continue;
@@ -354,10 +360,19 @@ Error VoxelVoxSceneImporter::_zn_import(const String &p_source_file, const Strin
 		// In MagicaVoxel scene graph, pivots are at the center of models, not at the lower corner.
 		// TODO I don't know if this is correct, but I could not find a reference saying how that pivot should be
 		// calculated
-		mesh_info.pivot = (voxels.get_size() / 2 - Vector3iUtil::create(1));
+		mesh_info.pivot = (meshing_outputs->padded_sizes[i] / 2 - Vector3iUtil::create(1));
 		meshes[model_index] = mesh_info;
 	}
 
+	meshing_outputs.reset();
+
+	for (unsigned int model_index = 0; model_index < model_to_unique.size(); ++model_index) {
+		const unsigned int unique_model_index = model_to_unique[model_index];
+		if (unique_model_index != model_index) {
+			meshes[model_index] = meshes[unique_model_index];
+		}
+	}
+
 	Node3D *root_node = nullptr;
 	if (data.get_root_node_id() != -1) {
 		// Convert scene graph into a node tree
@@ -373,9 +388,12 @@ Error VoxelVoxSceneImporter::_zn_import(const String &p_source_file, const Strin
 	}
 
 	// Save meshes
-	for (unsigned int model_index = 0; model_index < meshes.size(); ++model_index) {
+	for (const unsigned int model_index : unique_model_indices) {
 		ZN_PROFILE_SCOPE();
 		Ref<Mesh> mesh = meshes[model_index].mesh;
+		if (mesh.is_null()) {
+			continue;
+		}
 		String res_save_path = String("{0}.model{1}.mesh").format(varray(p_save_path, model_index));
 		// `FLAG_CHANGE_PATH` did not do what I thought it did.
 		mesh->set_path(res_save_path);
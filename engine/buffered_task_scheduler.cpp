@@ -18,11 +18,9 @@ BufferedTaskScheduler &BufferedTaskScheduler::get_for_current_thread() {
 
 void BufferedTaskScheduler::flush() {
 	ZN_ASSERT(_thread_id == Thread::get_caller_id());
-	if (_main_tasks.size() > 0) {
-		VoxelEngine::get_singleton().push_async_tasks(to_span(_main_tasks));
-	}
-	if (_io_tasks.size() > 0) {
-		VoxelEngine::get_singleton().push_async_io_tasks(to_span(_io_tasks));
+	if (has_tasks()) {
+		// Everything is handed over as a single batch
+		VoxelEngine::get_singleton().push_async_tasks(to_span(_main_tasks), to_span(_io_tasks));
 	}
 	_main_tasks.clear();
 	_io_tasks.clear();
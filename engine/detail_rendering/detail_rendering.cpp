@@ -174,48 +174,142 @@ inline Vector3f encode_normal_xyz(const Vector3f n) {
 	return Vector3f(0.5f) + 0.5f * n;
 }
 
+// Above this amount of voxels, the area covered by queries is considered too large to be read into a dense buffer
+static const unsigned int MAX_DENSE_QUERY_VOLUME = 32 * 32 * 32;
+
+// Fills voxels that were not found in edited data, using the generator and modifiers in a single batch.
+void complete_sdf_with_generator(VoxelGenerator &generator, const VoxelModifierStack &modifiers,
+		Span<const float> x_gen, Span<const float> y_gen, Span<const float> z_gen, Span<const unsigned int> i_gen,
+		Span<float> sd_samples, Vector3f query_min_pos, Vector3f query_max_pos) {
+	ZN_PROFILE_SCOPE();
+
+	if (x_gen.size() == 0) {
+		return;
+	}
+
+	static thread_local StdVector<float> tls_gen_samples;
+	tls_gen_samples.resize(x_gen.size());
+	Span<float> gen_samples = to_span(tls_gen_samples);
+
+	// Note, these samples are not scaled since we are working with floats instead of encoded buffer values.
+	generator.generate_series(
+			x_gen, y_gen, z_gen, VoxelBuffer::CHANNEL_SDF, gen_samples, query_min_pos, query_max_pos);
+
+	modifiers.apply(x_gen, y_gen, z_gen, gen_samples, query_min_pos, query_max_pos);
+
+	for (unsigned int j = 0; j < gen_samples.size(); ++j) {
+		sd_samples[i_gen[j]] = gen_samples[j];
+	}
+}
+
 void query_sdf_with_edits(VoxelGenerator &generator, const VoxelModifierStack &modifiers, const VoxelDataGrid &grid,
 		Span<const float> query_x_buffer, Span<const float> query_y_buffer, Span<const float> query_z_buffer,
 		Span<float> query_sdf_buffer, Vector3f query_min_pos, Vector3f query_max_pos) {
 	ZN_PROFILE_SCOPE();
 
+	if (query_sdf_buffer.size() == 0) {
+		return;
+	}
+
+	const VoxelBuffer::ChannelId channel = VoxelBuffer::CHANNEL_SDF;
+
+	// Each query is interpolated from the 8 voxels around it. Gather all of them first, so that edited voxels are
+	// read in one go, and the generator can process the remaining ones in a single large batch.
+
+	Vector3i min_pos_i = math::floor_to_int(Vector3(query_x_buffer[0], query_y_buffer[0], query_z_buffer[0]));
+	Vector3i max_pos_i = min_pos_i;
+	for (unsigned int query_index = 1; query_index < query_sdf_buffer.size(); ++query_index) {
+		const Vector3i posi = math::floor_to_int(
+				Vector3(query_x_buffer[query_index], query_y_buffer[query_index], query_z_buffer[query_index]));
+		min_pos_i = math::min(min_pos_i, posi);
+		max_pos_i = math::max(max_pos_i, posi);
+	}
+	const Box3i voxel_box = Box3i::from_min_max(min_pos_i, max_pos_i + Vector3i(2, 2, 2));
+
+	static thread_local StdVector<float> tls_x_gen;
+	static thread_local StdVector<float> tls_y_gen;
+	static thread_local StdVector<float> tls_z_gen;
+	static thread_local StdVector<unsigned int> tls_i_gen;
+	tls_x_gen.clear();
+	tls_y_gen.clear();
+	tls_z_gen.clear();
+	tls_i_gen.clear();
+
 	VoxelDataGrid::LockRead rlock(grid);
 
-	for (unsigned int query_index = 0; query_index < query_sdf_buffer.size(); ++query_index) {
-		const Vector3 posf(query_x_buffer[query_index], query_y_buffer[query_index], query_z_buffer[query_index]);
+	if (Vector3iUtil::get_volume(voxel_box.size) <= MAX_DENSE_QUERY_VOLUME) {
+		// Neighbor queries share most of their voxels, read each of them only once.
+		// States: 0: not found in edits, 1: found in edits, 2: pending generation
+		static thread_local StdVector<float> tls_sd_voxels;
+		static thread_local StdVector<uint8_t> tls_voxel_states;
+		const unsigned int volume = Vector3iUtil::get_volume(voxel_box.size);
+		tls_sd_voxels.resize(volume);
+		tls_voxel_states.clear();
+		tls_voxel_states.resize(volume, 0);
+
+		grid.read_box_f(voxel_box, channel, to_span(tls_sd_voxels), to_span(tls_voxel_states));
 
-		// TODO Optimize: broaden the amount of samples done at once to benefit more from bulk processing
-		// Attempting to evaluate multiple values at once when possible: 8 samples for cube of linear interpolation
-		FixedArray<float, 8> sd_samples;
-		FixedArray<float, 8> x_gen;
-		FixedArray<float, 8> y_gen;
-		FixedArray<float, 8> z_gen;
-		FixedArray<uint8_t, 8> i_gen;
-		unsigned int gen_count = 0;
+		// Only generate voxels that are actually used, the box can contain many more
+		for (unsigned int query_index = 0; query_index < query_sdf_buffer.size(); ++query_index) {
+			const Vector3i posi0 = math::floor_to_int(
+					Vector3(query_x_buffer[query_index], query_y_buffer[query_index], query_z_buffer[query_index]));
+			const Vector3i rpos0 = posi0 - voxel_box.position;
 
-		const VoxelBuffer::ChannelId channel = VoxelBuffer::CHANNEL_SDF;
+			for (int z = 0; z < 2; ++z) {
+				for (int x = 0; x < 2; ++x) {
+					for (int y = 0; y < 2; ++y) {
+						const unsigned int loc = Vector3iUtil::get_zxy_index(rpos0 + Vector3i(x, y, z), voxel_box.size);
+						if (tls_voxel_states[loc] == 0) {
+							tls_voxel_states[loc] = 2;
+							tls_x_gen.push_back(posi0.x + x);
+							tls_y_gen.push_back(posi0.y + y);
+							tls_z_gen.push_back(posi0.z + z);
+							tls_i_gen.push_back(loc);
+						}
+					}
+				}
+			}
+		}
+
+		complete_sdf_with_generator(generator, modifiers, to_span(tls_x_gen), to_span(tls_y_gen), to_span(tls_z_gen),
+				to_span(tls_i_gen), to_span(tls_sd_voxels), query_min_pos, query_max_pos);
+
+		// Interpolate
+		const int dy = 1;
+		const int dx = voxel_box.size.y;
+		const int dz = voxel_box.size.y * voxel_box.size.x;
+		const Span<const float> sd = to_span_const(tls_sd_voxels);
+		for (unsigned int query_index = 0; query_index < query_sdf_buffer.size(); ++query_index) {
+			const Vector3 posf(query_x_buffer[query_index], query_y_buffer[query_index], query_z_buffer[query_index]);
+			const Vector3i posi0 = math::floor_to_int(posf);
+			const int i = Vector3iUtil::get_zxy_index(posi0 - voxel_box.position, voxel_box.size);
+
+			query_sdf_buffer[query_index] = math::interpolate_trilinear( //
+					sd[i], sd[i + dx], sd[i + dx + dz], sd[i + dz], //
+					sd[i + dy], sd[i + dx + dy], sd[i + dx + dy + dz], sd[i + dy + dz], //
+					math::fract(posf));
+		}
+
+	} else {
+		// Too large to read densely, gather voxels individually
+		static thread_local StdVector<float> tls_sd_samples;
+		tls_sd_samples.resize(query_sdf_buffer.size() * 8);
 
-		const Vector3i posi0 = math::floor_to_int(posf);
 		unsigned int i = 0;
+		for (unsigned int query_index = 0; query_index < query_sdf_buffer.size(); ++query_index) {
+			const Vector3i posi0 = math::floor_to_int(
+					Vector3(query_x_buffer[query_index], query_y_buffer[query_index], query_z_buffer[query_index]));
 
-		// Gather 8 samples from edited voxels
-		{
-			ZN_PROFILE_SCOPE();
 			for (int z = 0; z < 2; ++z) {
 				for (int y = 0; y < 2; ++y) {
 					for (int x = 0; x < 2; ++x) {
 						const Vector3i posi = posi0 + Vector3i(x, y, z);
-						// TODO Optimize: instead of locking for individual samples, lock the area with a spatial lock
-						//      (because we can't lock multiple blocks at once otherwise it causes deadlocks)
-						// TODO Optimize: the grid could be told to gather raw channels so we get direct access
-						//      (requires the former optimization)
-						if (!grid.try_get_voxel_f(posi, sd_samples[i], channel)) {
+						if (!grid.try_get_voxel_f(posi, tls_sd_samples[i], channel)) {
 							// Not edited, add to the list of voxels to generate
-							x_gen[gen_count] = posi.x;
-							y_gen[gen_count] = posi.y;
-							z_gen[gen_count] = posi.z;
-							i_gen[gen_count] = i;
-							++gen_count;
+							tls_x_gen.push_back(posi.x);
+							tls_y_gen.push_back(posi.y);
+							tls_z_gen.push_back(posi.z);
+							tls_i_gen.push_back(i);
 						}
 						++i;
 					}
@@ -223,28 +317,17 @@ void query_sdf_with_edits(VoxelGenerator &generator, const VoxelModifierStack &m
 			}
 		}
 
-		// Complete samples with generator. Note, these samples are not scaled since we are working with floats instead
-		// of encoded buffer values.
-		if (gen_count > 0) {
-			ZN_PROFILE_SCOPE();
-			FixedArray<float, 8> gen_samples;
-
-			generator.generate_series(to_span(x_gen, gen_count), to_span(y_gen, gen_count), to_span(z_gen, gen_count),
-					channel, to_span(gen_samples, gen_count), query_min_pos, query_max_pos);
-
-			modifiers.apply(to_span(x_gen, gen_count), to_span(y_gen, gen_count), to_span(z_gen, gen_count),
-					to_span(gen_samples, gen_count), query_min_pos, query_max_pos);
-
-			for (unsigned int j = 0; j < gen_count; ++j) {
-				sd_samples[i_gen[j]] = gen_samples[j];
-			}
-		}
+		complete_sdf_with_generator(generator, modifiers, to_span(tls_x_gen), to_span(tls_y_gen), to_span(tls_z_gen),
+				to_span(tls_i_gen), to_span(tls_sd_samples), query_min_pos, query_max_pos);
 
 		// Interpolate
-		const float sd_interp = math::interpolate_trilinear(sd_samples[0], sd_samples[1], sd_samples[5], sd_samples[4],
-				sd_samples[2], sd_samples[3], sd_samples[7], sd_samples[6], math::fract(posf));
+		for (unsigned int query_index = 0; query_index < query_sdf_buffer.size(); ++query_index) {
+			const Vector3 posf(query_x_buffer[query_index], query_y_buffer[query_index], query_z_buffer[query_index]);
+			const Span<const float> sd = to_span_const(tls_sd_samples).sub(query_index * 8, 8);
 
-		query_sdf_buffer[query_index] = sd_interp;
+			query_sdf_buffer[query_index] = math::interpolate_trilinear(
+					sd[0], sd[1], sd[5], sd[4], sd[2], sd[3], sd[7], sd[6], math::fract(posf));
+		}
 	}
 }
 
@@ -0,0 +1,18 @@
+#ifndef VOXEL_INSTANCE_GENERATOR_OUTPUT_H
+#define VOXEL_INSTANCE_GENERATOR_OUTPUT_H
+
+#include "../util/containers/std_vector.h"
+#include "../util/math/transform3f.h"
+#include <cstdint>
+
+namespace zylann::voxel {
+
+// Instances generated procedurally on the mesh of a block, for one layer
+struct VoxelInstanceGeneratorOutput {
+	uint16_t layer_id;
+	StdVector<Transform3f> transforms;
+};
+
+} // namespace zylann::voxel
+
+#endif // VOXEL_INSTANCE_GENERATOR_OUTPUT_H
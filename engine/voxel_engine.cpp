@@ -311,6 +311,10 @@ void VoxelEngine::push_async_io_tasks(Span<zylann::IThreadedTask *> tasks) {
 	_general_thread_pool.enqueue(tasks, true);
 }
 
+void VoxelEngine::push_async_tasks(Span<zylann::IThreadedTask *> tasks, Span<zylann::IThreadedTask *> io_tasks) {
+	_general_thread_pool.enqueue(tasks, io_tasks);
+}
+
 void VoxelEngine::push_gpu_task(IGPUTask *task) {
 	_gpu_task_runner.push(task);
 }
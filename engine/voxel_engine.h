@@ -1,6 +1,7 @@
 #ifndef VOXEL_ENGINE_H
 #define VOXEL_ENGINE_H
 
+#include "../meshers/mesh_recycling.h"
 #include "../meshers/voxel_mesher.h"
 #include "../streams/instance_data.h"
 #include "../util/containers/slot_map.h"
@@ -17,6 +18,7 @@
 #include "gpu/gpu_storage_buffer_pool.h"
 #include "gpu/gpu_task_runner.h"
 #include "ids.h"
+#include "instance_generator_output.h"
 #include "priority_dependency.h"
 
 ZN_GODOT_FORWARD_DECLARE(class RenderingDevice);
@@ -58,6 +60,21 @@ public:
 		// Can be null. Attached to meshing output so it is tracked more easily, because it is baked asynchronously
 		// starting from the mesh task, and it might complete earlier or later than the mesh.
 		std::shared_ptr<DetailTextureOutput> detail_textures;
+		// Only computed if the task was asked to recycle the previous mesh of the block.
+		MeshSignature mesh_signature;
+		// Signature of the mesh the block had when the task was scheduled. The following fields can only be used if
+		// the block still has that mesh.
+		MeshSignature previous_mesh_signature;
+		// If true, the new mesh is identical to the previous one, which can be kept. `mesh` is not built.
+		bool mesh_unchanged = false;
+		// If not empty, the new mesh has the same layout as the previous one, which can be updated in place with this
+		// vertex data. `mesh` is not built.
+		StdVector<MeshSurfaceVertexData> mesh_vertex_data;
+		// Procedural instances generated on the mesh, for every layer having a generator. Only filled if the task was
+		// given an instance library.
+		StdVector<VoxelInstanceGeneratorOutput> generated_instances;
+		// Revision of the mesh cache of the volume at the time meshing was scheduled, if it uses one
+		uint32_t mesh_cache_revision = 0;
 	};
 
 	struct BlockDataOutput {
@@ -185,6 +202,8 @@ public:
 	void push_async_io_task(IThreadedTask *task);
 	// Thread-safe.
 	void push_async_io_tasks(Span<IThreadedTask *> tasks);
+	// Thread-safe. Schedules general and I/O tasks together.
+	void push_async_tasks(Span<IThreadedTask *> tasks, Span<IThreadedTask *> io_tasks);
 	void push_gpu_task(IGPUTask *task);
 
 	void process();
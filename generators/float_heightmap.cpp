@@ -0,0 +1,130 @@
+#include "float_heightmap.h"
+#include "../util/errors.h"
+#include "../util/godot/classes/image.h"
+#include "../util/profiling.h"
+#include "../util/string/format.h"
+
+namespace zylann::voxel {
+
+void FloatHeightmap::create_from_image(const Image &im, bool with_mips) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT_RETURN_MSG(!im.is_compressed(), format("Image format not supported: {}", im.get_format()));
+
+	clear();
+
+	const int width = im.get_width();
+	const int height = im.get_height();
+	if (width == 0 || height == 0) {
+		return;
+	}
+
+	{
+		Mip &mip = _mips[0];
+		mip.width = width;
+		mip.height = height;
+		mip.pixels.resize(width * height);
+		// Decoding is slow, but it only happens once
+		unsigned int i = 0;
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				mip.pixels[i] = im.get_pixel(x, y).r;
+				++i;
+			}
+		}
+	}
+
+	_mip_count = 1;
+
+	// Downscale with a box filter until we reach a single pixel
+	for (; with_mips && _mip_count < MAX_MIPS; ++_mip_count) {
+		const Mip &src = _mips[_mip_count - 1];
+		if (src.width == 1 && src.height == 1) {
+			break;
+		}
+
+		Mip &dst = _mips[_mip_count];
+		dst.width = math::max(math::ceildiv(src.width, 2), 1);
+		dst.height = math::max(math::ceildiv(src.height, 2), 1);
+		dst.pixels.resize(dst.width * dst.height);
+
+		unsigned int i = 0;
+		for (int y = 0; y < dst.height; ++y) {
+			const int sy0 = y * 2;
+			// Odd sizes wrap around, like sampling does
+			const int sy1 = (sy0 + 1) % src.height;
+			for (int x = 0; x < dst.width; ++x) {
+				const int sx0 = x * 2;
+				const int sx1 = (sx0 + 1) % src.width;
+				const float sum = src.pixels[sx0 + sy0 * src.width] + src.pixels[sx1 + sy0 * src.width] +
+						src.pixels[sx0 + sy1 * src.width] + src.pixels[sx1 + sy1 * src.width];
+				dst.pixels[i] = sum * 0.25f;
+				++i;
+			}
+		}
+	}
+
+	for (unsigned int mip_index = 0; mip_index < _mip_count; ++mip_index) {
+		Mip &mip = _mips[mip_index];
+		mip.mask_x = math::is_power_of_two(mip.width) ? mip.width - 1 : -1;
+		mip.mask_y = math::is_power_of_two(mip.height) ? mip.height - 1 : -1;
+		mip.scale_x = static_cast<float>(mip.width) / width;
+		mip.scale_y = static_cast<float>(mip.height) / height;
+	}
+}
+
+void FloatHeightmap::clear() {
+	for (unsigned int mip_index = 0; mip_index < _mip_count; ++mip_index) {
+		Mip &mip = _mips[mip_index];
+		mip.pixels.clear();
+		mip.pixels.shrink_to_fit();
+		mip.width = 0;
+		mip.height = 0;
+	}
+	_mip_count = 0;
+}
+
+void FloatHeightmap::sample_nearest_repeat(
+		Span<const float> x_buffer, Span<const float> y_buffer, Span<float> out_values) const {
+	ZN_ASSERT_RETURN(x_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(y_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(!is_empty());
+
+	const Mip &mip = _mips[0];
+
+	if (mip.mask_x >= 0 && mip.mask_y >= 0) {
+		// Common case, no divisions
+		const float *pixels = mip.pixels.data();
+		for (unsigned int i = 0; i < out_values.size(); ++i) {
+			const int x = static_cast<int>(x_buffer[i]) & mip.mask_x;
+			const int y = static_cast<int>(y_buffer[i]) & mip.mask_y;
+			out_values[i] = pixels[x + y * mip.width];
+		}
+	} else {
+		for (unsigned int i = 0; i < out_values.size(); ++i) {
+			out_values[i] = get_pixel_repeat(mip, static_cast<int>(x_buffer[i]), static_cast<int>(y_buffer[i]));
+		}
+	}
+}
+
+void FloatHeightmap::sample_bilinear_repeat(Span<const float> x_buffer, Span<const float> y_buffer,
+		Span<float> out_values, unsigned int mip_index) const {
+	ZN_ASSERT_RETURN(x_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(y_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(!is_empty());
+
+	if (mip_index == 0) {
+		const Mip &mip = _mips[0];
+		for (unsigned int i = 0; i < out_values.size(); ++i) {
+			out_values[i] = sample_bilinear_repeat(mip, x_buffer[i], y_buffer[i]);
+		}
+	} else {
+		const Mip &mip = _mips[math::min(mip_index, _mip_count - 1)];
+		for (unsigned int i = 0; i < out_values.size(); ++i) {
+			const float x = (x_buffer[i] + 0.5f) * mip.scale_x - 0.5f;
+			const float y = (y_buffer[i] + 0.5f) * mip.scale_y - 0.5f;
+			out_values[i] = sample_bilinear_repeat(mip, x, y);
+		}
+	}
+}
+
+} // namespace zylann::voxel
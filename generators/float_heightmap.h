@@ -0,0 +1,122 @@
+#ifndef VOXEL_FLOAT_HEIGHTMAP_H
+#define VOXEL_FLOAT_HEIGHTMAP_H
+
+#include "../util/containers/fixed_array.h"
+#include "../util/containers/span.h"
+#include "../util/containers/std_vector.h"
+#include "../util/godot/macros.h"
+#include "../util/math/funcs.h"
+
+ZN_GODOT_FORWARD_DECLARE(class Image)
+
+namespace zylann::voxel {
+
+// Red channel of an image decoded into floats, with a chain of downscaled versions (mips).
+// `Image::get_pixel` has to decode the image's format every time it is called, which is slow when sampling every
+// voxel of a block. This is meant to be created once when the image is assigned, then sampled many times.
+// Sampling treats the image as if it repeats infinitely. Coordinates are in pixels of the original image.
+// Read-only once created, so it can be sampled from multiple threads.
+class FloatHeightmap {
+public:
+	static const unsigned int MAX_MIPS = 16;
+
+	// Mips are only needed when sampling with a mip index. Without them, only the original size is stored.
+	void create_from_image(const Image &im, bool with_mips);
+	void clear();
+
+	inline bool is_empty() const {
+		return _mip_count == 0;
+	}
+
+	inline int get_width() const {
+		return _mips[0].width;
+	}
+
+	inline int get_height() const {
+		return _mips[0].height;
+	}
+
+	inline unsigned int get_mip_count() const {
+		return _mip_count;
+	}
+
+	inline float get_pixel_repeat(int x, int y) const {
+		const Mip &mip = _mips[0];
+		return mip.pixels[wrap(x, mip.width, mip.mask_x) + wrap(y, mip.height, mip.mask_y) * mip.width];
+	}
+
+	// Coordinates are truncated, the same way `Image::get_pixel` would get them as integers
+	inline float sample_nearest_repeat(float x, float y) const {
+		return get_pixel_repeat(static_cast<int>(x), static_cast<int>(y));
+	}
+
+	inline float sample_bilinear_repeat(float x, float y) const {
+		return sample_bilinear_repeat(_mips[0], x, y);
+	}
+
+	// Samples a downscaled version of the image, which is faster and smoother when sampling positions are far
+	// apart. Each mip is half the size of the previous one, so `mip_index` can be a LOD index. If the heightmap was
+	// created without mips, the original image is sampled.
+	inline float sample_bilinear_repeat(float x, float y, unsigned int mip_index) const {
+		if (mip_index == 0) {
+			return sample_bilinear_repeat(_mips[0], x, y);
+		}
+		const Mip &mip = _mips[math::min(mip_index, _mip_count - 1)];
+		// Pixel centers of the mip are not on pixel centers of the original
+		return sample_bilinear_repeat(mip, (x + 0.5f) * mip.scale_x - 0.5f, (y + 0.5f) * mip.scale_y - 0.5f);
+	}
+
+	void sample_nearest_repeat(Span<const float> x_buffer, Span<const float> y_buffer, Span<float> out_values) const;
+	void sample_bilinear_repeat(Span<const float> x_buffer, Span<const float> y_buffer, Span<float> out_values,
+			unsigned int mip_index = 0) const;
+
+private:
+	struct Mip {
+		StdVector<float> pixels;
+		int width = 0;
+		int height = 0;
+		// Used for fast wrapping when the size is a power of two, -1 otherwise
+		int mask_x = -1;
+		int mask_y = -1;
+		// Size relative to the original image
+		float scale_x = 1.f;
+		float scale_y = 1.f;
+	};
+
+	static inline int wrap(int x, int size, int mask) {
+		return mask >= 0 ? (x & mask) : math::wrap(x, size);
+	}
+
+	static inline float get_pixel_repeat(const Mip &mip, int x, int y) {
+		return mip.pixels[wrap(x, mip.width, mip.mask_x) + wrap(y, mip.height, mip.mask_y) * mip.width];
+	}
+
+	static inline float sample_bilinear_repeat(const Mip &mip, float x, float y) {
+		const float xf0 = Math::floor(x);
+		const float yf0 = Math::floor(y);
+		const int x0 = static_cast<int>(xf0);
+		const int y0 = static_cast<int>(yf0);
+		const float xf = x - xf0;
+		const float yf = y - yf0;
+
+		const int ix0 = wrap(x0, mip.width, mip.mask_x);
+		const int ix1 = wrap(x0 + 1, mip.width, mip.mask_x);
+		const int row0 = wrap(y0, mip.height, mip.mask_y) * mip.width;
+		const int row1 = wrap(y0 + 1, mip.height, mip.mask_y) * mip.width;
+
+		const float *pixels = mip.pixels.data();
+		const float h00 = pixels[ix0 + row0];
+		const float h10 = pixels[ix1 + row0];
+		const float h01 = pixels[ix0 + row1];
+		const float h11 = pixels[ix1 + row1];
+
+		return Math::lerp(Math::lerp(h00, h10, xf), Math::lerp(h01, h11, xf), yf);
+	}
+
+	FixedArray<Mip, MAX_MIPS> _mips;
+	unsigned int _mip_count = 0;
+};
+
+} // namespace zylann::voxel
+
+#endif // VOXEL_FLOAT_HEIGHTMAP_H
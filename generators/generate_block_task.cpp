@@ -61,6 +61,10 @@ void GenerateBlockTask::run(zylann::ThreadedTaskContext &ctx) {
 		}
 	} else {
 		run_cpu_generation();
+		if (_cancellation_token.is_valid_and_cancelled()) {
+			// Cancelled while generating, the block will be reported as dropped
+			return;
+		}
 		run_stream_saving_and_finish();
 	}
 }
@@ -78,6 +82,15 @@ void GenerateBlockTask::run_gpu_task(zylann::ThreadedTaskContext &ctx) {
 	const Vector3i origin_in_voxels = (_position << _lod_index) * _block_size;
 
 	ZN_ASSERT(_voxels != nullptr);
+
+	// GPU results are not put in the shared cache because they include modifiers, but CPU results can be used
+	if (generator->get_block_cache().try_get(
+				_position, _lod_index, _block_size, _volume_id, *_voxels, _max_lod_hint)) {
+		apply_modifiers(origin_in_voxels);
+		_stage = 2;
+		return;
+	}
+
 	VoxelGenerator::VoxelQueryData generator_query{ *_voxels, origin_in_voxels, _lod_index };
 	if (generator->generate_broad_block(generator_query)) {
 		_stage = 2;
@@ -127,13 +140,29 @@ void GenerateBlockTask::run_cpu_generation() {
 
 	Ref<VoxelGenerator> generator = _stream_dependency->generator;
 
-	VoxelGenerator::VoxelQueryData query_data{ *_voxels, origin_in_voxels, _lod_index };
-	const VoxelGenerator::Result result = generator->generate_block(query_data);
-	_max_lod_hint = result.max_lod_hint;
+	// Other volumes using the same generator might have generated this block already
+	VoxelGeneratorBlockCache &block_cache = generator->get_block_cache();
+	if (!block_cache.try_get(_position, _lod_index, _block_size, _volume_id, *_voxels, _max_lod_hint)) {
+		const uint32_t cache_revision = block_cache.get_revision();
 
-	if (_data != nullptr) {
-		_data->get_modifiers().apply(query_data.voxel_buffer,
-				AABB(query_data.origin_in_voxels, query_data.voxel_buffer.get_size() << _lod_index));
+		VoxelGenerator::VoxelQueryData query_data{ *_voxels, origin_in_voxels, _lod_index, _cancellation_token };
+		const VoxelGenerator::Result result = generator->generate_block(query_data);
+		_max_lod_hint = result.max_lod_hint;
+
+		if (_cancellation_token.is_valid_and_cancelled()) {
+			return;
+		}
+		// Stored before modifiers, which are specific to each volume
+		block_cache.put(_position, _lod_index, _block_size, _volume_id, *_voxels, _max_lod_hint, cache_revision);
+	}
+
+	apply_modifiers(origin_in_voxels);
+}
+
+void GenerateBlockTask::apply_modifiers(Vector3i origin_in_voxels) {
+	if (_data != nullptr && !_cancellation_token.is_valid_and_cancelled()) {
+		_data->get_modifiers().apply(
+				*_voxels, AABB(origin_in_voxels, _voxels->get_size() << _lod_index), _cancellation_token);
 	}
 }
 
@@ -37,6 +37,7 @@ private:
 	void run_gpu_task(zylann::ThreadedTaskContext &ctx);
 	void run_gpu_conversion();
 	void run_cpu_generation();
+	void apply_modifiers(Vector3i origin_in_voxels);
 	void run_stream_saving_and_finish();
 
 	// Not an input, but can be assigned a re-usable instance to avoid allocating one in the task
@@ -0,0 +1,44 @@
+#include "curve_lut.h"
+#include "../../util/errors.h"
+#include "../../util/godot/classes/curve.h"
+#include "../../util/profiling.h"
+
+namespace zylann {
+
+void CurveLUT::create(Curve &curve) {
+	ZN_PROFILE_SCOPE();
+
+	const int res = curve.get_bake_resolution();
+	_values.resize(math::max(res, 1));
+
+	if (_values.size() == 1) {
+		_values[0] = curve.sample_baked(0.f);
+		return;
+	}
+
+	// Sampling exactly where values were baked, so we get them as they are
+	for (unsigned int i = 0; i < _values.size(); ++i) {
+		_values[i] = curve.sample_baked(get_x(i));
+	}
+}
+
+void CurveLUT::sample(Span<const float> x_buffer, Span<float> out_values) const {
+	ZN_ASSERT_RETURN(x_buffer.size() == out_values.size());
+
+	const unsigned int count = _values.size();
+	if (count < 2) {
+		out_values.fill(count == 0 ? 0.f : _values[0]);
+		return;
+	}
+
+	const float *values = _values.data();
+	const unsigned int last = count - 1;
+
+	for (unsigned int i = 0; i < out_values.size(); ++i) {
+		const float fi = clamp_index(x_buffer[i] * last, last);
+		const unsigned int vi = math::min(static_cast<unsigned int>(fi), last - 1);
+		out_values[i] = Math::lerp(values[vi], values[vi + 1], fi - vi);
+	}
+}
+
+} // namespace zylann
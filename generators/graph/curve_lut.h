@@ -0,0 +1,65 @@
+#ifndef ZN_CURVE_LUT_H
+#define ZN_CURVE_LUT_H
+
+#include "../../util/containers/span.h"
+#include "../../util/containers/std_vector.h"
+#include "../../util/godot/macros.h"
+#include "../../util/math/funcs.h"
+
+ZN_GODOT_FORWARD_DECLARE(class Curve)
+
+namespace zylann {
+
+// Values of a curve baked at regular intervals over X in [0..1], sampled the same way as `Curve::sample_baked`.
+// Godot's `Curve` bakes itself lazily when sampled, so sampling it from multiple threads is not safe. This copy is
+// immutable once created, and doesn't involve any API call when sampled.
+class CurveLUT {
+public:
+	void create(Curve &curve);
+
+	inline float sample(float x) const {
+		const float *values = _values.data();
+		const unsigned int count = _values.size();
+		if (count < 2) {
+			return count == 0 ? 0.f : values[0];
+		}
+		const unsigned int last = count - 1;
+		const float fi = clamp_index(x * last, last);
+		const unsigned int i = math::min(static_cast<unsigned int>(fi), last - 1);
+		return Math::lerp(values[i], values[i + 1], fi - i);
+	}
+
+	void sample(Span<const float> x_buffer, Span<float> out_values) const;
+
+	inline unsigned int get_resolution() const {
+		return _values.size();
+	}
+
+	// Gets X of a baked value
+	inline float get_x(unsigned int i) const {
+		return static_cast<float>(i) / (_values.size() - 1);
+	}
+
+	// Gets a baked value
+	inline float get_value(unsigned int i) const {
+		return _values[i];
+	}
+
+private:
+	static inline float clamp_index(float fi, unsigned int last) {
+		// Also handles NaN
+		if (!(fi > 0.f)) {
+			return 0.f;
+		}
+		if (fi > last) {
+			return last;
+		}
+		return fi;
+	}
+
+	StdVector<float> _values;
+};
+
+} // namespace zylann
+
+#endif // ZN_CURVE_LUT_H
@@ -6,6 +6,7 @@
 #include "nodes/curve.h"
 #include "nodes/image.h"
 #include "nodes/inputs.h"
+#include "nodes/low_frequency.h"
 #include "nodes/math_funcs.h"
 #include "nodes/math_ops.h"
 #include "nodes/math_vectors.h"
@@ -75,6 +76,7 @@ NodeTypeDB::NodeTypeDB() {
 	register_curve_node(types);
 	register_image_nodes(types);
 	register_input_nodes(types);
+	register_low_frequency_node(types);
 	register_output_nodes(types);
 	register_math_func_nodes(types);
 	register_math_ops_nodes(types);
@@ -1,5 +1,6 @@
 #include "../../../util/godot/classes/curve.h"
 #include "../../../util/profiling.h"
+#include "../curve_lut.h"
 #include "../node_type_db.h"
 #include "../range_utility.h"
 
@@ -10,8 +11,7 @@ void register_curve_node(Span<NodeType> types) {
 
 	{
 		struct Params {
-			// TODO Should be `const` but isn't because it auto-bakes, and it's a concern for multithreading
-			Curve *curve;
+			const CurveLUT *lut;
 			const CurveRangeData *curve_range_data;
 		};
 		NodeType &t = types[VoxelGraphFunction::NODE_CURVE];
@@ -36,15 +36,17 @@ void register_curve_node(Span<NodeType> types) {
 				ctx.make_error(String(ZN_TTR("{0} instance is null")).format(varray(Curve::get_class_static())));
 				return;
 			}
-			// Make sure it is baked. We don't want multithreading to bail out because of a write operation
-			// happening in `interpolate_baked`...
-			curve->bake();
+			// Copy baked values so we don't have to call into `Curve` when running the graph. It bakes lazily, which
+			// isn't thread-safe, and the copy also won't change if the curve is modified while the graph is used.
+			CurveLUT *lut = ZN_NEW(CurveLUT);
+			lut->create(**curve);
 			CurveRangeData *curve_range_data = ZN_NEW(CurveRangeData);
-			get_curve_monotonic_sections(**curve, curve_range_data->sections);
+			get_curve_monotonic_sections(*lut, curve_range_data->sections);
 			Params p;
+			p.lut = lut;
 			p.curve_range_data = curve_range_data;
-			p.curve = *curve;
 			ctx.set_params(p);
+			ctx.add_delete_cleanup(lut);
 			ctx.add_delete_cleanup(curve_range_data);
 		};
 		t.process_buffer_func = [](Runtime::ProcessBufferContext &ctx) {
@@ -52,18 +54,16 @@ void register_curve_node(Span<NodeType> types) {
 			const Runtime::Buffer &a = ctx.get_input(0);
 			Runtime::Buffer &out = ctx.get_output(0);
 			const Params p = ctx.get_params<Params>();
-			for (uint32_t i = 0; i < out.size; ++i) {
-				out.data[i] = p.curve->sample_baked(a.data[i]);
-			}
+			p.lut->sample(Span<const float>(a.data, out.size), Span<float>(out.data, out.size));
 		};
 		t.range_analysis_func = [](Runtime::RangeAnalysisContext &ctx) {
 			const Interval a = ctx.get_input(0);
 			const Params p = ctx.get_params<Params>();
 			if (a.is_single_value()) {
-				const float v = p.curve->sample_baked(a.min);
+				const float v = p.lut->sample(a.min);
 				ctx.set_output(0, Interval::from_single_value(v));
 			} else {
-				const Interval r = get_curve_range(*p.curve, p.curve_range_data->sections, a);
+				const Interval r = get_curve_range(*p.lut, p.curve_range_data->sections, a);
 				ctx.set_output(0, r);
 			}
 		};
@@ -1,33 +1,12 @@
 #include "../../../constants/voxel_constants.h"
 #include "../../../util/godot/classes/image.h"
 #include "../../../util/profiling.h"
+#include "../../float_heightmap.h"
 #include "../image_range_grid.h"
 #include "../node_type_db.h"
 
 namespace zylann::voxel::pg {
 
-inline float get_pixel_repeat(const Image &im, int x, int y, int w, int h) {
-	return im.get_pixel(math::wrap(x, w), math::wrap(y, h)).r;
-}
-
-inline float get_pixel_repeat_linear(const Image &im, float x, float y, int im_w, int im_h) {
-	const int x0 = int(Math::floor(x));
-	const int y0 = int(Math::floor(y));
-
-	const float xf = x - x0;
-	const float yf = y - y0;
-
-	const float h00 = get_pixel_repeat(im, x0, y0, im_w, im_h);
-	const float h10 = get_pixel_repeat(im, x0 + 1, y0, im_w, im_h);
-	const float h01 = get_pixel_repeat(im, x0, y0 + 1, im_w, im_h);
-	const float h11 = get_pixel_repeat(im, x0 + 1, y0 + 1, im_w, im_h);
-
-	// Bilinear filter
-	const float h = Math::lerp(Math::lerp(h00, h10, xf), Math::lerp(h01, h11, xf), yf);
-
-	return h;
-}
-
 inline float skew3(float x) {
 	return (x * x * x + x) * 0.5f;
 }
@@ -37,8 +16,8 @@ inline math::Interval skew3(math::Interval x) {
 }
 
 // This is mostly useful for generating planets from an existing heightmap
-inline float sdf_sphere_heightmap(float x, float y, float z, float r, float m, const Image &im, float min_h,
-		float max_h, float norm_x, float norm_y) {
+inline float sdf_sphere_heightmap(float x, float y, float z, float r, float m, const FloatHeightmap &heightmap,
+		float min_h, float max_h, float norm_x, float norm_y) {
 	const float d = Math::sqrt(x * x + y * y + z * z) + 0.0001f;
 	const float sd = d - r;
 	// Optimize when far enough from heightmap.
@@ -59,7 +38,7 @@ inline float sdf_sphere_heightmap(float x, float y, float z, float r, float m, c
 	const float ys = skew3(ny);
 	const float uvy = -0.5f * ys + 0.5f;
 	// TODO Could use bicubic interpolation when the image is sampled at lower resolution than voxels
-	const float h = get_pixel_repeat_linear(im, uvx * norm_x, uvy * norm_y, im.get_width(), im.get_height());
+	const float h = heightmap.sample_bilinear_repeat(uvx * norm_x, uvy * norm_y);
 	return sd - m * h;
 }
 
@@ -102,7 +81,7 @@ void register_image_nodes(Span<NodeType> types) {
 	{
 		enum Filter : uint32_t { FILTER_NEAREST = 0, FILTER_BILINEAR };
 		struct Params {
-			const Image *image;
+			const FloatHeightmap *heightmap;
 			const ImageRangeGrid *image_range_grid;
 			Filter filter;
 		};
@@ -130,14 +109,23 @@ void register_image_nodes(Span<NodeType> types) {
 									   .format(varray(Image::get_class_static())));
 				return;
 			}
+			FloatHeightmap *heightmap = ZN_NEW(FloatHeightmap);
+			// Graph nodes only sample the original image
+			heightmap->create_from_image(**image, false);
+			if (heightmap->is_empty()) {
+				ZN_DELETE(heightmap);
+				ctx.make_error(String(ZN_TTR("{0} is empty")).format(varray(Image::get_class_static())));
+				return;
+			}
 			ImageRangeGrid *im_range = ZN_NEW(ImageRangeGrid);
 			im_range->generate(**image);
 			Params p;
-			p.image = *image;
+			p.heightmap = heightmap;
 			p.image_range_grid = im_range;
 			p.filter = static_cast<Filter>(static_cast<int>(ctx.get_param(1)));
 			ctx.set_params(p);
 			ctx.add_delete_cleanup(im_range);
+			ctx.add_delete_cleanup(heightmap);
 		};
 		t.process_buffer_func = [](Runtime::ProcessBufferContext &ctx) {
 			ZN_PROFILE_SCOPE_NAMED("NODE_IMAGE_2D");
@@ -145,19 +133,13 @@ void register_image_nodes(Span<NodeType> types) {
 			const Runtime::Buffer &y = ctx.get_input(1);
 			Runtime::Buffer &out = ctx.get_output(0);
 			const Params p = ctx.get_params<Params>();
-			const Image &im = *p.image;
-			// Cache image size to reduce API calls in GDExtension
-			const int w = im.get_width();
-			const int h = im.get_width();
-			// TODO Optimized path for most used formats, `get_pixel` is kinda slow
+			const Span<const float> xs(x.data, out.size);
+			const Span<const float> ys(y.data, out.size);
+			const Span<float> values(out.data, out.size);
 			if (p.filter == FILTER_NEAREST) {
-				for (uint32_t i = 0; i < out.size; ++i) {
-					out.data[i] = get_pixel_repeat(im, x.data[i], y.data[i], w, h);
-				}
+				p.heightmap->sample_nearest_repeat(xs, ys, values);
 			} else {
-				for (uint32_t i = 0; i < out.size; ++i) {
-					out.data[i] = get_pixel_repeat_linear(im, x.data[i], y.data[i], w, h);
-				}
+				p.heightmap->sample_bilinear_repeat(xs, ys, values);
 			}
 		};
 		t.range_analysis_func = [](Runtime::RangeAnalysisContext &ctx) {
@@ -179,7 +161,7 @@ void register_image_nodes(Span<NodeType> types) {
 			float max_height;
 			float norm_x;
 			float norm_y;
-			const Image *image;
+			const FloatHeightmap *heightmap;
 			const ImageRangeGrid *image_range_grid;
 		};
 
@@ -205,6 +187,14 @@ void register_image_nodes(Span<NodeType> types) {
 									   .format(varray(Image::get_class_static())));
 				return;
 			}
+			FloatHeightmap *heightmap = ZN_NEW(FloatHeightmap);
+			// Graph nodes only sample the original image
+			heightmap->create_from_image(**image, false);
+			if (heightmap->is_empty()) {
+				ZN_DELETE(heightmap);
+				ctx.make_error(String(ZN_TTR("{0} is empty")).format(varray(Image::get_class_static())));
+				return;
+			}
 			ImageRangeGrid *im_range = ZN_NEW(ImageRangeGrid);
 			im_range->generate(**image);
 			const float factor = ctx.get_param(2);
@@ -212,7 +202,7 @@ void register_image_nodes(Span<NodeType> types) {
 			Params p;
 			p.min_height = range.min;
 			p.max_height = range.max;
-			p.image = *image;
+			p.heightmap = heightmap;
 			p.image_range_grid = im_range;
 			p.radius = ctx.get_param(1);
 			p.factor = factor;
@@ -220,6 +210,7 @@ void register_image_nodes(Span<NodeType> types) {
 			p.norm_y = image->get_height();
 			ctx.set_params(p);
 			ctx.add_delete_cleanup(im_range);
+			ctx.add_delete_cleanup(heightmap);
 		};
 
 		t.process_buffer_func = [](Runtime::ProcessBufferContext &ctx) {
@@ -230,9 +221,9 @@ void register_image_nodes(Span<NodeType> types) {
 			Runtime::Buffer &out = ctx.get_output(0);
 			// TODO Allow to use bilinear filtering?
 			const Params p = ctx.get_params<Params>();
-			const Image &im = *p.image;
+			const FloatHeightmap &heightmap = *p.heightmap;
 			for (uint32_t i = 0; i < out.size; ++i) {
-				out.data[i] = sdf_sphere_heightmap(x.data[i], y.data[i], z.data[i], p.radius, p.factor, im,
+				out.data[i] = sdf_sphere_heightmap(x.data[i], y.data[i], z.data[i], p.radius, p.factor, heightmap,
 						p.min_height, p.max_height, p.norm_x, p.norm_y);
 			}
 		};
@@ -0,0 +1,333 @@
+#include "../../../util/containers/fixed_array.h"
+#include "../../../util/containers/std_vector.h"
+#include "../../../util/math/funcs.h"
+#include "../../../util/profiling.h"
+#include "../node_type_db.h"
+
+#include <memory>
+
+namespace zylann::voxel::pg {
+
+struct LowFrequencyFunctionData {
+	std::shared_ptr<VoxelGraphFunction::CompiledGraph> compiled_graph;
+	// Which coordinate (0=x, 1=y, 2=z) each input of the function takes
+	FixedArray<uint8_t, Runtime::MAX_INPUTS> input_axes;
+	unsigned int input_count;
+	// Coordinates the function doesn't depend on don't need to be sampled on the lattice
+	FixedArray<bool, 3> used_axes;
+	float stride;
+};
+
+// Per-thread memory used to evaluate functions of LowFrequencyFunction nodes
+struct LowFrequencyFunctionCache {
+	Runtime::State state;
+	StdVector<Span<float>> input_chunks;
+	FixedArray<StdVector<float>, 3> lattice_positions;
+	StdVector<float> lattice_values;
+
+	// Describes the lattice currently in `lattice_values`. Blocks are generated slice by slice, so consecutive calls
+	// often sample the same lattice. Keeping a reference to the compiled graph also ensures its address can't be
+	// reused by another graph while it is cached.
+	std::shared_ptr<VoxelGraphFunction::CompiledGraph> lattice_graph;
+	FixedArray<int, 3> lattice_origin;
+	FixedArray<int, 3> lattice_size;
+	float lattice_stride = 0.f;
+
+	// True while a node is using this cache on the current thread. Functions may contain LowFrequencyFunction nodes
+	// themselves, in which case they use a temporary cache.
+	bool in_use = false;
+};
+
+inline LowFrequencyFunctionCache &get_low_frequency_function_cache_tls() {
+	static thread_local LowFrequencyFunctionCache tls_cache;
+	return tls_cache;
+}
+
+// Evaluates the first output of a function at the given positions, in chunks so we don't allocate too much memory.
+inline void evaluate_low_frequency_function(const LowFrequencyFunctionData &data, LowFrequencyFunctionCache &cache,
+		FixedArray<Span<float>, 3> positions, Span<float> out_values) {
+	ZN_PROFILE_SCOPE();
+
+	const Runtime &runtime = data.compiled_graph->runtime;
+
+	const unsigned int total_size = out_values.size();
+	const unsigned int max_chunk_size = 256;
+	const unsigned int chunk_size = math::min(total_size, max_chunk_size);
+
+	cache.input_chunks.resize(data.input_count);
+	runtime.prepare_state(cache.state, chunk_size, false);
+
+	for (unsigned int chunk_begin = 0; chunk_begin < total_size; chunk_begin += chunk_size) {
+		const unsigned int size = math::min(chunk_size, total_size - chunk_begin);
+		if (size != chunk_size) {
+			runtime.prepare_state(cache.state, size, false);
+		}
+
+		for (unsigned int input_index = 0; input_index < data.input_count; ++input_index) {
+			cache.input_chunks[input_index] = positions[data.input_axes[input_index]].sub(chunk_begin, size);
+		}
+
+		runtime.generate_set(cache.state, to_span(cache.input_chunks), false, nullptr);
+
+		Span<float> dst = out_values.sub(chunk_begin, size);
+		const Runtime::Buffer &b = cache.state.get_buffer(runtime.get_output_info(0).buffer_address);
+		if (b.data == nullptr) {
+			for (float &v : dst) {
+				v = b.constant_value;
+			}
+		} else {
+			Span<float>(b.data, size).copy_to(dst);
+		}
+	}
+}
+
+inline void process_low_frequency_function(const LowFrequencyFunctionData &data, LowFrequencyFunctionCache &cache,
+		FixedArray<Span<float>, 3> positions, Span<float> out_values) {
+	const unsigned int count = out_values.size();
+	const float stride = data.stride;
+
+	// Find which lattice encloses the positions. It is aligned to multiples of the stride, so neighbor areas
+	// interpolate the same samples and don't produce seams.
+	FixedArray<int, 3> lattice_origin;
+	FixedArray<int, 3> lattice_size;
+	int64_t lattice_volume = 1;
+	for (unsigned int axis = 0; axis < 3; ++axis) {
+		if (!data.used_axes[axis]) {
+			lattice_origin[axis] = 0;
+			lattice_size[axis] = 1;
+			continue;
+		}
+		float min_pos = positions[axis][0];
+		float max_pos = min_pos;
+		for (const float v : positions[axis]) {
+			min_pos = math::min(v, min_pos);
+			max_pos = math::max(v, max_pos);
+		}
+		const int64_t imin = static_cast<int64_t>(Math::floor(min_pos / stride));
+		const int64_t imax = static_cast<int64_t>(Math::floor(max_pos / stride)) + 1;
+		lattice_volume *= imax - imin + 1;
+		if (lattice_volume >= static_cast<int64_t>(count)) {
+			// Positions are too sparse (or too few) for the lattice to be worth it
+			evaluate_low_frequency_function(data, cache, positions, out_values);
+			return;
+		}
+		lattice_origin[axis] = imin;
+		lattice_size[axis] = imax - imin + 1;
+	}
+
+	if (cache.lattice_graph != data.compiled_graph || cache.lattice_stride != stride ||
+			cache.lattice_origin != lattice_origin || cache.lattice_size != lattice_size) {
+		ZN_PROFILE_SCOPE_NAMED("Lattice");
+
+		FixedArray<Span<float>, 3> lattice_positions;
+		for (unsigned int axis = 0; axis < 3; ++axis) {
+			StdVector<float> &dst = cache.lattice_positions[axis];
+			dst.resize(lattice_volume);
+			lattice_positions[axis] = to_span(dst);
+		}
+		unsigned int i = 0;
+		for (int z = 0; z < lattice_size[2]; ++z) {
+			for (int y = 0; y < lattice_size[1]; ++y) {
+				for (int x = 0; x < lattice_size[0]; ++x) {
+					lattice_positions[0][i] = (lattice_origin[0] + x) * stride;
+					lattice_positions[1][i] = (lattice_origin[1] + y) * stride;
+					lattice_positions[2][i] = (lattice_origin[2] + z) * stride;
+					++i;
+				}
+			}
+		}
+
+		cache.lattice_values.resize(lattice_volume);
+		evaluate_low_frequency_function(data, cache, lattice_positions, to_span(cache.lattice_values));
+
+		cache.lattice_graph = data.compiled_graph;
+		cache.lattice_stride = stride;
+		cache.lattice_origin = lattice_origin;
+		cache.lattice_size = lattice_size;
+	}
+
+	// Upsample. Axes with only one sample don't need interpolation, so this is either trilinear or bilinear.
+	FixedArray<unsigned int, 3> jumps;
+	jumps[0] = 1;
+	jumps[1] = lattice_size[0];
+	jumps[2] = lattice_size[0] * lattice_size[1];
+	// Offsets to the next sample along each axis
+	FixedArray<unsigned int, 3> steps;
+	for (unsigned int axis = 0; axis < 3; ++axis) {
+		steps[axis] = lattice_size[axis] > 1 ? jumps[axis] : 0;
+	}
+	const float *lattice_values = cache.lattice_values.data();
+	const float inv_stride = 1.f / stride;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned int loc = 0;
+		FixedArray<float, 3> t;
+		for (unsigned int axis = 0; axis < 3; ++axis) {
+			if (steps[axis] == 0) {
+				t[axis] = 0.f;
+				continue;
+			}
+			const float f = positions[axis][i] * inv_stride - lattice_origin[axis];
+			const int c = math::clamp(static_cast<int>(Math::floor(f)), 0, lattice_size[axis] - 2);
+			t[axis] = f - c;
+			loc += c * jumps[axis];
+		}
+
+		const float *v = lattice_values + loc;
+		const float v00 = Math::lerp(v[0], v[steps[0]], t[0]);
+		const float v10 = Math::lerp(v[steps[1]], v[steps[0] + steps[1]], t[0]);
+		const float v01 = Math::lerp(v[steps[2]], v[steps[0] + steps[2]], t[0]);
+		const float v11 = Math::lerp(v[steps[1] + steps[2]], v[steps[0] + steps[1] + steps[2]], t[0]);
+		out_values[i] = Math::lerp(Math::lerp(v00, v10, t[1]), Math::lerp(v01, v11, t[1]), t[2]);
+	}
+}
+
+void register_low_frequency_node(Span<NodeType> types) {
+	{
+		struct Params {
+			const LowFrequencyFunctionData *data;
+		};
+		NodeType &t = types[VoxelGraphFunction::NODE_LOW_FREQUENCY_FUNCTION];
+		t.name = "LowFrequencyFunction";
+		t.category = CATEGORY_FUNCTIONS;
+		t.inputs.push_back(NodeType::Port("x", 0.f, VoxelGraphFunction::AUTO_CONNECT_X));
+		t.inputs.push_back(NodeType::Port("y", 0.f, VoxelGraphFunction::AUTO_CONNECT_Y));
+		t.inputs.push_back(NodeType::Port("z", 0.f, VoxelGraphFunction::AUTO_CONNECT_Z));
+		t.outputs.push_back(NodeType::Port("out"));
+		t.params.push_back(NodeType::Param("function", VoxelGraphFunction::get_class_static(), nullptr));
+		{
+			NodeType::Param p("stride", Variant::FLOAT, 4.0);
+			p.min_value = 0.01;
+			p.max_value = 1000000.0;
+			p.has_range = true;
+			t.params.push_back(p);
+		}
+
+		t.compile_func = [](CompileContext &ctx) {
+			Ref<VoxelGraphFunction> function = ctx.get_param(0);
+			if (function.is_null()) {
+				ctx.make_error(String(ZN_TTR("{0} instance is null"))
+									   .format(varray(VoxelGraphFunction::get_class_static())));
+				return;
+			}
+			const float stride = ctx.get_param(1);
+			if (stride <= 0.f) {
+				ctx.make_error(ZN_TTR("Stride must be greater than 0"));
+				return;
+			}
+
+			// Compiling a function that leads back to itself would never end
+			if (function->contains_reference_to_function(**function)) {
+				ctx.make_error(ZN_TTR("Function references itself"));
+				return;
+			}
+
+			// The function is compiled on its own, so it can be evaluated at different positions than the graph
+			const CompilationResult result = function->compile(false);
+			if (!result.success) {
+				ctx.make_error(String(ZN_TTR("Function failed to compile: {0}")).format(varray(result.message)));
+				return;
+			}
+			std::shared_ptr<VoxelGraphFunction::CompiledGraph> compiled_graph = function->get_compiled_graph();
+			ZN_ASSERT_RETURN(compiled_graph != nullptr);
+
+			if (compiled_graph->runtime.get_output_count() == 0) {
+				ctx.make_error(ZN_TTR("Function has no outputs"));
+				return;
+			}
+
+			Span<const VoxelGraphFunction::Port> inputs = function->get_input_definitions();
+			if (inputs.size() != compiled_graph->runtime.get_input_count()) {
+				ctx.make_error(ZN_TTR("Function inputs changed while compiling"));
+				return;
+			}
+
+			LowFrequencyFunctionData *data = ZN_NEW(LowFrequencyFunctionData);
+			data->compiled_graph = compiled_graph;
+			data->input_count = inputs.size();
+			fill(data->used_axes, false);
+			data->stride = stride;
+
+			for (unsigned int input_index = 0; input_index < inputs.size(); ++input_index) {
+				const VoxelGraphFunction::Port &port = inputs[input_index];
+				int axis = -1;
+				if (port.type == VoxelGraphFunction::NODE_INPUT_X || (port.is_custom() && port.name == "x")) {
+					axis = 0;
+				} else if (port.type == VoxelGraphFunction::NODE_INPUT_Y || (port.is_custom() && port.name == "y")) {
+					axis = 1;
+				} else if (port.type == VoxelGraphFunction::NODE_INPUT_Z || (port.is_custom() && port.name == "z")) {
+					axis = 2;
+				}
+				if (axis == -1) {
+					ZN_DELETE(data);
+					ctx.make_error(String(ZN_TTR("Function input \"{0}\" is not supported, only X, Y and Z are"))
+										   .format(varray(port.name)));
+					return;
+				}
+				data->input_axes[input_index] = axis;
+				data->used_axes[axis] = true;
+			}
+
+			Params p;
+			p.data = data;
+			ctx.set_params(p);
+			ctx.add_delete_cleanup(data);
+		};
+
+		t.process_buffer_func = [](Runtime::ProcessBufferContext &ctx) {
+			ZN_PROFILE_SCOPE_NAMED("NODE_LOW_FREQUENCY_FUNCTION");
+			const Runtime::Buffer &x = ctx.get_input(0);
+			const Runtime::Buffer &y = ctx.get_input(1);
+			const Runtime::Buffer &z = ctx.get_input(2);
+			Runtime::Buffer &out = ctx.get_output(0);
+			const LowFrequencyFunctionData &data = *ctx.get_params<Params>().data;
+
+			if (out.size == 0) {
+				return;
+			}
+
+			FixedArray<Span<float>, 3> positions;
+			positions[0] = Span<float>(x.data, out.size);
+			positions[1] = Span<float>(y.data, out.size);
+			positions[2] = Span<float>(z.data, out.size);
+
+			LowFrequencyFunctionCache &tls_cache = get_low_frequency_function_cache_tls();
+			if (tls_cache.in_use) {
+				LowFrequencyFunctionCache nested_cache;
+				process_low_frequency_function(data, nested_cache, positions, Span<float>(out.data, out.size));
+			} else {
+				tls_cache.in_use = true;
+				process_low_frequency_function(data, tls_cache, positions, Span<float>(out.data, out.size));
+				tls_cache.in_use = false;
+			}
+		};
+
+		t.range_analysis_func = [](Runtime::RangeAnalysisContext &ctx) {
+			const LowFrequencyFunctionData &data = *ctx.get_params<Params>().data;
+			// Interpolated values are weighted averages of samples taken at most one stride away from the
+			// positions, so the range of the function over padded inputs contains them
+			FixedArray<math::Interval, Runtime::MAX_INPUTS> inputs;
+			for (unsigned int input_index = 0; input_index < data.input_count; ++input_index) {
+				inputs[input_index] = ctx.get_input(data.input_axes[input_index]).padded(data.stride);
+			}
+
+			const Runtime &runtime = data.compiled_graph->runtime;
+			LowFrequencyFunctionCache &tls_cache = get_low_frequency_function_cache_tls();
+
+			if (tls_cache.in_use) {
+				Runtime::State state;
+				runtime.prepare_state(state, 1, false);
+				runtime.analyze_range(state, Span<math::Interval>(inputs.data(), data.input_count));
+				ctx.set_output(0, state.get_range(runtime.get_output_info(0).buffer_address));
+			} else {
+				tls_cache.in_use = true;
+				runtime.prepare_state(tls_cache.state, 1, false);
+				runtime.analyze_range(tls_cache.state, Span<math::Interval>(inputs.data(), data.input_count));
+				ctx.set_output(0, tls_cache.state.get_range(runtime.get_output_info(0).buffer_address));
+				tls_cache.in_use = false;
+			}
+		};
+	}
+}
+
+} // namespace zylann::voxel::pg
@@ -652,10 +652,9 @@ void register_noise_nodes(Span<NodeType> types) {
 			const Runtime::Buffer &spot_size = ctx.get_input(2);
 			Runtime::Buffer &out = ctx.get_output(0);
 			const Params params = ctx.get_params<Params>();
-			for (unsigned int i = 0; i < out.size; ++i) {
-				out.data[i] = SpotNoise::spot_noise_2d(Vector2f(x.data[i], y.data[i]), params.cell_size,
-						spot_size.data[i], params.jitter, params.seed);
-			}
+			SpotNoise::spot_noise_2d(Span<const float>(x.data, out.size), Span<const float>(y.data, out.size),
+					Span<const float>(spot_size.data, out.size), params.cell_size, params.jitter, params.seed,
+					Span<float>(out.data, out.size));
 		};
 
 		t.range_analysis_func = [](Runtime::RangeAnalysisContext &ctx) {
@@ -738,10 +737,9 @@ void register_noise_nodes(Span<NodeType> types) {
 			const Runtime::Buffer &spot_size = ctx.get_input(3);
 			Runtime::Buffer &out = ctx.get_output(0);
 			const Params params = ctx.get_params<Params>();
-			for (unsigned int i = 0; i < out.size; ++i) {
-				out.data[i] = SpotNoise::spot_noise_3d(Vector3f(x.data[i], y.data[i], z.data[i]), params.cell_size,
-						spot_size.data[i], params.jitter, params.seed);
-			}
+			SpotNoise::spot_noise_3d(Span<const float>(x.data, out.size), Span<const float>(y.data, out.size),
+					Span<const float>(z.data, out.size), Span<const float>(spot_size.data, out.size),
+					params.cell_size, params.jitter, params.seed, Span<float>(out.data, out.size));
 		};
 
 		t.range_analysis_func = [](Runtime::RangeAnalysisContext &ctx) {
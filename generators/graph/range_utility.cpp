@@ -1,4 +1,5 @@
 #include "range_utility.h"
+#include "curve_lut.h"
 #include "../../util/godot/classes/curve.h"
 #include "../../util/godot/classes/image.h"
 #include "../../util/math/rect2i.h"
@@ -11,14 +12,14 @@ using namespace math;
 
 // Curve ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void get_curve_monotonic_sections(Curve &curve, StdVector<CurveMonotonicSection> &sections) {
-	const int res = curve.get_bake_resolution();
-	float prev_y = curve.sample_baked(0.f);
+void get_curve_monotonic_sections(const CurveLUT &curve, StdVector<CurveMonotonicSection> &sections) {
+	const int res = curve.get_resolution();
+	float prev_y = curve.get_value(0);
 
 	sections.clear();
 	CurveMonotonicSection section;
 	section.x_min = 0.f;
-	section.y_min = curve.sample_baked(0.f);
+	section.y_min = curve.get_value(0);
 
 	float prev_x = 0.f;
 	bool current_stationary = true;
@@ -27,9 +28,8 @@ void get_curve_monotonic_sections(Curve &curve, StdVector<CurveMonotonicSection>
 	// Iterating up to `res` included, to include the final value (Godot's PR #76617 fixed an issue in Curve, which also
 	// made it apparent that our code didn't properly include the end of the curve)
 	for (int i = 1; i < res; ++i) {
-		// We do -1 because [res-1] is the last value in the baked array, therefore `x` must be 1
-		const float x = static_cast<float>(i) / (res - 1);
-		const float y = curve.sample_baked(x);
+		const float x = curve.get_x(i);
+		const float y = curve.get_value(i);
 		// Curve can sometimes appear flat but it still oscillates by very small amounts due to float imprecision
 		// which occurred during bake(). Attempting to workaround that by taking the error into account
 		const bool increasing = y > prev_y + CURVE_RANGE_MARGIN;
@@ -63,28 +63,28 @@ void get_curve_monotonic_sections(Curve &curve, StdVector<CurveMonotonicSection>
 	sections.push_back(section);
 }
 
-Interval get_curve_range(Curve &curve, const StdVector<CurveMonotonicSection> &sections, Interval x) {
+Interval get_curve_range(const CurveLUT &curve, const StdVector<CurveMonotonicSection> &sections, Interval x) {
 	// This implementation is linear. It assumes curves usually don't have many points.
 	// If a curve has too many points, we may consider dynamically choosing a different algorithm.
 	Interval y;
 	unsigned int i = 0;
 	if (x.min < sections[0].x_min) {
 		// X range starts before the curve's minimum X
-		y = Interval::from_single_value(curve.sample_baked(0.f));
+		y = Interval::from_single_value(curve.sample(0.f));
 	} else {
 		// Find section from where the range starts
 		for (; i < sections.size(); ++i) {
 			const CurveMonotonicSection &section = sections[i];
 			if (x.min >= section.x_min) {
-				const float begin_y = curve.sample_baked(x.min);
+				const float begin_y = curve.sample(x.min);
 				if (x.max < section.x_max) {
 					// X range starts and ends in that section
-					return Interval::from_unordered_values(begin_y, curve.sample_baked(x.max))
+					return Interval::from_unordered_values(begin_y, curve.sample(x.max))
 							.padded(CURVE_RANGE_MARGIN);
 				} else {
 					// X range starts in that section, and continues after it.
 					// Will need to keep iterating, starting from here
-					y = Interval::from_unordered_values(begin_y, curve.sample_baked(section.x_max));
+					y = Interval::from_unordered_values(begin_y, curve.sample(section.x_max));
 					++i;
 					break;
 				}
@@ -98,7 +98,7 @@ Interval get_curve_range(Curve &curve, const StdVector<CurveMonotonicSection> &s
 			y.add_interval(Interval::from_unordered_values(section.y_min, section.y_max));
 		} else {
 			// X range ends in that section
-			y.add_interval(Interval::from_unordered_values(section.y_min, curve.sample_baked(x.max)));
+			y.add_interval(Interval::from_unordered_values(section.y_min, curve.sample(x.max)));
 			break;
 		}
 	}
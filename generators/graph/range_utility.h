@@ -11,6 +11,8 @@ ZN_GODOT_FORWARD_DECLARE(class Image)
 
 namespace zylann {
 
+class CurveLUT;
+
 // Curve ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 struct CurveMonotonicSection {
@@ -34,9 +36,10 @@ static const float CURVE_RANGE_MARGIN = CMP_EPSILON;
 // - Be stationary or increase
 // Which means, within one section, given a range of input values defined by a min and max,
 // we can quickly calculate an accurate range of output values by sampling the curve only at the two points.
-void get_curve_monotonic_sections(Curve &curve, StdVector<CurveMonotonicSection> &sections);
+void get_curve_monotonic_sections(const CurveLUT &curve, StdVector<CurveMonotonicSection> &sections);
 // Gets the range of Y values for a range of X values on a curve, using precalculated monotonic segments
-math::Interval get_curve_range(Curve &curve, const StdVector<CurveMonotonicSection> &sections, math::Interval x);
+math::Interval get_curve_range(
+		const CurveLUT &curve, const StdVector<CurveMonotonicSection> &sections, math::Interval x);
 
 // Legacy
 math::Interval get_curve_range(Curve &curve, bool &is_monotonic_increasing);
@@ -490,6 +490,11 @@ VoxelGenerator::Result VoxelGeneratorGraph::generate_block(VoxelGenerator::Voxel
 			for (int sx = 0; sx < bs.x; sx += section_size.x) {
 				ZN_PROFILE_SCOPE_NAMED("Section");
 
+				if (input.cancellation_token.is_valid_and_cancelled()) {
+					// The result is no longer needed
+					return result;
+				}
+
 				const Vector3i rmin(sx, sy, sz);
 				const Vector3i rmax = rmin + Vector3i(section_size);
 				const Vector3i gmin = origin + (rmin << input.lod);
@@ -603,6 +608,11 @@ VoxelGenerator::Result VoxelGeneratorGraph::generate_block(VoxelGenerator::Voxel
 				for (int ry = rmin.y, gy = gmin.y; ry < rmax.y; ++ry, gy += stride) {
 					ZN_PROFILE_SCOPE_NAMED("Full slice");
 
+					// Sections can be large when subdivision is off, so check again between slices
+					if (input.cancellation_token.is_valid_and_cancelled()) {
+						return result;
+					}
+
 					y_cache.fill(gy);
 
 					if (input_sdf_full_cache.size() != 0) {
@@ -1010,6 +1020,8 @@ pg::CompilationResult VoxelGeneratorGraph::compile(bool debug) {
 	// Store valid result
 	RWLockWrite wlock(_runtime_lock);
 	_runtime = r;
+	// Blocks shared between terrains were generated with the previous graph
+	_block_cache.clear();
 
 	const int64_t time_spent = Time::get_singleton()->get_ticks_usec() - time_before;
 	ZN_PRINT_VERBOSE(format("Voxel graph compiled in {} us", time_spent));
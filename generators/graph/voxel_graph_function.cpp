@@ -476,6 +476,18 @@ void VoxelGraphFunction::set_node_param(uint32_t node_id, int param_index, Varia
 			register_subresource(**func);
 
 		} else {
+			if (node->type_id == VoxelGraphFunction::NODE_LOW_FREQUENCY_FUNCTION && param_index == 0 &&
+					value.get_type() != Variant::NIL) {
+				// Not required to be set, but it must not lead back to this function
+				Ref<VoxelGraphFunction> func = value;
+				ERR_FAIL_COND_MSG(func.is_null(),
+						String("A LowFrequencyFunction node can only reference a {0}")
+								.format(varray(VoxelGraphFunction::get_class_static())));
+				ERR_FAIL_COND_MSG(func.ptr() == this, "Cannot add function to itself");
+				ERR_FAIL_COND_MSG(func->contains_reference_to_function(*this),
+						"Cannot add function indirectly referencing itself");
+			}
+
 			Ref<Resource> prev_resource = node->params[param_index];
 			if (prev_resource.is_valid()) {
 				unregister_subresource(**prev_resource);
@@ -1243,7 +1255,9 @@ bool VoxelGraphFunction::contains_reference_to_function(const VoxelGraphFunction
 					.format(varray(VoxelGraphFunction::get_class_static())));
 
 	const uint32_t id = _graph.find_node([&p_func, max_recursion](const ProgramGraph::Node &node) {
-		if (node.type_id == VoxelGraphFunction::NODE_FUNCTION) {
+		// Low frequency functions are compiled separately, but compiling them would still recurse
+		if (node.type_id == VoxelGraphFunction::NODE_FUNCTION ||
+				node.type_id == VoxelGraphFunction::NODE_LOW_FREQUENCY_FUNCTION) {
 			ZN_ASSERT(node.params.size() >= 1);
 			Ref<VoxelGraphFunction> func = node.params[0];
 			if (func.ptr() == &p_func) {
@@ -1773,6 +1787,7 @@ void VoxelGraphFunction::_bind_methods() {
 	BIND_ENUM_CONSTANT(NODE_RELAY);
 	BIND_ENUM_CONSTANT(NODE_SPOTS_2D);
 	BIND_ENUM_CONSTANT(NODE_SPOTS_3D);
+	BIND_ENUM_CONSTANT(NODE_LOW_FREQUENCY_FUNCTION);
 	BIND_ENUM_CONSTANT(NODE_TYPE_COUNT);
 #ifdef VOXEL_ENABLE_FAST_NOISE_2
 	BIND_ENUM_CONSTANT(NODE_FAST_NOISE_2_2D);
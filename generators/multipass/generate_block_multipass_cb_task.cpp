@@ -166,6 +166,10 @@ void GenerateBlockMultipassCBTask::run(zylann::ThreadedTaskContext &ctx) {
 	}
 
 	run_cpu_generation();
+	if (_cancellation_token.is_valid_and_cancelled()) {
+		// Cancelled while generating, the block will be reported as dropped
+		return;
+	}
 	run_stream_saving_and_finish();
 }
 
@@ -174,7 +178,7 @@ void GenerateBlockMultipassCBTask::run_cpu_generation() {
 
 	Ref<VoxelGenerator> generator = _stream_dependency->generator;
 
-	VoxelGenerator::VoxelQueryData query_data{ *voxels, origin_in_voxels, _lod_index };
+	VoxelGenerator::VoxelQueryData query_data{ *voxels, origin_in_voxels, _lod_index, _cancellation_token };
 	generator->generate_block(query_data);
 }
 
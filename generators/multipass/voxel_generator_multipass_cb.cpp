@@ -58,7 +58,7 @@ void VoxelGeneratorMultipassCB::generate_block_fallback_script(VoxelQueryData &i
 
 	// Create a temporary wrapper so Godot can pass it to scripts
 	Ref<godot::VoxelBuffer> buffer_wrapper(
-			memnew(godot::VoxelBuffer(static_cast<godot::VoxelBuffer::Allocator>(input.voxel_buffer.get_allocator()))));
+			memnew(godot::VoxelBuffer(godot::VoxelBuffer::get_script_allocator(input.voxel_buffer.get_allocator()))));
 	buffer_wrapper.instantiate();
 	buffer_wrapper->get_buffer().copy_format(input.voxel_buffer);
 	buffer_wrapper->get_buffer().create(input.voxel_buffer.get_size());
@@ -34,6 +34,7 @@ int VoxelGeneratorFlat::get_used_channels_mask() const {
 void VoxelGeneratorFlat::set_voxel_type(int t) {
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.voxel_type = t;
+	invalidate_block_cache();
 }
 
 int VoxelGeneratorFlat::get_voxel_type() const {
@@ -44,6 +45,7 @@ int VoxelGeneratorFlat::get_voxel_type() const {
 void VoxelGeneratorFlat::set_height(float h) {
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.height = h;
+	invalidate_block_cache();
 }
 
 float VoxelGeneratorFlat::get_height() const {
@@ -2,21 +2,18 @@
 #include "../../util/containers/fixed_array.h"
 #include "../../util/containers/span.h"
 #include "../../util/godot/classes/image.h"
+#include "../../util/memory/memory.h"
 
 namespace zylann::voxel {
 
 namespace {
 
-inline float get_height_repeat(const Image &im, int x, int y) {
-	return im.get_pixel(math::wrap(x, im.get_width()), math::wrap(y, im.get_height())).r;
-}
-
-inline float get_height_blurred(const Image &im, int x, int y) {
-	float h = get_height_repeat(im, x, y);
-	h += get_height_repeat(im, x + 1, y);
-	h += get_height_repeat(im, x - 1, y);
-	h += get_height_repeat(im, x, y + 1);
-	h += get_height_repeat(im, x, y - 1);
+inline float get_height_blurred(const FloatHeightmap &heightmap, int x, int y) {
+	float h = heightmap.get_pixel_repeat(x, y);
+	h += heightmap.get_pixel_repeat(x + 1, y);
+	h += heightmap.get_pixel_repeat(x - 1, y);
+	h += heightmap.get_pixel_repeat(x, y + 1);
+	h += heightmap.get_pixel_repeat(x, y - 1);
 	return h * 0.2f;
 }
 
@@ -34,12 +31,15 @@ void VoxelGeneratorImage::set_image(Ref<Image> im) {
 		ERR_FAIL_COND(im->is_compressed());
 	}
 	_image = im;
-	Ref<Image> copy;
+	std::shared_ptr<FloatHeightmap> heightmap;
 	if (im.is_valid()) {
-		copy = im->duplicate();
+		heightmap = make_shared_instance<FloatHeightmap>();
+		// Mips are sampled at LOD > 0
+		heightmap->create_from_image(**im, true);
 	}
 	RWLockWrite wlock(_parameters_lock);
-	_parameters.image = copy;
+	_parameters.heightmap = heightmap;
+	invalidate_block_cache();
 }
 
 Ref<Image> VoxelGeneratorImage::get_image() const {
@@ -49,6 +49,7 @@ Ref<Image> VoxelGeneratorImage::get_image() const {
 void VoxelGeneratorImage::set_blur_enabled(bool enable) {
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.blur_enabled = enable;
+	invalidate_block_cache();
 }
 
 bool VoxelGeneratorImage::is_blur_enabled() const {
@@ -67,17 +68,24 @@ VoxelGenerator::Result VoxelGeneratorImage::generate_block(VoxelGenerator::Voxel
 
 	Result result;
 
-	ERR_FAIL_COND_V(params.image.is_null(), result);
-	const Image &image = **params.image;
+	ERR_FAIL_COND_V(params.heightmap == nullptr || params.heightmap->is_empty(), result);
+	const FloatHeightmap &heightmap = *params.heightmap;
+	const unsigned int lod = input.lod;
 
 	if (params.blur_enabled) {
 		result = VoxelGeneratorHeightmap::generate(
-				out_buffer, [&image](int x, int z) { return get_height_blurred(image, x, z); }, input.origin_in_voxels,
-				input.lod);
+				out_buffer, [&heightmap](int x, int z) { return get_height_blurred(heightmap, x, z); },
+				input.origin_in_voxels, lod);
+	} else if (lod == 0) {
+		result = VoxelGeneratorHeightmap::generate(
+				out_buffer, [&heightmap](int x, int z) { return heightmap.get_pixel_repeat(x, z); },
+				input.origin_in_voxels, lod);
 	} else {
+		// Voxels are further apart than pixels, sample downscaled versions of the image so we don't miss any
 		result = VoxelGeneratorHeightmap::generate(
-				out_buffer, [&image](int x, int z) { return get_height_repeat(image, x, z); }, input.origin_in_voxels,
-				input.lod);
+				out_buffer,
+				[&heightmap, lod](int x, int z) { return heightmap.sample_bilinear_repeat(x, z, lod); },
+				input.origin_in_voxels, lod);
 	}
 
 	out_buffer.compress_uniform_channels();
@@ -3,8 +3,11 @@
 
 #include "../../util/godot/macros.h"
 #include "../../util/thread/rw_lock.h"
+#include "../float_heightmap.h"
 #include "voxel_generator_heightmap.h"
 
+#include <memory>
+
 ZN_GODOT_FORWARD_DECLARE(class Image)
 
 namespace zylann::voxel {
@@ -33,10 +36,10 @@ private:
 	Ref<Image> _image;
 
 	struct Parameters {
-		// This is a read-only copy of the image.
+		// Read-only copy of the image, decoded so it is fast to sample.
 		// It wastes memory for sure, but Godot does not offer any way to secure this better.
 		// If this is a problem one day, we could add an option to dereference the external image in game.
-		Ref<Image> image;
+		std::shared_ptr<const FloatHeightmap> heightmap;
 		// Mostly here as demo/tweak. It's better recommended to use an EXR/float image.
 		bool blur_enabled = false;
 	};
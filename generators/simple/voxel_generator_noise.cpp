@@ -28,12 +28,14 @@ void VoxelGeneratorNoise::set_noise(Ref<FastNoiseLite> noise) {
 	// The OpenSimplexNoise resource is not thread-safe so we make a copy of it for use in threads
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.noise = copy;
+	invalidate_block_cache();
 }
 
 void VoxelGeneratorNoise::_on_noise_changed() {
 	ERR_FAIL_COND(_noise.is_null());
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.noise = _noise->duplicate();
+	invalidate_block_cache();
 }
 
 void VoxelGeneratorNoise::set_channel(VoxelBuffer::ChannelId p_channel) {
@@ -68,6 +70,7 @@ Ref<FastNoiseLite> VoxelGeneratorNoise::get_noise() const {
 void VoxelGeneratorNoise::set_height_start(real_t y) {
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.height_start = y;
+	invalidate_block_cache();
 }
 
 real_t VoxelGeneratorNoise::get_height_start() const {
@@ -81,6 +84,7 @@ void VoxelGeneratorNoise::set_height_range(real_t hrange) {
 	}
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.height_range = hrange;
+	invalidate_block_cache();
 }
 
 real_t VoxelGeneratorNoise::get_height_range() const {
@@ -42,6 +42,7 @@ void VoxelGeneratorWaves::set_pattern_size(Vector2 size) {
 	size.x = math::maxf(size.x, 0);
 	size.y = math::maxf(size.y, 0);
 	_parameters.pattern_size = size;
+	invalidate_block_cache();
 }
 
 Vector2 VoxelGeneratorWaves::get_pattern_offset() const {
@@ -52,6 +53,7 @@ Vector2 VoxelGeneratorWaves::get_pattern_offset() const {
 void VoxelGeneratorWaves::set_pattern_offset(Vector2 offset) {
 	RWLockWrite wlock(_parameters_lock);
 	_parameters.pattern_offset = offset;
+	invalidate_block_cache();
 }
 
 void VoxelGeneratorWaves::_bind_methods() {
@@ -10,7 +10,10 @@
 
 namespace zylann::voxel {
 
-VoxelGenerator::VoxelGenerator() {}
+VoxelGenerator::VoxelGenerator() {
+	// Subclasses (including scripts) emit this when their parameters change
+	connect(VoxelStringNames::get_singleton().changed, callable_mp(this, &VoxelGenerator::invalidate_block_cache));
+}
 
 VoxelGenerator::Result VoxelGenerator::generate_block(VoxelQueryData &input) {
 	return Result();
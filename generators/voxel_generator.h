@@ -11,6 +11,7 @@
 #include "../util/math/vector3f.h"
 #include "../util/tasks/cancellation_token.h"
 #include "../util/thread/mutex.h"
+#include "voxel_generator_block_cache.h"
 
 #include <memory>
 
@@ -57,6 +58,9 @@ public:
 		VoxelBuffer &voxel_buffer;
 		Vector3i origin_in_voxels;
 		uint32_t lod;
+		// Optional. Generators taking a while can check it to stop early if the result is no longer needed, in which
+		// case the buffer may be left partially generated and must be discarded.
+		TaskCancellationToken cancellation_token;
 	};
 
 	virtual Result generate_block(VoxelQueryData &input);
@@ -169,6 +173,11 @@ public:
 
 	virtual void clear_cache();
 
+	// Results shared between volumes using this generator. Volumes have to register themselves to take part.
+	VoxelGeneratorBlockCache &get_block_cache() {
+		return _block_cache;
+	}
+
 	// Editor
 
 #ifdef TOOLS_ENABLED
@@ -178,6 +187,12 @@ public:
 protected:
 	static void _bind_methods();
 
+	// Must be called when a parameter affecting generated voxels changes, so volumes don't get blocks that were
+	// generated with previous parameters. Emitting `changed` also does it.
+	void invalidate_block_cache() {
+		_block_cache.clear();
+	}
+
 	void _b_generate_block(Ref<godot::VoxelBuffer> out_buffer, Vector3 origin_in_voxels, int lod);
 
 	std::shared_ptr<ComputeShader> _detail_rendering_shader;
@@ -186,6 +201,8 @@ protected:
 	std::shared_ptr<ComputeShaderParameters> _block_rendering_shader_parameters;
 	std::shared_ptr<ShaderOutputs> _block_rendering_shader_outputs;
 	Mutex _shader_mutex;
+
+	VoxelGeneratorBlockCache _block_cache;
 };
 
 } // namespace voxel
@@ -0,0 +1,207 @@
+#include "voxel_generator_block_cache.h"
+#include "../storage/voxel_buffer.h"
+#include "../util/containers/std_vector.h"
+#include "../util/errors.h"
+#include "../util/io/log.h"
+#include "../util/memory/memory.h"
+#include "../util/profiling.h"
+
+#include <algorithm>
+
+namespace zylann::voxel {
+
+void VoxelGeneratorBlockCache::set_capacity(unsigned int capacity) {
+	MutexLock mlock(_mutex);
+	_capacity = capacity;
+	if (_capacity == 0) {
+		_entries.clear();
+	} else if (_entries.size() > _capacity) {
+		evict_oldest();
+	}
+}
+
+unsigned int VoxelGeneratorBlockCache::get_capacity() const {
+	MutexLock mlock(_mutex);
+	return _capacity;
+}
+
+void VoxelGeneratorBlockCache::register_user(VolumeID volume_id) {
+	MutexLock mlock(_mutex);
+	if (find_user(volume_id) != -1) {
+		return;
+	}
+	for (unsigned int i = 0; i < _users.size(); ++i) {
+		const uint32_t bit = 1u << i;
+		if ((_users_mask & bit) == 0) {
+			_users[i] = volume_id;
+			_users_mask |= bit;
+			_active.store(is_active(), std::memory_order_relaxed);
+			return;
+		}
+	}
+	// Not an error, the volume will just generate its blocks on its own
+	ZN_PRINT_VERBOSE("Too many volumes are using the same generator, some won't share its cache");
+}
+
+void VoxelGeneratorBlockCache::unregister_user(VolumeID volume_id) {
+	MutexLock mlock(_mutex);
+
+	const int user_index = find_user(volume_id);
+	if (user_index == -1) {
+		return;
+	}
+	const uint32_t bit = 1u << user_index;
+	_users_mask &= ~bit;
+	_active.store(is_active(), std::memory_order_relaxed);
+
+	if (!is_active()) {
+		_entries.clear();
+		return;
+	}
+
+	for (auto it = _entries.begin(); it != _entries.end();) {
+		Entry &entry = it->second;
+		entry.consumers_mask &= ~bit;
+		// Remaining volumes may no longer be waiting for some blocks
+		if ((entry.consumers_mask & _users_mask) == _users_mask) {
+			it = _entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+uint32_t VoxelGeneratorBlockCache::get_revision() const {
+	return _revision.load(std::memory_order_acquire);
+}
+
+bool VoxelGeneratorBlockCache::try_get(Vector3i block_position, uint8_t lod_index, uint8_t block_size,
+		VolumeID volume_id, VoxelBuffer &out_voxels, bool &out_max_lod_hint) {
+	if (!_active.load(std::memory_order_relaxed)) {
+		// Nothing can be shared
+		return false;
+	}
+
+	ZN_PROFILE_SCOPE();
+
+	std::shared_ptr<VoxelBuffer> voxels;
+	{
+		MutexLock mlock(_mutex);
+
+		if (!is_active()) {
+			return false;
+		}
+		const int user_index = find_user(volume_id);
+		if (user_index == -1) {
+			return false;
+		}
+
+		auto it = _entries.find(Key{ block_position, lod_index, block_size });
+		if (it == _entries.end()) {
+			return false;
+		}
+
+		Entry &entry = it->second;
+		voxels = entry.voxels;
+		out_max_lod_hint = entry.max_lod_hint;
+
+		entry.consumers_mask |= (1u << user_index);
+		if ((entry.consumers_mask & _users_mask) == _users_mask) {
+			// Every volume got it
+			_entries.erase(it);
+		}
+	}
+
+	// Cached blocks are not modified after being added, so they can be copied without holding the lock
+	voxels->copy_to(out_voxels, true);
+	return true;
+}
+
+void VoxelGeneratorBlockCache::put(Vector3i block_position, uint8_t lod_index, uint8_t block_size,
+		VolumeID volume_id, const VoxelBuffer &voxels, bool max_lod_hint, uint32_t revision) {
+	if (!_active.load(std::memory_order_relaxed) || revision != _revision.load(std::memory_order_relaxed)) {
+		// Nothing can be shared, or the block is outdated
+		return;
+	}
+
+	ZN_PROFILE_SCOPE();
+
+	// Copied before locking. The copy is wasted if the block can't be added after all, but that's rare.
+	std::shared_ptr<VoxelBuffer> voxels_copy = make_shared_instance<VoxelBuffer>(VoxelBuffer::ALLOCATOR_POOL);
+	voxels.copy_to(*voxels_copy, true);
+	voxels_copy->compress_uniform_channels();
+
+	MutexLock mlock(_mutex);
+
+	if (_capacity == 0 || revision != _revision || !is_active()) {
+		return;
+	}
+	const int user_index = find_user(volume_id);
+	if (user_index == -1) {
+		return;
+	}
+
+	auto p = _entries.insert({ Key{ block_position, lod_index, block_size }, Entry() });
+	if (!p.second) {
+		// Another volume generated the same block at the same time
+		return;
+	}
+
+	Entry &entry = p.first->second;
+	entry.voxels = std::move(voxels_copy);
+	entry.consumers_mask = 1u << user_index;
+	entry.time = ++_time;
+	entry.max_lod_hint = max_lod_hint;
+
+	if (_entries.size() > _capacity) {
+		evict_oldest();
+	}
+}
+
+void VoxelGeneratorBlockCache::clear() {
+	MutexLock mlock(_mutex);
+	++_revision;
+	_entries.clear();
+}
+
+bool VoxelGeneratorBlockCache::is_active() const {
+	// Sharing starts with two volumes
+	return (_users_mask & (_users_mask - 1)) != 0;
+}
+
+int VoxelGeneratorBlockCache::find_user(VolumeID volume_id) const {
+	for (unsigned int i = 0; i < _users.size(); ++i) {
+		if ((_users_mask & (1u << i)) != 0 && _users[i] == volume_id) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void VoxelGeneratorBlockCache::evict_oldest() {
+	ZN_PROFILE_SCOPE();
+
+	// Evict a bit more than necessary, so we don't have to do this every time a block is added
+	const unsigned int target_count = _capacity - _capacity / 8;
+	const unsigned int remove_count = _entries.size() - target_count;
+
+	static thread_local StdVector<uint32_t> tls_times;
+	tls_times.clear();
+	for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+		tls_times.push_back(it->second.time);
+	}
+
+	// Times are unique, so this finds the most recent time among blocks to remove
+	std::nth_element(tls_times.begin(), tls_times.begin() + (remove_count - 1), tls_times.end());
+	const uint32_t max_time_to_remove = tls_times[remove_count - 1];
+
+	for (auto it = _entries.begin(); it != _entries.end();) {
+		if (it->second.time <= max_time_to_remove) {
+			it = _entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+} // namespace zylann::voxel
@@ -0,0 +1,97 @@
+#ifndef VOXEL_GENERATOR_BLOCK_CACHE_H
+#define VOXEL_GENERATOR_BLOCK_CACHE_H
+
+#include "../engine/ids.h"
+#include "../util/containers/fixed_array.h"
+#include "../util/containers/std_unordered_map.h"
+#include "../util/math/vector3i.h"
+#include "../util/thread/mutex.h"
+
+#include <atomic>
+#include <memory>
+
+namespace zylann::voxel {
+
+class VoxelBuffer;
+
+// Keeps recent results of a generator, so they can be shared between multiple volumes using the same generator.
+// Such volumes often overlap (for example a terrain and a low-detail version of it, or split-screen views), and would
+// otherwise generate the same blocks once per volume.
+// Each volume using the cache has to be registered. A block is kept until all registered volumes obtained it, or until
+// the cache is full, in which case oldest blocks are removed first. The cache does nothing while less than two volumes
+// are registered, and doesn't lock in that case.
+// Cached blocks are raw generator outputs: volume-specific modifications such as modifiers must be applied after.
+// Can be accessed from multiple threads.
+class VoxelGeneratorBlockCache {
+public:
+	static const unsigned int MAX_USERS = 32;
+
+	// Maximum number of blocks kept in the cache. 0 disables caching.
+	void set_capacity(unsigned int capacity);
+	unsigned int get_capacity() const;
+
+	void register_user(VolumeID volume_id);
+	// Removes blocks that are no longer awaited by any other volume
+	void unregister_user(VolumeID volume_id);
+
+	// Incremented every time the cache is cleared. Blocks generated while that happened may have used old generator
+	// settings, so the revision has to be obtained before they start generating.
+	uint32_t get_revision() const;
+
+	// Copies a block of the given position, LOD index and size into `out_voxels`, if found.
+	bool try_get(Vector3i block_position, uint8_t lod_index, uint8_t block_size, VolumeID volume_id,
+			VoxelBuffer &out_voxels, bool &out_max_lod_hint);
+
+	// Stores a copy of a block generated for a volume, if other registered volumes might need it too.
+	// Does nothing if the cache was cleared since `revision` was obtained.
+	void put(Vector3i block_position, uint8_t lod_index, uint8_t block_size, VolumeID volume_id,
+			const VoxelBuffer &voxels, bool max_lod_hint, uint32_t revision);
+
+	// Must be called when the generator changes in a way that produces different results
+	void clear();
+
+private:
+	struct Key {
+		Vector3i position;
+		uint8_t lod_index;
+		uint8_t block_size;
+
+		inline bool operator==(const Key &other) const {
+			return position == other.position && lod_index == other.lod_index && block_size == other.block_size;
+		}
+	};
+
+	struct KeyHasher {
+		inline size_t operator()(const Key &key) const {
+			uint32_t h = Vector3iHasher::hash(key.position);
+			h = hash_djb2_one_32(key.lod_index, h);
+			return hash_djb2_one_32(key.block_size, h);
+		}
+	};
+
+	struct Entry {
+		std::shared_ptr<VoxelBuffer> voxels;
+		// Bits of users that already obtained the block
+		uint32_t consumers_mask;
+		uint32_t time;
+		bool max_lod_hint;
+	};
+
+	bool is_active() const;
+	int find_user(VolumeID volume_id) const;
+	void evict_oldest();
+
+	StdUnorderedMap<Key, Entry, KeyHasher> _entries;
+	FixedArray<VolumeID, MAX_USERS> _users;
+	uint32_t _users_mask = 0;
+	unsigned int _capacity = 1024;
+	uint32_t _time = 0;
+	std::atomic_uint32_t _revision = { 0 };
+	// Same as `is_active()`, but can be checked without locking
+	std::atomic_bool _active = { false };
+	mutable BinaryMutex _mutex;
+};
+
+} // namespace zylann::voxel
+
+#endif // VOXEL_GENERATOR_BLOCK_CACHE_H
@@ -346,15 +346,25 @@ void VoxelBlockyType::bake(StdVector<VoxelBlockyModel::BakedData> &out_models, S
 	out_models.resize(out_models.size() + keys.size());
 	Span<VoxelBlockyModel::BakedData> baked_models(&out_models[first_model_index], keys.size());
 
+	// Many variants end up with the same model and rotation, for example when they differ by attributes that don't
+	// have specific models. Baking is expensive, so results are reused in such cases.
+	struct BakedVariant {
+		const VoxelBlockyModel *model;
+		// -1 if the model is used as-is
+		int rotation;
+		unsigned int variant_index;
+	};
+	StdVector<BakedVariant> baked_variants;
+
 	for (unsigned int variant_index = 0; variant_index < baked_models.size(); ++variant_index) {
 		VoxelBlockyModel::BakedData &baked_model = baked_models[variant_index];
 		const VariantKey &key = keys[variant_index];
 
 		Ref<VoxelBlockyModel> model = get_variant(key);
+		int rotation = -1;
 
 		if (model.is_valid()) {
 			// Variant specified explicitely, just use it
-			model->bake(baked_model, bake_tangents, material_indexer);
 
 		} else if (_automatic_rotations && rotation_attribute.is_valid()) {
 			// Not specified, but the type has a rotation attribute.
@@ -367,8 +377,8 @@ void VoxelBlockyType::bake(StdVector<VoxelBlockyModel::BakedData> &out_models, S
 			// The model with default rotation must have been assigned.
 			VariantKey ref_key = key;
 			ref_key.attribute_values[rotation_attribute_index] = rotation_attribute->get_default_value();
-			Ref<VoxelBlockyModel> ref_model = get_variant(ref_key);
-			if (ref_model.is_null()) {
+			model = get_variant(ref_key);
+			if (model.is_null()) {
 				// If not, use base model...
 				if (_base_model.is_null()) {
 					if (print_warnings) {
@@ -381,26 +391,45 @@ void VoxelBlockyType::bake(StdVector<VoxelBlockyModel::BakedData> &out_models, S
 					}
 					continue;
 				}
-				ref_model = _base_model;
+				model = _base_model;
 			}
-
-			// Apply rotation
-			const math::OrthoBasis trans_basis =
-					get_baking_rotation_ortho_basis(rotation_attribute, key.attribute_values[rotation_attribute_index]);
-			Ref<VoxelBlockyModel> temp_model = ref_model->duplicate();
-			temp_model->rotate_ortho(trans_basis);
-			temp_model->bake(baked_model, bake_tangents, material_indexer);
+			rotation = key.attribute_values[rotation_attribute_index];
 
 		} else {
 			// No variant specified, use base model.
-			if (_base_model.is_valid()) {
-				_base_model->bake(baked_model, bake_tangents, material_indexer);
-			} else if (print_warnings) {
-				WARN_PRINT(
-						String("No model found for variant {0} when baking {1} with name {2}. The model will be empty.")
-								.format(varray(key.to_string(), get_class(), get_unique_name())));
+			model = _base_model;
+			if (model.is_null()) {
+				if (print_warnings) {
+					WARN_PRINT(String(
+							"No model found for variant {0} when baking {1} with name {2}. The model will be empty.")
+									   .format(varray(key.to_string(), get_class(), get_unique_name())));
+				}
+				continue;
 			}
 		}
+
+		const VoxelBlockyModel *model_ptr = model.ptr();
+		size_t baked_variant_index;
+		if (find(to_span_const(baked_variants), baked_variant_index,
+					[model_ptr, rotation](const BakedVariant &bv) {
+						return bv.model == model_ptr && bv.rotation == rotation;
+					})) {
+			// Same model as another variant
+			baked_model = baked_models[baked_variants[baked_variant_index].variant_index];
+			continue;
+		}
+
+		if (rotation == -1) {
+			model->bake(baked_model, bake_tangents, material_indexer);
+		} else {
+			// Apply rotation
+			const math::OrthoBasis trans_basis = get_baking_rotation_ortho_basis(rotation_attribute, rotation);
+			Ref<VoxelBlockyModel> temp_model = model->duplicate();
+			temp_model->rotate_ortho(trans_basis);
+			temp_model->bake(baked_model, bake_tangents, material_indexer);
+		}
+
+		baked_variants.push_back(BakedVariant{ model_ptr, rotation, variant_index });
 	}
 
 	if (_base_model.is_valid()) {
@@ -7,12 +7,55 @@
 #include "../../../util/godot/core/array.h"
 #include "../../../util/godot/core/string.h"
 #include "../../../util/godot/core/typed_array.h"
+#include "../../../util/hash_funcs.h"
 #include "../../../util/profiling.h"
 #include "../../../util/string/format.h"
 #include "../voxel_blocky_model_cube.h"
 
 namespace zylann::voxel {
 
+size_t VoxelBlockyTypeLibrary::VoxelIDHasher::operator()(const VoxelID &id) const {
+	uint64_t h = id.type_name.hash();
+	for (unsigned int i = 0; i < id.variant_key.attribute_names.size(); ++i) {
+		h = hash_djb2_one_64(id.variant_key.attribute_names[i].hash(), h);
+		h = hash_djb2_one_64(id.variant_key.attribute_values[i], h);
+	}
+	return h;
+}
+
+VoxelBlockyTypeLibrary::IDMapIndexer::IDMapIndexer(StdVector<VoxelID> &id_map) : _id_map(id_map) {
+	_indices.reserve(id_map.size());
+	for (unsigned int i = 0; i < id_map.size(); ++i) {
+		const VoxelID &id = id_map[i];
+		if (!(id == VoxelID())) {
+			// In case of duplicates, the first one is used
+			_indices.insert({ id, i });
+		}
+	}
+}
+
+unsigned int VoxelBlockyTypeLibrary::IDMapIndexer::get_or_allocate(const VoxelID &id) {
+	// Find existing slot in the ID map. If found, use pre-allocated index.
+	auto it = _indices.find(id);
+	if (it != _indices.end()) {
+		return it->second;
+	}
+	// If not found, pick an empty slot if any. Slots only get filled, so there is no need to search from the
+	// beginning every time.
+	while (_empty_slot_search_index < _id_map.size() && !(_id_map[_empty_slot_search_index] == VoxelID())) {
+		++_empty_slot_search_index;
+	}
+	const unsigned int model_index = _empty_slot_search_index;
+	if (model_index < _id_map.size()) {
+		_id_map[model_index] = id;
+	} else {
+		// If not found, allocate a new index at the end
+		_id_map.push_back(id);
+	}
+	_indices.insert({ id, model_index });
+	return model_index;
+}
+
 void VoxelBlockyTypeLibrary::clear() {
 	_types.clear();
 }
@@ -56,6 +99,8 @@ void VoxelBlockyTypeLibrary::bake() {
 
 	_baked_data.models.resize(_id_map.size());
 
+	IDMapIndexer id_map_indexer(_id_map);
+
 	for (size_t i = 0; i < _types.size(); ++i) {
 		Ref<VoxelBlockyType> type = _types[i];
 		ZN_ASSERT_CONTINUE_MSG(
@@ -71,17 +116,9 @@ void VoxelBlockyTypeLibrary::bake() {
 			// _baked_data.models.push_back(std::move(baked_model));
 			id.variant_key = keys[rel_key_index];
 
-			size_t model_index;
-			// TODO Optimize this (when needed)
-			// Find existing slot in the ID map. If found, use pre-allocated index.
-			if (!find(to_span_const(_id_map), id, model_index)) {
-				// If not found, pick an empty slot if any
-				if (!find(to_span_const(_id_map), VoxelID(), model_index)) {
-					// If not found, allocate a new index at the end
-					model_index = _baked_data.models.size();
-					_baked_data.models.push_back(VoxelBlockyModel::BakedData());
-					_id_map.push_back(id);
-				}
+			const unsigned int model_index = id_map_indexer.get_or_allocate(id);
+			if (model_index >= _baked_data.models.size()) {
+				_baked_data.models.resize(model_index + 1);
 			}
 
 			_baked_data.models[model_index] = std::move(baked_model);
@@ -95,6 +132,8 @@ void VoxelBlockyTypeLibrary::bake() {
 
 	_baked_data.indexed_materials_count = _indexed_materials.size();
 
+	update_id_map_lookup();
+
 	generate_side_culling_matrix(_baked_data);
 
 	const uint64_t time_spent = Time::get_singleton()->get_ticks_usec() - time_before;
@@ -104,10 +143,25 @@ void VoxelBlockyTypeLibrary::bake() {
 
 void VoxelBlockyTypeLibrary::update_id_map() {
 	update_id_map(_id_map, nullptr);
+	update_id_map_lookup();
+}
+
+void VoxelBlockyTypeLibrary::update_id_map_lookup() {
+	ZN_PROFILE_SCOPE();
+	_id_map_lookup.clear();
+	_id_map_lookup.reserve(_id_map.size());
+	for (unsigned int i = 0; i < _id_map.size(); ++i) {
+		const VoxelID &id = _id_map[i];
+		if (!(id == VoxelID())) {
+			_id_map_lookup.insert({ id, i });
+		}
+	}
 }
 
 void VoxelBlockyTypeLibrary::update_id_map(StdVector<VoxelID> &id_map, StdVector<uint16_t> *used_ids) const {
+	ZN_PROFILE_SCOPE();
 	StdVector<VoxelBlockyType::VariantKey> keys;
+	IDMapIndexer id_map_indexer(id_map);
 
 	for (size_t i = 0; i < _types.size(); ++i) {
 		Ref<VoxelBlockyType> type = _types[i];
@@ -120,17 +174,7 @@ void VoxelBlockyTypeLibrary::update_id_map(StdVector<VoxelID> &id_map, StdVector
 		for (const VoxelBlockyType::VariantKey &key : keys) {
 			id.variant_key = key;
 
-			size_t model_index;
-			// TODO Optimize this (when needed)
-			// Find existing slot in the ID map. If found, use pre-allocated index.
-			if (!find(to_span_const(id_map), id, model_index)) {
-				// If not found, pick an empty slot if any
-				if (!find(to_span_const(id_map), VoxelID(), model_index)) {
-					// If not found, allocate a new index at the end
-					model_index = id_map.size();
-					id_map.push_back(id);
-				}
-			}
+			const unsigned int model_index = id_map_indexer.get_or_allocate(id);
 
 			if (used_ids != nullptr) {
 				used_ids->push_back(model_index);
@@ -359,14 +403,11 @@ int VoxelBlockyTypeLibrary::get_model_index_with_attributes(StringName type_name
 }
 
 int VoxelBlockyTypeLibrary::get_model_index(const VoxelID queried_id) const {
-	// Not optimized, we'll see if it needs to be a HashMap or other
-	for (unsigned int i = 0; i < _id_map.size(); ++i) {
-		const VoxelID &id = _id_map[i];
-		if (id == queried_id) {
-			return i;
-		}
+	auto it = _id_map_lookup.find(queried_id);
+	if (it == _id_map_lookup.end()) {
+		return -1;
 	}
-	return -1;
+	return it->second;
 }
 
 Ref<VoxelBlockyType> VoxelBlockyTypeLibrary::get_type_from_name(StringName p_name) const {
@@ -642,6 +683,7 @@ bool VoxelBlockyTypeLibrary::load_id_map_from_string_array(PackedStringArray map
 	}
 
 	_id_map = std::move(id_map);
+	update_id_map_lookup();
 	return true;
 }
 
@@ -1,6 +1,7 @@
 #ifndef VOXEL_BLOCKY_TYPE_LIBRARY_H
 #define VOXEL_BLOCKY_TYPE_LIBRARY_H
 
+#include "../../../util/containers/std_unordered_map.h"
 #include "../../../util/containers/std_vector.h"
 #include "../voxel_blocky_library_base.h"
 #include "voxel_blocky_type.h"
@@ -75,8 +76,28 @@ private:
 		}
 	};
 
+	struct VoxelIDHasher {
+		size_t operator()(const VoxelID &id) const;
+	};
+
+	// Finds model indices of IDs in an ID map in constant time, which matters when libraries have thousands of
+	// variants.
+	class IDMapIndexer {
+	public:
+		IDMapIndexer(StdVector<VoxelID> &id_map);
+
+		// Gets the index of an ID in the map. If not found, the first empty slot is used, or a new one is appended.
+		unsigned int get_or_allocate(const VoxelID &id);
+
+	private:
+		StdVector<VoxelID> &_id_map;
+		StdUnorderedMap<VoxelID, unsigned int, VoxelIDHasher> _indices;
+		unsigned int _empty_slot_search_index = 0;
+	};
+
 	void update_id_map();
 	void update_id_map(StdVector<VoxelID> &id_map, StdVector<uint16_t> *used_ids) const;
+	void update_id_map_lookup();
 	static PackedStringArray serialize_id_map_to_string_array(const StdVector<VoxelID> &id_map);
 
 	static bool parse_voxel_id(const String &str, VoxelID &out_id);
@@ -100,6 +121,8 @@ private:
 	// Can refer to types that no longer exist.
 	// Indices and size match `_baked_data.models`.
 	StdVector<VoxelID> _id_map;
+	// Reverse mapping of `_id_map`, excluding empty slots
+	StdUnorderedMap<VoxelID, unsigned int, VoxelIDHasher> _id_map_lookup;
 };
 
 } // namespace zylann::voxel
@@ -1,4 +1,5 @@
 #include "voxel_blocky_library_base.h"
+#include "../../util/containers/std_unordered_map.h"
 #include "../../util/math/triangle.h"
 #include "../../util/profiling.h"
 #include <bitset>
@@ -119,6 +120,8 @@ void generate_side_culling_matrix(VoxelBlockyLibraryBase::BakedData &baked_data)
 	};
 
 	StdVector<Pattern> patterns;
+	// Libraries with many variants have a lot of sides sharing the same pattern
+	StdUnorderedMap<std::bitset<RASTER_SIZE * RASTER_SIZE>, uint32_t> pattern_indices;
 	uint32_t full_side_pattern_index = VoxelBlockyLibraryBase::NULL_INDEX;
 
 	// Gather patterns for each model
@@ -187,28 +190,14 @@ void generate_side_culling_matrix(VoxelBlockyLibraryBase::BakedData &baked_data)
 				}
 			}
 
-			// Find if the same pattern already exists
-			uint32_t pattern_index = VoxelBlockyLibraryBase::NULL_INDEX;
-			for (unsigned int i = 0; i < patterns.size(); ++i) {
-				if (patterns[i].bitmap == bitmap) {
-					pattern_index = i;
-					break;
-				}
-			}
-
 			// Get or create pattern
-			Pattern *pattern = nullptr;
-			if (pattern_index != VoxelBlockyLibraryBase::NULL_INDEX) {
-				pattern = &patterns[pattern_index];
-			} else {
-				pattern_index = patterns.size();
+			auto pattern_it = pattern_indices.insert({ bitmap, static_cast<uint32_t>(patterns.size()) });
+			const uint32_t pattern_index = pattern_it.first->second;
+			if (pattern_it.second) {
 				patterns.push_back(Pattern());
-				pattern = &patterns.back();
-				pattern->bitmap = bitmap;
+				patterns.back().bitmap = bitmap;
 			}
 
-			CRASH_COND(pattern == nullptr);
-
 			if (full_side_pattern_index == VoxelBlockyLibraryBase::NULL_INDEX && bitmap.all()) {
 				full_side_pattern_index = pattern_index;
 			}
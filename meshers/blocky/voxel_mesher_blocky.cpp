@@ -578,6 +578,11 @@ void VoxelMesherBlocky::build(VoxelMesher::Output &output, const VoxelMesher::In
 		}
 	}
 
+	if (input.cancellation_token.is_valid_and_cancelled()) {
+		// The result is no longer needed, skip building surfaces
+		return;
+	}
+
 	// TODO Optimization: we could return a single byte array and use Mesh::add_surface down the line?
 	// That API does not seem to exist yet though.
 
@@ -57,7 +57,7 @@ CubicAreaInfo get_cubic_area_info_from_size(unsigned int size) {
 void copy_block_and_neighbors(Span<std::shared_ptr<VoxelBuffer>> blocks, VoxelBuffer &dst, int min_padding,
 		int max_padding, int channels_mask, Ref<VoxelGenerator> generator, const VoxelData &voxel_data,
 		uint8_t lod_index, Vector3i mesh_block_pos, StdVector<Box3i> *out_boxes_to_generate,
-		Vector3i *out_origin_in_voxels) {
+		Vector3i *out_origin_in_voxels, const TaskCancellationToken &cancellation_token) {
 	ZN_DSTACK();
 	ZN_PROFILE_SCOPE();
 
@@ -183,12 +183,18 @@ void copy_block_and_neighbors(Span<std::shared_ptr<VoxelBuffer>> blocks, VoxelBu
 	} else {
 		// Complete data with generated voxels on the CPU
 		ZN_PROFILE_SCOPE_NAMED("Generate");
-		VoxelBuffer generated_voxels(VoxelBuffer::ALLOCATOR_POOL);
+		VoxelBuffer generated_voxels(VoxelBuffer::ALLOCATOR_TEMP);
 
 		const VoxelModifierStack &modifiers = voxel_data.get_modifiers();
 
 		for (const Box3i &box : boxes_to_generate) {
 			ZN_PROFILE_SCOPE_NAMED("Box");
+
+			if (cancellation_token.is_valid_and_cancelled()) {
+				// The mesh is no longer needed
+				return;
+			}
+
 			// print_line(String("size={0}").format(varray(box.size.to_vec3())));
 			generated_voxels.create(box.size);
 			// generated_voxels.set_voxel_f(2.0f, box.size.x / 2, box.size.y / 2, box.size.z / 2,
@@ -196,13 +202,15 @@ void copy_block_and_neighbors(Span<std::shared_ptr<VoxelBuffer>> blocks, VoxelBu
 			VoxelGenerator::VoxelQueryData q{
 				generated_voxels, //
 				(box.position << lod_index) + origin_in_voxels, //
-				lod_index //
+				lod_index, //
+				cancellation_token //
 			};
 
 			if (generator.is_valid()) {
 				generator->generate_block(q);
 			}
-			modifiers.apply(q.voxel_buffer, AABB(q.origin_in_voxels, q.voxel_buffer.get_size() << lod_index));
+			modifiers.apply(q.voxel_buffer, AABB(q.origin_in_voxels, q.voxel_buffer.get_size() << lod_index),
+					cancellation_token);
 
 			for (const uint8_t channel_index : channels) {
 				dst.copy_channel_from(
@@ -295,6 +303,8 @@ void MeshBlockTask::run(zylann::ThreadedTaskContext &ctx) {
 			"Meshing task started without a mesher. Maybe missing on the terrain node?");
 #endif
 
+	_started = true;
+
 	if (block_generation_use_gpu) {
 		if (_stage == 0) {
 			gather_voxels_gpu(ctx);
@@ -308,6 +318,10 @@ void MeshBlockTask::run(zylann::ThreadedTaskContext &ctx) {
 		}
 	} else {
 		gather_voxels_cpu();
+		if (is_cancelled()) {
+			// The task will be reported as dropped
+			return;
+		}
 		build_mesh();
 	}
 }
@@ -325,7 +339,7 @@ void MeshBlockTask::gather_voxels_gpu(zylann::ThreadedTaskContext &ctx) {
 
 	copy_block_and_neighbors(to_span(blocks, blocks_count), _voxels, min_padding, max_padding,
 			mesher->get_used_channels_mask(), meshing_dependency->generator, *data, lod_index, mesh_block_position,
-			&boxes_to_generate, &origin_in_voxels);
+			&boxes_to_generate, &origin_in_voxels, cancellation_token);
 
 	if (boxes_to_generate.size() == 0) {
 		_stage = 2;
@@ -383,7 +397,7 @@ void MeshBlockTask::gather_voxels_cpu() {
 
 	copy_block_and_neighbors(to_span(blocks, blocks_count), _voxels, min_padding, max_padding,
 			mesher->get_used_channels_mask(), meshing_dependency->generator, *data, lod_index, mesh_block_position,
-			nullptr, nullptr);
+			nullptr, nullptr, cancellation_token);
 
 	// Could cache generator data from here if it was safe to write into the map
 	/*if (data != nullptr && cache_generated_blocks) {
@@ -435,10 +449,16 @@ void MeshBlockTask::build_mesh() {
 		collision_hint, //
 		lod_hint, //
 		// TODO Gathering detail texture information is not always necessary
-		true // detail_texture_hint
+		true, // detail_texture_hint
+		cancellation_token //
 	};
 	mesher->build(_surfaces_output, input);
 
+	if (is_cancelled()) {
+		// Don't spend more time on detail textures and mesh resources, the task will be reported as dropped
+		return;
+	}
+
 	const bool mesh_is_empty = VoxelMesher::is_mesh_empty(_surfaces_output.surfaces);
 
 	// Currently, Transvoxel only is supported in combination with detail normalmap texturing, because the algorithm
@@ -495,6 +515,31 @@ void MeshBlockTask::build_mesh() {
 		VoxelEngine::get_singleton().push_async_task(nm_task);
 	}
 
+	if (instance_library.is_valid() && !mesh_is_empty) {
+		generate_instances(mesh_block_size.x << lod_index);
+	}
+
+	if (recycle_previous_mesh && require_visual) {
+		StdVector<uint16_t> material_indices;
+		_mesh_signature = compute_mesh_signature(_surfaces_output, material_indices);
+
+		if (previous_mesh_signature.valid && previous_mesh_signature.layout_hash == _mesh_signature.layout_hash) {
+			if (previous_mesh_signature.content_hash == _mesh_signature.content_hash) {
+				_mesh_unchanged = true;
+			} else {
+				pack_mesh_vertex_data(_surfaces_output, _mesh_vertex_data);
+			}
+
+			if (_mesh_unchanged || _mesh_vertex_data.size() > 0) {
+				// No need to build a new mesh resource, the previous one can be reused
+				_mesh_material_indices = std::move(material_indices);
+				_has_mesh_resource = false;
+				_has_run = true;
+				return;
+			}
+		}
+	}
+
 	if (require_visual && VoxelEngine::get_singleton().is_threaded_graphics_resource_building_enabled()) {
 		// This can only run if the engine supports building meshes from multiple threads
 		_mesh = zylann::voxel::build_mesh(to_span(_surfaces_output.surfaces), _surfaces_output.primitive_type,
@@ -508,6 +553,31 @@ void MeshBlockTask::build_mesh() {
 	_has_run = true;
 }
 
+void MeshBlockTask::generate_instances(float block_size) {
+	ZN_PROFILE_SCOPE();
+
+	static thread_local StdVector<VoxelInstanceLibrary::PackedItem> tls_items;
+	tls_items.clear();
+	instance_library->get_packed_items_at_lod(tls_items, lod_index);
+
+	// Instances are generated on the first surface only, this is what `VoxelInstancer` would do
+	const Array &surface_arrays = _surfaces_output.surfaces[0].arrays;
+
+	for (const VoxelInstanceLibrary::PackedItem &item : tls_items) {
+		if (item.generator.is_null()) {
+			continue;
+		}
+		VoxelInstanceGeneratorOutput output;
+		output.layer_id = item.id;
+		if (surface_arrays.size() != 0) {
+			// All octants are generated. If some of them turn out to be edited, `VoxelInstancer` will generate again.
+			item.generator->generate_transforms(output.transforms, mesh_block_position, lod_index, item.id,
+					surface_arrays, static_cast<VoxelInstanceGenerator::UpMode>(instance_up_mode), 0xff, block_size);
+		}
+		_generated_instances.push_back(std::move(output));
+	}
+}
+
 TaskPriority MeshBlockTask::get_priority() {
 	float closest_viewer_distance_sq;
 	const TaskPriority p =
@@ -517,10 +587,16 @@ TaskPriority MeshBlockTask::get_priority() {
 }
 
 bool MeshBlockTask::is_cancelled() {
+	if (!meshing_dependency->valid) {
+		return true;
+	}
+	if (!_started && start_cancellation_token.is_valid_and_cancelled()) {
+		return true;
+	}
 	if (cancellation_token.is_valid()) {
 		return cancellation_token.is_cancelled();
 	}
-	return !meshing_dependency->valid || _too_far;
+	return _too_far;
 }
 
 void MeshBlockTask::apply_result() {
@@ -547,6 +623,12 @@ void MeshBlockTask::apply_result() {
 			o.has_mesh_resource = _has_mesh_resource;
 			o.visual_was_required = require_visual;
 			o.detail_textures = _detail_textures;
+			o.mesh_signature = _mesh_signature;
+			o.previous_mesh_signature = previous_mesh_signature;
+			o.mesh_unchanged = _mesh_unchanged;
+			o.mesh_vertex_data = std::move(_mesh_vertex_data);
+			o.generated_instances = std::move(_generated_instances);
+			o.mesh_cache_revision = mesh_cache_revision;
 
 			VoxelEngine::VolumeCallbacks callbacks = VoxelEngine::get_singleton().get_volume_callbacks(volume_id);
 			ERR_FAIL_COND(callbacks.mesh_output_callback == nullptr);
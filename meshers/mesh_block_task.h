@@ -4,10 +4,13 @@
 #include "../constants/voxel_constants.h"
 #include "../engine/detail_rendering/detail_rendering.h"
 #include "../engine/ids.h"
+#include "../engine/instance_generator_output.h"
 #include "../engine/meshing_dependency.h"
 #include "../engine/priority_dependency.h"
 #include "../generators/generate_block_gpu_task.h"
+#include "../meshers/mesh_recycling.h"
 #include "../storage/voxel_buffer.h"
+#include "../terrain/instancing/voxel_instance_library.h"
 #include "../util/containers/std_vector.h"
 #include "../util/godot/classes/array_mesh.h"
 #include "../util/tasks/cancellation_token.h"
@@ -63,13 +66,29 @@ public:
 	DetailRenderingSettings detail_texture_settings;
 	Ref<VoxelGenerator> detail_texture_generator_override;
 	TaskCancellationToken cancellation_token;
+	// Optional. Unlike `cancellation_token`, it only prevents the task from starting. Once running, the task finishes
+	// even if it gets cancelled. Used when a newer task replaces this one: cancelling running tasks too would prevent
+	// meshes from ever completing under continuous edits.
+	TaskCancellationToken start_cancellation_token;
+	// If true, the task tells if the previous mesh of the block can be kept or updated in place instead of building a
+	// new mesh resource. See `mesh_recycling.h`.
+	bool recycle_previous_mesh = false;
+	MeshSignature previous_mesh_signature;
+	// If valid, procedural instances of this library are generated on the mesh as part of the task, so they are ready
+	// by the time `VoxelInstancer` gets the block.
+	Ref<VoxelInstanceLibrary> instance_library;
+	uint8_t instance_up_mode = 0;
+	// Passed back in the output. Used by `VoxelLodTerrain` to tell if the result can be cached (see `MeshCacheVLT`).
+	uint32_t mesh_cache_revision = 0;
 
 private:
 	void gather_voxels_gpu(zylann::ThreadedTaskContext &ctx);
 	void gather_voxels_cpu();
 	void build_mesh();
+	void generate_instances(float block_size);
 
 	bool _has_run = false;
+	bool _started = false;
 	bool _too_far = false;
 	bool _has_mesh_resource = false;
 	uint8_t _stage = 0;
@@ -79,6 +98,10 @@ private:
 	StdVector<uint16_t> _mesh_material_indices; // Indexed by mesh surface
 	std::shared_ptr<DetailTextureOutput> _detail_textures;
 	StdVector<GenerateBlockGPUTaskResult> _gpu_generation_results;
+	MeshSignature _mesh_signature;
+	bool _mesh_unchanged = false;
+	StdVector<MeshSurfaceVertexData> _mesh_vertex_data;
+	StdVector<VoxelInstanceGeneratorOutput> _generated_instances;
 };
 
 Ref<ArrayMesh> build_mesh(Span<const VoxelMesher::Output::Surface> surfaces, Mesh::PrimitiveType primitive, int flags,
@@ -0,0 +1,190 @@
+#include "mesh_recycling.h"
+#include "../util/godot/classes/mesh.h"
+#include "../util/godot/classes/rendering_server.h"
+#include "../util/hash_funcs.h"
+#include "../util/profiling.h"
+
+#include <cstring>
+
+namespace zylann::voxel {
+
+namespace {
+
+// Must be the same condition `build_mesh` uses to add a surface to the mesh
+inline bool is_surface_added_to_mesh(const VoxelMesher::Output::Surface &surface) {
+	return !surface.arrays.is_empty() && surface.arrays.size() == Mesh::ARRAY_MAX &&
+			zylann::godot::is_surface_triangulated(surface.arrays);
+}
+
+uint64_t hash_bytes(Span<const uint8_t> bytes, uint64_t h) {
+	const size_t word_count = bytes.size() / sizeof(uint64_t);
+	for (size_t i = 0; i < word_count; ++i) {
+		uint64_t word;
+		memcpy(&word, bytes.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+		h = hash_fmix64(h ^ word);
+	}
+	uint64_t tail = 0;
+	const size_t tail_size = bytes.size() - word_count * sizeof(uint64_t);
+	if (tail_size > 0) {
+		memcpy(&tail, bytes.data() + word_count * sizeof(uint64_t), tail_size);
+	}
+	return hash_fmix64(h ^ tail ^ bytes.size());
+}
+
+template <typename T>
+inline Span<const uint8_t> to_bytes(const T *ptr, size_t count) {
+	return Span<const uint8_t>(reinterpret_cast<const uint8_t *>(ptr), count * sizeof(T));
+}
+
+// Calls `f(bytes, element_count)` with the contents of a packed array
+template <typename F>
+void visit_packed_array(const Variant &v, F f) {
+	switch (v.get_type()) {
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			const PackedVector3Array a = v;
+			f(to_bytes(a.ptr(), a.size()), a.size());
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			const PackedVector2Array a = v;
+			f(to_bytes(a.ptr(), a.size()), a.size());
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			const PackedFloat32Array a = v;
+			f(to_bytes(a.ptr(), a.size()), a.size());
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			const PackedInt32Array a = v;
+			f(to_bytes(a.ptr(), a.size()), a.size());
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			const PackedColorArray a = v;
+			f(to_bytes(a.ptr(), a.size()), a.size());
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			const PackedByteArray a = v;
+			f(to_bytes(a.ptr(), a.size()), a.size());
+		} break;
+		default:
+			f(Span<const uint8_t>(), 0);
+			break;
+	}
+}
+
+} // namespace
+
+MeshSignature compute_mesh_signature(const VoxelMesher::Output &output, StdVector<uint16_t> &out_material_indices) {
+	ZN_PROFILE_SCOPE();
+
+	uint64_t layout_hash = hash_fmix64(output.primitive_type);
+	layout_hash = hash_fmix64(layout_hash ^ output.mesh_flags);
+
+	uint64_t content_hash = 0;
+
+	for (const VoxelMesher::Output::Surface &surface : output.surfaces) {
+		if (!is_surface_added_to_mesh(surface)) {
+			continue;
+		}
+		out_material_indices.push_back(surface.material_index);
+		layout_hash = hash_fmix64(layout_hash ^ surface.material_index);
+
+		for (int array_index = 0; array_index < Mesh::ARRAY_MAX; ++array_index) {
+			const Variant &v = surface.arrays[array_index];
+			layout_hash = hash_fmix64(layout_hash ^ v.get_type());
+
+			visit_packed_array(v, [array_index, &layout_hash, &content_hash](Span<const uint8_t> bytes, size_t count) {
+				layout_hash = hash_fmix64(layout_hash ^ count);
+				if (array_index == Mesh::ARRAY_INDEX) {
+					layout_hash = hash_bytes(bytes, layout_hash);
+				} else {
+					content_hash = hash_bytes(bytes, content_hash);
+				}
+			});
+		}
+	}
+
+	const VoxelMesher::Output::CollisionSurface &collision_surface = output.collision_surface;
+	content_hash = hash_bytes(to_bytes(collision_surface.positions.data(), collision_surface.positions.size()),
+			hash_fmix64(content_hash ^ collision_surface.submesh_vertex_end));
+	content_hash = hash_bytes(to_bytes(collision_surface.indices.data(), collision_surface.indices.size()),
+			hash_fmix64(content_hash ^ collision_surface.submesh_index_end));
+
+	MeshSignature signature;
+	signature.layout_hash = layout_hash;
+	signature.content_hash = hash_fmix64(content_hash ^ layout_hash);
+	signature.valid = true;
+	return signature;
+}
+
+bool pack_mesh_vertex_data(const VoxelMesher::Output &output, StdVector<MeshSurfaceVertexData> &out_surfaces) {
+#if defined(ZN_GODOT)
+	ZN_PROFILE_SCOPE();
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	if (rs == nullptr) {
+		return false;
+	}
+	if ((output.mesh_flags & RenderingServer::ARRAY_FLAG_COMPRESS_ATTRIBUTES) != 0) {
+		// Compressed vertices are relative to the bounds of the surface, which can't be updated
+		return false;
+	}
+
+	for (const VoxelMesher::Output::Surface &surface : output.surfaces) {
+		if (!is_surface_added_to_mesh(surface)) {
+			continue;
+		}
+		// This is what `ArrayMesh::add_surface_from_arrays` does before creating buffers
+		RenderingServer::SurfaceData surface_data;
+		const Error err = rs->mesh_create_surface_data_from_arrays(&surface_data,
+				RenderingServer::PrimitiveType(output.primitive_type), surface.arrays, Array(), Dictionary(),
+				output.mesh_flags);
+		if (err != OK) {
+			out_surfaces.clear();
+			return false;
+		}
+		MeshSurfaceVertexData vd;
+		vd.vertex_data = surface_data.vertex_data;
+		vd.attribute_data = surface_data.attribute_data;
+		vd.aabb = surface_data.aabb;
+		out_surfaces.push_back(std::move(vd));
+	}
+
+	return true;
+
+#else
+	// TODO GDX: `RenderingServer::mesh_create_surface_data_from_arrays` is not exposed
+	return false;
+#endif
+}
+
+void update_mesh_vertex_data(ArrayMesh &mesh, Span<const MeshSurfaceVertexData> surfaces) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT_RETURN(static_cast<int>(surfaces.size()) == mesh.get_surface_count());
+
+	RenderingServer &rs = *RenderingServer::get_singleton();
+	const RID mesh_rid = mesh.get_rid();
+
+	AABB aabb;
+	for (unsigned int surface_index = 0; surface_index < surfaces.size(); ++surface_index) {
+		const MeshSurfaceVertexData &surface = surfaces[surface_index];
+
+		rs.mesh_surface_update_vertex_region(mesh_rid, surface_index, 0, surface.vertex_data);
+		if (surface.attribute_data.size() > 0) {
+			rs.mesh_surface_update_attribute_region(mesh_rid, surface_index, 0, surface.attribute_data);
+		}
+
+		if (surface_index == 0) {
+			aabb = surface.aabb;
+		} else {
+			aabb.merge_with(surface.aabb);
+		}
+	}
+
+	// Bounds of surfaces are not updated with their vertices. They remain those the mesh was built with, which is fine
+	// as long as the new vertices fit inside. Otherwise, a custom AABB is used until vertices fit again.
+	const AABB custom_aabb = mesh.get_aabb().encloses(aabb) ? AABB() : aabb;
+	if (mesh.get_custom_aabb() != custom_aabb) {
+		mesh.set_custom_aabb(custom_aabb);
+	}
+}
+
+} // namespace zylann::voxel
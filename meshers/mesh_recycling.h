@@ -0,0 +1,54 @@
+#ifndef VOXEL_MESH_RECYCLING_H
+#define VOXEL_MESH_RECYCLING_H
+
+#include "../util/containers/span.h"
+#include "../util/containers/std_vector.h"
+#include "../util/godot/classes/array_mesh.h"
+#include "voxel_mesher.h"
+
+namespace zylann::voxel {
+
+// Godot can't resize the graphics buffers of an existing mesh, nor update its indices, but it can update its vertex
+// data in place. When a block gets remeshed, it often produces the same mesh as before (for example, when a neighbor
+// block was edited), or a mesh with the same topology but different vertex data. In these cases the mesh resource the
+// block already has can be kept, instead of allocating new buffers and freeing the old ones, which is expensive on the
+// main thread.
+
+// Summarizes the mesh `build_mesh` would produce from the output of a mesher.
+struct MeshSignature {
+	// Hash of what determines the layout of graphics buffers: primitive, format, and for each surface, its material,
+	// its vertex count and its indices. A mesh can have its vertex data replaced by those of another mesh with the same
+	// layout.
+	uint64_t layout_hash = 0;
+	// Hash of all data, including the collision surface. Meshes with the same content can be used in place of each
+	// other.
+	uint64_t content_hash = 0;
+	bool valid = false;
+
+	inline bool operator==(const MeshSignature &other) const {
+		return valid == other.valid && layout_hash == other.layout_hash && content_hash == other.content_hash;
+	}
+};
+
+// Also outputs the mesher material index of each surface of the mesh.
+MeshSignature compute_mesh_signature(const VoxelMesher::Output &output, StdVector<uint16_t> &out_material_indices);
+
+// Vertex data of a mesh surface, packed in the format used by the renderer
+struct MeshSurfaceVertexData {
+	PackedByteArray vertex_data;
+	PackedByteArray attribute_data;
+	AABB aabb;
+};
+
+// Packs vertex data of the surfaces `build_mesh` would produce from the output of a mesher. Can run in any thread.
+// Returns false if it isn't supported, in which case the mesh must be built normally.
+bool pack_mesh_vertex_data(const VoxelMesher::Output &output, StdVector<MeshSurfaceVertexData> &out_surfaces);
+
+// Replaces vertex data of an existing mesh. The given surfaces must have the same layout as the ones the mesh was
+// built from. The mesh must not be used by anything else than the block it belongs to. Must be called from the main
+// thread.
+void update_mesh_vertex_data(ArrayMesh &mesh, Span<const MeshSurfaceVertexData> surfaces);
+
+} // namespace zylann::voxel
+
+#endif // VOXEL_MESH_RECYCLING_H
@@ -7,6 +7,8 @@
 #include "../../util/profiling.h"
 #include "transvoxel_tables.cpp"
 
+#include <utility>
+
 //#define VOXEL_TRANSVOXEL_REUSE_VERTEX_ON_COINCIDENT_CASES
 
 namespace zylann::voxel::transvoxel {
@@ -176,9 +178,18 @@ struct CellTextureDatas {
 	FixedArray<FixedArray<uint8_t, MAX_TEXTURE_BLENDS>, NVoxels> weights;
 };
 
-template <unsigned int NVoxels, typename WeightSampler_T>
+// Indices of voxels may be read packed as they are stored, or pre-decoded
+inline FixedArray<uint8_t, 4> get_voxel_texture_indices(uint16_t packed_indices) {
+	return decode_indices_from_packed_u16(packed_indices);
+}
+
+inline FixedArray<uint8_t, 4> get_voxel_texture_indices(uint32_t decoded_indices) {
+	return unpack_bytes_u32(decoded_indices);
+}
+
+template <unsigned int NVoxels, typename Indices_T, typename WeightSampler_T>
 CellTextureDatas<NVoxels> select_textures_4_per_voxel(const FixedArray<unsigned int, NVoxels> &voxel_indices,
-		Span<const uint16_t> indices_data, const WeightSampler_T &weights_sampler, unsigned int case_code) {
+		Span<const Indices_T> indices_data, const WeightSampler_T &weights_sampler, unsigned int case_code) {
 	// TODO Optimization: this function takes almost half of the time when polygonizing non-empty cells.
 	// I wonder how it can be optimized further?
 
@@ -207,7 +218,7 @@ CellTextureDatas<NVoxels> select_textures_4_per_voxel(const FixedArray<unsigned
 
 		const unsigned int data_index = voxel_indices[ci];
 
-		const FixedArray<uint8_t, 4> indices = decode_indices_from_packed_u16(indices_data[data_index]);
+		const FixedArray<uint8_t, 4> indices = get_voxel_texture_indices(indices_data[data_index]);
 		const FixedArray<uint8_t, 4> weights = weights_sampler.get_weights(data_index);
 
 		for (unsigned int j = 0; j < indices.size(); ++j) {
@@ -261,16 +272,87 @@ CellTextureDatas<NVoxels> select_textures_4_per_voxel(const FixedArray<unsigned
 	return cell_textures;
 }
 
+// Cells where all solid corners have the same 4 different indices are common (large areas painted with the same
+// textures). Selecting textures is then much simpler, because no other texture can be used in the cell.
+// Returns false if the cell doesn't fit that case. That includes cells where one of the 4 textures has no weight at
+// all: the generic path would then pick another zero-weight texture in its place, and results must be the same.
+template <unsigned int NVoxels, typename Indices_T, typename WeightSampler_T>
+bool try_select_textures_from_same_indices(CellTextureDatas<NVoxels> &cell_textures,
+		const FixedArray<unsigned int, NVoxels> &voxel_indices, Span<const Indices_T> indices_data,
+		const WeightSampler_T &weights_sampler, unsigned int case_code) {
+	Indices_T common_indices = 0;
+	bool found_solid = false;
+	for (unsigned int ci = 0; ci < voxel_indices.size(); ++ci) {
+		if ((case_code & (1 << ci)) != 0) {
+			// Air voxels don't contribute
+			continue;
+		}
+		const Indices_T voxel_indices_value = indices_data[voxel_indices[ci]];
+		if (!found_solid) {
+			common_indices = voxel_indices_value;
+			found_solid = true;
+		} else if (voxel_indices_value != common_indices) {
+			return false;
+		}
+	}
+	if (!found_solid) {
+		return false;
+	}
+
+	const FixedArray<uint8_t, 4> indices = get_voxel_texture_indices(common_indices);
+	if (indices[0] == indices[1] || indices[0] == indices[2] || indices[0] == indices[3] || indices[1] == indices[2] ||
+			indices[1] == indices[3] || indices[2] == indices[3]) {
+		// Duplicate indices need weights to be accumulated
+		return false;
+	}
+
+	// Sort indices the same way the generic path does, remembering where they come from to remap weights
+	FixedArray<uint8_t, 4> slots;
+	for (unsigned int i = 0; i < slots.size(); ++i) {
+		slots[i] = i;
+	}
+	for (unsigned int i = 1; i < slots.size(); ++i) {
+		for (unsigned int j = i; j > 0 && indices[slots[j - 1]] > indices[slots[j]]; --j) {
+			std::swap(slots[j - 1], slots[j]);
+		}
+	}
+	for (unsigned int i = 0; i < cell_textures.indices.size(); ++i) {
+		cell_textures.indices[i] = indices[slots[i]];
+	}
+	cell_textures.packed_indices = pack_bytes(cell_textures.indices);
+
+	FixedArray<unsigned int, 4> weight_sums;
+	fill(weight_sums, 0u);
+
+	for (unsigned int ci = 0; ci < voxel_indices.size(); ++ci) {
+		FixedArray<uint8_t, 4> &dst_weights = cell_textures.weights[ci];
+		if ((case_code & (1 << ci)) != 0) {
+			fill(dst_weights, uint8_t(0));
+			continue;
+		}
+		const FixedArray<uint8_t, 4> src_weights = weights_sampler.get_weights(voxel_indices[ci]);
+		for (unsigned int i = 0; i < dst_weights.size(); ++i) {
+			dst_weights[i] = src_weights[slots[i]];
+			weight_sums[i] += dst_weights[i];
+		}
+	}
+
+	return weight_sums[0] != 0 && weight_sums[1] != 0 && weight_sums[2] != 0 && weight_sums[3] != 0;
+}
+
+template <typename Indices_T>
 struct TextureIndicesData {
-	Span<const uint16_t> buffer;
+	// Empty if indices are the same for all voxels
+	Span<const Indices_T> buffer;
 	FixedArray<uint8_t, 4> default_indices;
 	uint32_t packed_default_indices;
 };
 
-template <unsigned int NVoxels, typename WeightSampler_T>
+template <unsigned int NVoxels, typename Indices_T, typename WeightSampler_T>
 inline void get_cell_texture_data(CellTextureDatas<NVoxels> &cell_textures,
-		const TextureIndicesData &texture_indices_data, const FixedArray<unsigned int, NVoxels> &voxel_indices,
-		const WeightSampler_T &weights_data, unsigned int case_code) {
+		const TextureIndicesData<Indices_T> &texture_indices_data,
+		const FixedArray<unsigned int, NVoxels> &voxel_indices, const WeightSampler_T &weights_data,
+		unsigned int case_code) {
 	if (texture_indices_data.buffer.size() == 0) {
 		// Indices are known for the whole block, just read weights directly
 		cell_textures.indices = texture_indices_data.default_indices;
@@ -285,7 +367,8 @@ inline void get_cell_texture_data(CellTextureDatas<NVoxels> &cell_textures,
 			}
 		}
 
-	} else {
+	} else if (!try_select_textures_from_same_indices(
+					   cell_textures, voxel_indices, texture_indices_data.buffer, weights_data, case_code)) {
 		// There can be more than 4 indices or they are not known, so we have to select them
 		cell_textures =
 				select_textures_4_per_voxel(voxel_indices, texture_indices_data.buffer, weights_data, case_code);
@@ -310,33 +393,114 @@ inline float get_isolevel<float>() {
 	return 0.f;
 }
 
-Vector3f binary_search_interpolate(const IDeepSDFSampler &sampler, float s0, float s1, Vector3i p0, Vector3i p1,
-		uint32_t initial_lod_index, uint32_t min_lod_index) {
-	for (uint32_t lod_index = initial_lod_index; lod_index > min_lod_index; --lod_index) {
-		const Vector3i pm = (p0 + p1) >> 1;
-		// TODO Optimization: this is quite slow for a small difference in the result.
-		// Could be improved somewhat, but for now I don't think it's worth it
-		const float sm = -sampler.get_single(pm, lod_index - 1);
-		if (sign_f(s0) != sign_f(sm)) {
-			p1 = pm;
-			s1 = sm;
-		} else {
-			p0 = pm;
-			s0 = sm;
+// Vertex of the regular mesh whose position has yet to be refined with deep sampling
+struct DeepSamplingQuery {
+	Vector3i p0;
+	Vector3i p1;
+	float s0;
+	float s1;
+	uint32_t vertex_index;
+};
+
+StdVector<DeepSamplingQuery> &get_tls_deep_sampling_queries() {
+	static thread_local StdVector<DeepSamplingQuery> tls_queries;
+	return tls_queries;
+}
+
+// Moves vertices closer to where the isosurface would be with more detailed voxels, by bisecting their edge down to
+// LOD 0. All vertices are advanced one step at a time, so each step only needs a single batch of samples.
+void refine_vertices_with_deep_sampling(const IDeepSDFSampler &sampler, Span<DeepSamplingQuery> queries,
+		MeshArrays &output, uint32_t lod_index, Vector3i block_size) {
+	ZN_PROFILE_SCOPE();
+
+	static thread_local StdVector<Vector3i> tls_positions;
+	static thread_local StdVector<float> tls_samples;
+	tls_positions.resize(queries.size());
+	tls_samples.resize(queries.size());
+	Span<Vector3i> positions = to_span(tls_positions);
+	Span<float> samples = to_span(tls_samples);
+
+	for (uint32_t sample_lod_index = lod_index; sample_lod_index > 0; --sample_lod_index) {
+		for (unsigned int i = 0; i < queries.size(); ++i) {
+			const DeepSamplingQuery &q = queries[i];
+			positions[i] = (q.p0 + q.p1) >> 1;
+		}
+
+		sampler.get_series(to_span_const(positions), sample_lod_index - 1, samples);
+
+		for (unsigned int i = 0; i < queries.size(); ++i) {
+			DeepSamplingQuery &q = queries[i];
+			const float sm = -samples[i];
+			if (sign_f(q.s0) != sign_f(sm)) {
+				q.p1 = positions[i];
+				q.s1 = sm;
+			} else {
+				q.p0 = positions[i];
+				q.s0 = sm;
+			}
+		}
+	}
+
+	for (const DeepSamplingQuery &q : queries) {
+		const float t = q.s1 / (q.s1 - q.s0);
+		const float t0 = t;
+		const float t1 = 1.f - t;
+		const Vector3f primaryf = to_vec3f(q.p0) * t0 + to_vec3f(q.p1) * t1;
+		output.vertices[q.vertex_index] = primaryf;
+
+		LodAttrib &lod_attrib = output.lod_data[q.vertex_index];
+		if (lod_attrib.cell_border_mask > 0) {
+			lod_attrib.secondary_position =
+					get_secondary_position(primaryf, output.normals[q.vertex_index], lod_index, block_size);
 		}
 	}
-	const float t = s1 / (s1 - s0);
-	const float t0 = t;
-	const float t1 = 1.f - t;
-	return to_vec3f(p0) * t0 + to_vec3f(p1) * t1;
+}
+
+// Stores which voxels of a plane are above the isolevel, as 0 or 1. These are the bits of case codes.
+template <typename Sdf_T>
+void compute_corner_signs(Span<const Sdf_T> plane_sdf, Span<uint8_t> out_signs) {
+	ZN_ASSERT_RETURN(plane_sdf.size() == out_signs.size());
+	// Get direct representation of the isolevel (not always zero since we are not using signed integers yet)
+	const Sdf_T isolevel = get_isolevel<Sdf_T>();
+	for (unsigned int i = 0; i < out_signs.size(); ++i) {
+		// The chosen comparison here is very important. This relates to case selections where 4 samples
+		// are equal to the isolevel and 4 others are above or below:
+		// In one of these two cases, there has to be a surface to extract, otherwise no surface will be
+		// allowed to appear if it happens to line up with integer coordinates.
+		// If we used `<` instead of `>`, it would appear to work, but would break those edge cases.
+		// `>` is chosen because our SDF is inverted compared to the one Transvoxel expects (see `sdf_as_float`).
+		out_signs[i] = plane_sdf[i] > isolevel;
+	}
+}
+
+// Gets signs of the 4 corners of a cell having the same Y, placed at their bits in a case code (corners 0, 1, 4 and 5).
+// Corners 2, 3, 6 and 7 are the same bits shifted by 2, taken from the next Y.
+inline uint8_t get_cell_corner_signs_at_y(
+		Span<const uint8_t> signs0, Span<const uint8_t> signs1, unsigned int plane_index, unsigned int n100) {
+	return signs0[plane_index] | (signs0[plane_index + n100] << 1) | (signs1[plane_index] << 4) |
+			(signs1[plane_index + n100] << 5);
+}
+
+// Gradients are shared by up to 8 cells, so they are computed only once and cached for the two planes of the current
+// deck of cells.
+template <typename Sdf_T>
+inline Vector3f get_corner_gradient_cached(Cache &cache, int plane_z, unsigned int plane_index,
+		unsigned int data_index, Span<const Sdf_T> sdf_data, const Vector3i block_size) {
+	const Vector3f *cached_gradient = cache.get_corner_gradient(plane_z, plane_index);
+	if (cached_gradient != nullptr) {
+		return *cached_gradient;
+	}
+	const Vector3f gradient = get_corner_gradient<Sdf_T>(data_index, sdf_data, block_size);
+	cache.set_corner_gradient(plane_z, plane_index, gradient);
+	return gradient;
 }
 
 // This function is template so we avoid branches and checks when sampling voxels
-template <typename Sdf_T, typename WeightSampler_T>
-void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_indices_data,
+template <typename Sdf_T, typename Indices_T, typename WeightSampler_T>
+void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData<Indices_T> texture_indices_data,
 		const WeightSampler_T &weights_sampler, const Vector3i block_size_with_padding, uint32_t lod_index,
-		TexturingMode texturing_mode, Cache &cache, MeshArrays &output, const IDeepSDFSampler *deep_sdf_sampler,
-		StdVector<CellInfo> *cell_info) {
+		TexturingMode texturing_mode, Cache &cache, MeshArrays &output,
+		StdVector<DeepSamplingQuery> *deep_sampling_queries, StdVector<CellInfo> *cell_info) {
 	ZN_PROFILE_SCOPE();
 
 	// This function has some comments as quotes from the Transvoxel paper.
@@ -361,40 +525,41 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 	const unsigned int n011 = n010 + n001;
 	const unsigned int n111 = n100 + n010 + n001;
 
-	// Get direct representation of the isolevel (not always zero since we are not using signed integers yet)
-	const Sdf_T isolevel = get_isolevel<Sdf_T>();
+	// Signs and gradients of voxels are shared by up to 8 cells, so instead of being fetched again by every cell,
+	// they are cached in two planes of voxels rolling along Z.
+	cache.reset_corner_planes(block_size_with_padding);
+	const unsigned int plane_area = block_size_with_padding.x * block_size_with_padding.y;
 
-	// Iterate all cells with padding (expected to be neighbors)
+	compute_corner_signs(sdf_data.sub(min_pos.z * plane_area, plane_area), cache.get_corner_signs(min_pos.z));
+
+	// Iterate all cells with padding (expected to be neighbors).
+	// Cells are iterated in ZXY order like voxel data, so cells of a column along Y are contiguous in memory.
 	Vector3i pos;
 	for (pos.z = min_pos.z; pos.z < max_pos.z; ++pos.z) {
-		for (pos.y = min_pos.y; pos.y < max_pos.y; ++pos.y) {
-			// TODO Optimization: change iteration to be ZXY? (Data is laid out with Y as deepest coordinate)
-			unsigned int data_index =
-					Vector3iUtil::get_zxy_index(Vector3i(min_pos.x, pos.y, pos.z), block_size_with_padding);
-
-			for (pos.x = min_pos.x; pos.x < max_pos.x; ++pos.x, data_index += block_size_with_padding.y) {
-				{
-					// The chosen comparison here is very important. This relates to case selections where 4 samples
-					// are equal to the isolevel and 4 others are above or below:
-					// In one of these two cases, there has to be a surface to extract, otherwise no surface will be
-					// allowed to appear if it happens to line up with integer coordinates.
-					// If we used `<` instead of `>`, it would appear to work, but would break those edge cases.
-					// `>` is chosen because it must match the comparison we do with case selection (in Transvoxel
-					// it is inverted).
-					const bool s = sdf_data[data_index] > isolevel;
-
-					if ( //
-							(sdf_data[data_index + n010] > isolevel) == s &&
-							(sdf_data[data_index + n100] > isolevel) == s &&
-							(sdf_data[data_index + n110] > isolevel) == s &&
-							(sdf_data[data_index + n001] > isolevel) == s &&
-							(sdf_data[data_index + n011] > isolevel) == s &&
-							(sdf_data[data_index + n101] > isolevel) == s &&
-							(sdf_data[data_index + n111] > isolevel) == s) {
-						// Not crossing the isolevel, this cell won't produce any geometry.
-						// We must figure this out as fast as possible, because it will happen a lot.
-						continue;
-					}
+		// The bottom plane of this deck was the top plane of the previous one, so only the top plane is computed
+		compute_corner_signs(
+				sdf_data.sub((pos.z + 1) * plane_area, plane_area), cache.get_corner_signs(pos.z + 1));
+		const Span<const uint8_t> signs0 = cache.get_corner_signs(pos.z);
+		const Span<const uint8_t> signs1 = cache.get_corner_signs(pos.z + 1);
+
+		for (pos.x = min_pos.x; pos.x < max_pos.x; ++pos.x) {
+			unsigned int plane_index =
+					Vector3iUtil::get_zxy_index(Vector3i(pos.x, min_pos.y, 0), block_size_with_padding);
+			unsigned int data_index = plane_index + pos.z * plane_area;
+
+			uint8_t signs_at_y = get_cell_corner_signs_at_y(signs0, signs1, plane_index, n100);
+
+			for (pos.y = min_pos.y; pos.y < max_pos.y; ++pos.y, ++plane_index, ++data_index) {
+				// Concatenate the sign of cell values to obtain the case code.
+				// Index 0 is the less significant bit, and index 7 is the most significant bit.
+				const uint8_t signs_at_next_y = get_cell_corner_signs_at_y(signs0, signs1, plane_index + n010, n100);
+				const uint8_t case_code = signs_at_y | (signs_at_next_y << 2);
+				signs_at_y = signs_at_next_y;
+
+				if (case_code == 0 || case_code == 255) {
+					// Not crossing the isolevel, this cell won't produce any geometry.
+					// We must figure this out as fast as possible, because it will happen a lot.
+					continue;
 				}
 
 				// ZN_PROFILE_SCOPE();
@@ -418,28 +583,19 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 				corner_data_indices[6] = data_index + n011;
 				corner_data_indices[7] = data_index + n111;
 
+				// Gets the gradient at a corner of the cell, from the plane it belongs to
+				auto get_cell_corner_gradient = [&](unsigned int corner_index) {
+					const unsigned int corner_plane_index =
+							plane_index + (corner_index & 1) * n100 + ((corner_index >> 1) & 1) * n010;
+					return get_corner_gradient_cached<Sdf_T>(cache, pos.z + (corner_index >> 2), corner_plane_index,
+							corner_data_indices[corner_index], sdf_data, block_size_with_padding);
+				};
+
 				FixedArray<float, 8> cell_samples_sdf;
 				for (unsigned int i = 0; i < corner_data_indices.size(); ++i) {
 					cell_samples_sdf[i] = sdf_as_float(sdf_data[corner_data_indices[i]]);
 				}
 
-				// Concatenate the sign of cell values to obtain the case code.
-				// Index 0 is the less significant bit, and index 7 is the most significant bit.
-				uint8_t case_code = sign_f(cell_samples_sdf[0]);
-				case_code |= (sign_f(cell_samples_sdf[1]) << 1);
-				case_code |= (sign_f(cell_samples_sdf[2]) << 2);
-				case_code |= (sign_f(cell_samples_sdf[3]) << 3);
-				case_code |= (sign_f(cell_samples_sdf[4]) << 4);
-				case_code |= (sign_f(cell_samples_sdf[5]) << 5);
-				case_code |= (sign_f(cell_samples_sdf[6]) << 6);
-				case_code |= (sign_f(cell_samples_sdf[7]) << 7);
-
-				// TODO Is this really needed now that we check isolevel earlier?
-				if (case_code == 0 || case_code == 255) {
-					// If the case_code is 0 or 255, there is no triangulation to do.
-					continue;
-				}
-
 				ReuseCell &current_reuse_cell = cache.get_reuse_cell(pos);
 
 #if DEBUG_ENABLED
@@ -562,21 +718,14 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 							// const int ti1 = 0x100 - t;
 							// const Vector3i primary = p0 * ti0 + p1 * ti1;
 
-							Vector3f primaryf;
-							if (deep_sdf_sampler != nullptr) {
-								primaryf = binary_search_interpolate(
-										*deep_sdf_sampler, sample0, sample1, p0, p1, lod_index, 0);
-							} else {
-								primaryf = to_vec3f(p0) * t0 + to_vec3f(p1) * t1;
-							}
+							// With deep sampling, this position is refined after all cells are processed
+							const Vector3f primaryf = to_vec3f(p0) * t0 + to_vec3f(p1) * t1;
 							// TODO Binary search gives better positional results, but does not improve normals.
 							// I'm not sure how to overcome this because if we sample low-detail normals, we get a
 							// "blocky" result due to SDF clipping. If we sample high-detail gradients, we get details,
 							// but if details are bumpy, we also get noisy results.
-							const Vector3f cg0 = get_corner_gradient<Sdf_T>(
-									corner_data_indices[v0], sdf_data, block_size_with_padding);
-							const Vector3f cg1 = get_corner_gradient<Sdf_T>(
-									corner_data_indices[v1], sdf_data, block_size_with_padding);
+							const Vector3f cg0 = get_cell_corner_gradient(v0);
+							const Vector3f cg1 = get_cell_corner_gradient(v1);
 							const Vector3f normal = normalized_not_null(cg0 * t0 + cg1 * t1);
 
 							Vector3f secondary;
@@ -591,6 +740,11 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 							cell_vertex_indices[vertex_index] = output.add_vertex(
 									primaryf, normal, cell_border_mask, vertex_border_mask, 0, secondary);
 
+							if (deep_sampling_queries != nullptr) {
+								const uint32_t vi = cell_vertex_indices[vertex_index];
+								deep_sampling_queries->push_back(DeepSamplingQuery{ p0, p1, sample0, sample1, vi });
+							}
+
 							if (texturing_mode == TEXTURES_BLEND_4_OVER_16) {
 								const FixedArray<uint8_t, MAX_TEXTURE_BLENDS> weights0 = cell_textures.weights[v0];
 								const FixedArray<uint8_t, MAX_TEXTURE_BLENDS> weights1 = cell_textures.weights[v1];
@@ -615,8 +769,7 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 
 						const Vector3i primary = p1;
 						const Vector3f primaryf = to_vec3f(primary);
-						const Vector3f cg1 =
-								get_corner_gradient<Sdf_T>(corner_data_indices[v1], sdf_data, block_size_with_padding);
+						const Vector3f cg1 = get_cell_corner_gradient(v1);
 						const Vector3f normal = normalized_not_null(cg1);
 
 						Vector3f secondary;
@@ -675,8 +828,7 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 
 							const Vector3i primary = t == 0 ? p1 : p0;
 							const Vector3f primaryf = to_vec3f(primary);
-							const Vector3f cg = get_corner_gradient<Sdf_T>(
-									corner_data_indices[vi], sdf_data, block_size_with_padding);
+							const Vector3f cg = get_cell_corner_gradient(vi);
 							const Vector3f normal = normalized_not_null(cg);
 
 							// TODO This bit of code is repeated several times, factor it?
@@ -758,8 +910,8 @@ void build_regular_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_i
 					cell_info->push_back(CellInfo{ pos - min_pos, effective_triangle_count });
 				}
 
-			} // x
-		} // y
+			} // y
+		} // x
 	} // z
 }
 
@@ -865,8 +1017,8 @@ inline uint8_t get_face_index(int cube_dir) {
 	}
 }
 
-template <typename Sdf_T, typename WeightSampler_T>
-void build_transition_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData texture_indices_data,
+template <typename Sdf_T, typename Indices_T, typename WeightSampler_T>
+void build_transition_mesh(Span<const Sdf_T> sdf_data, TextureIndicesData<Indices_T> texture_indices_data,
 		const WeightSampler_T &weights_sampler, const Vector3i block_size_with_padding, int direction, int lod_index,
 		TexturingMode texturing_mode, Cache &cache, MeshArrays &output) {
 	// From this point, we expect the buffer to contain allocated data.
@@ -1319,11 +1471,11 @@ Span<const T> get_or_decompress_channel(const VoxelBuffer &voxels, StdVector<T>
 	}
 }
 
-TextureIndicesData get_texture_indices_data(
+TextureIndicesData<uint16_t> get_texture_indices_data(
 		const VoxelBuffer &voxels, unsigned int channel, DefaultTextureIndicesData &out_default_texture_indices_data) {
-	ZN_ASSERT_RETURN_V(voxels.get_channel_depth(channel) == VoxelBuffer::DEPTH_16_BIT, TextureIndicesData());
+	ZN_ASSERT_RETURN_V(voxels.get_channel_depth(channel) == VoxelBuffer::DEPTH_16_BIT, TextureIndicesData<uint16_t>());
 
-	TextureIndicesData data;
+	TextureIndicesData<uint16_t> data;
 
 	if (voxels.is_uniform(channel)) {
 		const uint16_t encoded_indices = voxels.get_voxel(Vector3i(), channel);
@@ -1345,6 +1497,24 @@ TextureIndicesData get_texture_indices_data(
 	return data;
 }
 
+// Decodes indices of all voxels up-front. When there are many cells to polygonize, this is faster than decoding the
+// same voxels several times in each cell touching them.
+TextureIndicesData<uint32_t> decode_texture_indices_data(const TextureIndicesData<uint16_t> &src) {
+	TextureIndicesData<uint32_t> dst;
+	dst.default_indices = src.default_indices;
+	dst.packed_default_indices = src.packed_default_indices;
+
+	if (src.buffer.size() > 0) {
+		ZN_PROFILE_SCOPE();
+		static thread_local StdVector<uint32_t> tls_decoded_indices;
+		tls_decoded_indices.resize(src.buffer.size());
+		decode_indices_from_packed_u16(src.buffer, to_span(tls_decoded_indices));
+		dst.buffer = to_span_const(tls_decoded_indices);
+	}
+
+	return dst;
+}
+
 // I'm not really decided if doing this is better or not yet?
 //#define USE_TRICHANNEL
 
@@ -1376,6 +1546,22 @@ struct WeightSamplerPackedU16 {
 	}
 };
 
+// Same as above, with weights decoded up-front
+struct WeightSamplerDecodedU32 {
+	Span<const uint32_t> u32_data;
+	inline FixedArray<uint8_t, 4> get_weights(int i) const {
+		return unpack_bytes_u32(u32_data[i]);
+	}
+};
+
+WeightSamplerDecodedU32 decode_weights(Span<const uint16_t> packed_weights) {
+	ZN_PROFILE_SCOPE();
+	static thread_local StdVector<uint32_t> tls_decoded_weights;
+	tls_decoded_weights.resize(packed_weights.size());
+	decode_weights_from_packed_u16(packed_weights, to_span(tls_decoded_weights));
+	return WeightSamplerDecodedU32{ to_span_const(tls_decoded_weights) };
+}
+
 StdVector<uint16_t> &get_tls_weights_backing_buffer_u16() {
 	thread_local StdVector<uint16_t> tls_weights_backing_buffer_u16;
 	return tls_weights_backing_buffer_u16;
@@ -1435,8 +1621,8 @@ DefaultTextureIndicesData build_regular_mesh(const VoxelBuffer &voxels, unsigned
 
 	DefaultTextureIndicesData default_texture_indices_data;
 	default_texture_indices_data.use = false;
-	TextureIndicesData indices_data;
 #ifdef USE_TRICHANNEL
+	TextureIndicesData<uint16_t> indices_data;
 	WeightSampler3U8 weights_data;
 	if (texturing_mode == TEXTURES_BLEND_4_OVER_16) {
 		// From this point we know SDF is not uniform so it has an allocated buffer,
@@ -1453,30 +1639,41 @@ DefaultTextureIndicesData build_regular_mesh(const VoxelBuffer &voxels, unsigned
 		ERR_FAIL_COND_V(weights_data.u8_data2.size() != voxels_count, default_texture_indices_data);
 	}
 #else
-	WeightSamplerPackedU16 weights_data;
+	// Cells of the whole block may be polygonized, and each voxel is shared by up to 8 cells, so indices and weights
+	// are decoded up-front instead of in every cell
+	TextureIndicesData<uint32_t> indices_data;
+	WeightSamplerDecodedU32 weights_data;
 	if (texturing_mode == TEXTURES_BLEND_4_OVER_16) {
 		// From this point we know SDF is not uniform so it has an allocated buffer,
 		// but it might have uniform indices or weights so we need to ensure there is a backing buffer.
-		indices_data = get_texture_indices_data(voxels, VoxelBuffer::CHANNEL_INDICES, default_texture_indices_data);
-		weights_data.u16_data =
+		indices_data = decode_texture_indices_data(
+				get_texture_indices_data(voxels, VoxelBuffer::CHANNEL_INDICES, default_texture_indices_data));
+		Span<const uint16_t> packed_weights =
 				get_or_decompress_channel(voxels, get_tls_weights_backing_buffer_u16(), VoxelBuffer::CHANNEL_WEIGHTS);
-		ZN_ASSERT_RETURN_V(weights_data.u16_data.size() == voxels_count, default_texture_indices_data);
+		ZN_ASSERT_RETURN_V(packed_weights.size() == voxels_count, default_texture_indices_data);
+		weights_data = decode_weights(packed_weights);
 	}
 #endif
 
+	StdVector<DeepSamplingQuery> *deep_sampling_queries = nullptr;
+	if (deep_sdf_sampler != nullptr) {
+		deep_sampling_queries = &get_tls_deep_sampling_queries();
+		deep_sampling_queries->clear();
+	}
+
 	// We settle data types up-front so we can get rid of abstraction layers and conditionals,
 	// which would otherwise harm performance in tight iterations
 	switch (voxels.get_channel_depth(sdf_channel)) {
 		case VoxelBuffer::DEPTH_8_BIT: {
 			Span<const int8_t> sdf_data = sdf_data_raw.reinterpret_cast_to<const int8_t>();
 			build_regular_mesh<int8_t>(sdf_data, indices_data, weights_data, voxels.get_size(), lod_index,
-					texturing_mode, cache, output, deep_sdf_sampler, cell_infos);
+					texturing_mode, cache, output, deep_sampling_queries, cell_infos);
 		} break;
 
 		case VoxelBuffer::DEPTH_16_BIT: {
 			Span<const int16_t> sdf_data = sdf_data_raw.reinterpret_cast_to<const int16_t>();
 			build_regular_mesh<int16_t>(sdf_data, indices_data, weights_data, voxels.get_size(), lod_index,
-					texturing_mode, cache, output, deep_sdf_sampler, cell_infos);
+					texturing_mode, cache, output, deep_sampling_queries, cell_infos);
 		} break;
 
 		// TODO Remove support for 32-bit SDF in Transvoxel?
@@ -1485,7 +1682,7 @@ DefaultTextureIndicesData build_regular_mesh(const VoxelBuffer &voxels, unsigned
 		case VoxelBuffer::DEPTH_32_BIT: {
 			Span<const float> sdf_data = sdf_data_raw.reinterpret_cast_to<const float>();
 			build_regular_mesh<float>(sdf_data, indices_data, weights_data, voxels.get_size(), lod_index,
-					texturing_mode, cache, output, deep_sdf_sampler, cell_infos);
+					texturing_mode, cache, output, deep_sampling_queries, cell_infos);
 		} break;
 
 		case VoxelBuffer::DEPTH_64_BIT:
@@ -1498,9 +1695,23 @@ DefaultTextureIndicesData build_regular_mesh(const VoxelBuffer &voxels, unsigned
 			break;
 	}
 
+	if (deep_sampling_queries != nullptr && deep_sampling_queries->size() > 0) {
+		const Vector3i block_size = voxels.get_size() - Vector3iUtil::create(MIN_PADDING + MAX_PADDING);
+		refine_vertices_with_deep_sampling(
+				*deep_sdf_sampler, to_span(*deep_sampling_queries), output, lod_index, block_size);
+	}
+
 	return default_texture_indices_data;
 }
 
+void IDeepSDFSampler::get_series(
+		Span<const Vector3i> positions_in_voxels, uint32_t lod_index, Span<float> out_values) const {
+	ZN_ASSERT_RETURN(positions_in_voxels.size() == out_values.size());
+	for (unsigned int i = 0; i < positions_in_voxels.size(); ++i) {
+		out_values[i] = get_single(positions_in_voxels[i], lod_index);
+	}
+}
+
 void build_transition_mesh(const VoxelBuffer &voxels, unsigned int sdf_channel, int direction, uint32_t lod_index,
 		TexturingMode texturing_mode, Cache &cache, MeshArrays &output,
 		DefaultTextureIndicesData default_texture_indices_data) {
@@ -1513,7 +1724,8 @@ void build_transition_mesh(const VoxelBuffer &voxels, unsigned int sdf_channel,
 	const unsigned int voxels_count = Vector3iUtil::get_volume(voxels.get_size());
 
 	// TODO Support more texturing data configurations
-	TextureIndicesData indices_data;
+	// Transition cells only cover one side of the block, so voxels are decoded on the fly
+	TextureIndicesData<uint16_t> indices_data;
 #ifdef USE_TRICHANNEL
 	WeightSampler3U8 weights_data;
 	if (texturing_mode == TEXTURES_BLEND_4_OVER_16) {
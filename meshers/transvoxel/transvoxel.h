@@ -3,6 +3,7 @@
 
 #include "../../storage/voxel_buffer.h"
 #include "../../util/containers/fixed_array.h"
+#include "../../util/containers/span.h"
 #include "../../util/math/color.h"
 #include "../../util/math/vector2f.h"
 #include "../../util/math/vector3f.h"
@@ -134,9 +135,53 @@ public:
 		return _cache_2d[j][i];
 	}
 
+	// Per-voxel data of the two planes of voxels touched by a deck of cells. Planes are laid out like voxels
+	// (Y first, then X), and roll along Z: the top plane of a deck is the bottom plane of the next one.
+	void reset_corner_planes(Vector3i p_block_size) {
+		const unsigned int plane_area = p_block_size.x * p_block_size.y;
+		for (unsigned int i = 0; i < _corner_planes.size(); ++i) {
+			CornerPlane &plane = _corner_planes[i];
+			plane.signs.resize(plane_area);
+			plane.gradients.resize(plane_area);
+			plane.gradient_z.resize(plane_area);
+			to_span(plane.gradient_z).fill(-1);
+		}
+	}
+
+	inline Span<uint8_t> get_corner_signs(int z) {
+		return to_span(_corner_planes[z & 1].signs);
+	}
+
+	// Gradients are only computed for corners of cells producing geometry, so they are stored with the Z of the plane
+	// they were computed for, and are valid only if it matches.
+	inline Vector3f *get_corner_gradient(int z, unsigned int i) {
+		CornerPlane &plane = _corner_planes[z & 1];
+#ifdef DEBUG_ENABLED
+		ZN_ASSERT(i < plane.gradients.size());
+#endif
+		if (plane.gradient_z[i] != z) {
+			return nullptr;
+		}
+		return &plane.gradients[i];
+	}
+
+	inline void set_corner_gradient(int z, unsigned int i, Vector3f g) {
+		CornerPlane &plane = _corner_planes[z & 1];
+		plane.gradients[i] = g;
+		plane.gradient_z[i] = z;
+	}
+
 private:
+	struct CornerPlane {
+		// 1 if the voxel is above the isolevel, 0 otherwise. Same as the bits of a case code.
+		StdVector<uint8_t> signs;
+		StdVector<Vector3f> gradients;
+		StdVector<int> gradient_z;
+	};
+
 	FixedArray<StdVector<ReuseCell>, 2> _cache;
 	FixedArray<StdVector<ReuseTransitionCell>, 2> _cache_2d;
+	FixedArray<CornerPlane, 2> _corner_planes;
 	Vector3i _block_size;
 };
 
@@ -151,6 +196,9 @@ class IDeepSDFSampler {
 public:
 	virtual ~IDeepSDFSampler() {}
 	virtual float get_single(const Vector3i position_in_voxels, uint32_t lod_index) const = 0;
+	// Samples many positions at once, which can be much faster than calling `get_single` for each of them.
+	// The default implementation just does that.
+	virtual void get_series(Span<const Vector3i> positions_in_voxels, uint32_t lod_index, Span<float> out_values) const;
 };
 
 struct CellInfo {
@@ -124,6 +124,51 @@ void remap_vertex_array(const StdVector<T> &src_data, StdVector<T> &dst_data,
 			&dst_data[0], &src_data[0], src_data.size(), sizeof(T), remap_indices.data());
 }
 
+inline uint32_t get_packed_texture_weights(const Vector2f texturing_data) {
+	// See `add_texture_data` in the Transvoxel implementation, weights are bytes packed into the Y component
+	uint32_t packed_weights;
+	memcpy(&packed_weights, &texturing_data.y, sizeof(packed_weights));
+	return packed_weights;
+}
+
+inline bool is_texture_weight_difference_above(uint32_t packed_weights0, uint32_t packed_weights1, int threshold) {
+	for (unsigned int i = 0; i < transvoxel::MAX_TEXTURE_BLENDS; ++i) {
+		const int w0 = (packed_weights0 >> (i * 8)) & 0xff;
+		const int w1 = (packed_weights1 >> (i * 8)) & 0xff;
+		if ((w0 > w1 ? w0 - w1 : w1 - w0) > threshold) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Finds vertices along which texture blending changes, so simplification can keep them where they are.
+// The simplifier only considers positions, so collapsing them would stretch blending over the larger triangles left
+// around, and textures would bleed into each other. Regions where textures don't change can still be simplified.
+// Texture indices don't need to be checked: vertices are not shared between cells using different indices, so they
+// are already seams, which simplification preserves.
+void find_texture_blending_vertices(const transvoxel::MeshArrays &mesh, StdVector<uint8_t> &out_lock) {
+	ZN_PROFILE_SCOPE();
+
+	// In 0..255. Small differences are ignored, since weights are quantized and vary slightly everywhere.
+	static const int WEIGHT_DIFFERENCE_THRESHOLD = 16;
+
+	out_lock.clear();
+	out_lock.resize(mesh.vertices.size(), 0);
+
+	for (unsigned int ii = 0; ii + 2 < mesh.indices.size(); ii += 3) {
+		for (unsigned int j = 0; j < 3; ++j) {
+			const unsigned int vi0 = mesh.indices[ii + j];
+			const unsigned int vi1 = mesh.indices[ii + (j + 1) % 3];
+			if (is_texture_weight_difference_above(get_packed_texture_weights(mesh.texturing_data[vi0]),
+						get_packed_texture_weights(mesh.texturing_data[vi1]), WEIGHT_DIFFERENCE_THRESHOLD)) {
+				out_lock[vi0] = 1;
+				out_lock[vi1] = 1;
+			}
+		}
+	}
+}
+
 void simplify(const transvoxel::MeshArrays &src_mesh, transvoxel::MeshArrays &dst_mesh, float p_target_ratio,
 		float p_error_threshold) {
 	ZN_PROFILE_SCOPE();
@@ -141,6 +186,15 @@ void simplify(const transvoxel::MeshArrays &src_mesh, transvoxel::MeshArrays &ds
 	lod_indices.clear();
 	lod_indices.resize(src_mesh.indices.size());
 
+	// Texturing data is not supported by the simplifier, so vertices where it matters are locked instead
+	const uint8_t *vertex_lock = nullptr;
+	static thread_local StdVector<uint8_t> tls_vertex_lock;
+	if (src_mesh.texturing_data.size() != 0) {
+		ZN_ASSERT_RETURN(src_mesh.texturing_data.size() == src_mesh.vertices.size());
+		find_texture_blending_vertices(src_mesh, tls_vertex_lock);
+		vertex_lock = tls_vertex_lock.data();
+	}
+
 	float lod_error = 0.f;
 
 	// Simplify
@@ -148,9 +202,9 @@ void simplify(const transvoxel::MeshArrays &src_mesh, transvoxel::MeshArrays &ds
 		ZN_PROFILE_SCOPE_NAMED("meshopt_simplify");
 
 		// TODO See build script about the `zylannmeshopt::` namespace
-		const unsigned int lod_index_count = zylannmeshopt::meshopt_simplify(&lod_indices[0],
+		const unsigned int lod_index_count = zylannmeshopt::meshopt_simplifyWithVertexLock(&lod_indices[0],
 				reinterpret_cast<const unsigned int *>(src_mesh.indices.data()), src_mesh.indices.size(),
-				&src_mesh.vertices[0].x, src_mesh.vertices.size(), sizeof(Vector3f), target_index_count,
+				&src_mesh.vertices[0].x, src_mesh.vertices.size(), sizeof(Vector3f), vertex_lock, target_index_count,
 				p_error_threshold, &lod_error);
 
 		lod_indices.resize(lod_index_count);
@@ -215,6 +269,55 @@ struct DeepSampler : transvoxel::IDeepSDFSampler {
 			return generator.generate_single(position_in_voxels, sdf_channel).f;
 		}*/
 	}
+
+	void get_series(
+			Span<const Vector3i> positions_in_voxels, uint32_t lod_index, Span<float> out_values) const override {
+		ZN_PROFILE_SCOPE();
+		ZN_ASSERT_RETURN(positions_in_voxels.size() == out_values.size());
+
+		if (positions_in_voxels.size() == 0) {
+			return;
+		}
+
+		Vector3i min_pos = positions_in_voxels[0];
+		Vector3i max_pos = min_pos;
+		for (const Vector3i pos : positions_in_voxels) {
+			min_pos = math::min(min_pos, pos);
+			max_pos = math::max(max_pos, pos);
+		}
+		const Box3i box = Box3i::from_min_max(min_pos + origin, max_pos + origin + Vector3i(1, 1, 1));
+
+		if (!data.get_bounds().contains(box) || data.has_blocks_with_voxels_in_area_broad_mip_test(box)) {
+			// Voxel data may be involved, sample positions individually
+			for (unsigned int i = 0; i < positions_in_voxels.size(); ++i) {
+				out_values[i] = get_single(positions_in_voxels[i], lod_index);
+			}
+			return;
+		}
+
+		// Only the generator is involved, so everything can be obtained in a single batch
+		static thread_local StdVector<float> tls_x;
+		static thread_local StdVector<float> tls_y;
+		static thread_local StdVector<float> tls_z;
+		tls_x.resize(positions_in_voxels.size());
+		tls_y.resize(positions_in_voxels.size());
+		tls_z.resize(positions_in_voxels.size());
+		for (unsigned int i = 0; i < positions_in_voxels.size(); ++i) {
+			const Vector3i pos = positions_in_voxels[i] + origin;
+			tls_x[i] = pos.x;
+			tls_y[i] = pos.y;
+			tls_z[i] = pos.z;
+		}
+
+		const Vector3f query_min_pos = to_vec3f(box.position);
+		const Vector3f query_max_pos = to_vec3f(box.position + box.size);
+
+		generator.generate_series(to_span(tls_x), to_span(tls_y), to_span(tls_z), sdf_channel, out_values,
+				query_min_pos, query_max_pos);
+
+		data.get_modifiers().apply(
+				to_span(tls_x), to_span(tls_y), to_span(tls_z), out_values, query_min_pos, query_max_pos);
+	}
 };
 
 } // namespace
@@ -251,10 +354,9 @@ void VoxelMesherTransvoxel::build(VoxelMesher::Output &output, const VoxelMesher
 	}
 
 	if (_deep_sampling_enabled && input.generator != nullptr && input.data != nullptr && input.lod_index > 0) {
+		// Samples are requested in batches covering the whole block, so generators can process them with
+		// `generate_series`
 		const DeepSampler ds(*input.generator, *input.data, sdf_channel, input.origin_in_voxels);
-		// TODO Optimization: "area scope" feature on generators to optimize certain uses of `generate_single`.
-		// The idea is to call `begin_area(box)` and `end_area()`, so the generator can optimize random calls to
-		// `generate_single` in between, knowing they will all be done within the specified area.
 
 		default_texture_indices_data = transvoxel::build_regular_mesh(voxels, sdf_channel, input.lod_index,
 				static_cast<transvoxel::TexturingMode>(_texture_mode), tls_cache, mesh_arrays, &ds, cell_infos);
@@ -271,11 +373,15 @@ void VoxelMesherTransvoxel::build(VoxelMesher::Output &output, const VoxelMesher
 		// The mesh can have vertices, but still be empty, for example because triangles are all degenerate
 		return;
 	}
+	if (input.cancellation_token.is_valid_and_cancelled()) {
+		// Deep sampling can make the regular mesh take a while, the result might no longer be needed
+		return;
+	}
 
 	transvoxel::MeshArrays *combined_mesh_arrays = &mesh_arrays;
 	if (_mesh_optimization_params.enabled) {
-		// TODO When voxel texturing is enabled, this will decrease quality a lot.
-		// There is no support yet for taking textures into account when simplifying.
+		// When voxel texturing is enabled, vertices where texture blending changes are not simplified, so it
+		// simplifies less than untextured meshes.
 		// See https://github.com/zeux/meshoptimizer/issues/158
 		simplify(mesh_arrays, tls_simplified_mesh_arrays, _mesh_optimization_params.target_ratio,
 				_mesh_optimization_params.error_threshold);
@@ -294,6 +400,10 @@ void VoxelMesherTransvoxel::build(VoxelMesher::Output &output, const VoxelMesher
 		for (int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
 			ZN_PROFILE_SCOPE();
 
+			if (input.cancellation_token.is_valid_and_cancelled()) {
+				return;
+			}
+
 			transvoxel::build_transition_mesh(voxels, sdf_channel, dir, input.lod_index,
 					static_cast<transvoxel::TexturingMode>(_texture_mode), tls_cache, *combined_mesh_arrays,
 					default_texture_indices_data);
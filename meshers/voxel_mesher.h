@@ -8,6 +8,7 @@
 #include "../util/godot/classes/image.h"
 #include "../util/godot/classes/mesh.h"
 #include "../util/macros.h"
+#include "../util/tasks/cancellation_token.h"
 
 ZN_GODOT_FORWARD_DECLARE(class ShaderMaterial)
 
@@ -46,6 +47,9 @@ public:
 		// If true, the mesher can collect some extra information which can be useful to speed up detail texture
 		// baking. Depends on the mesher.
 		bool detail_texture_hint = false;
+		// Optional. Meshers can check it to stop early if the result is no longer needed, in which case the output
+		// may be left incomplete and must be discarded.
+		TaskCancellationToken cancellation_token;
 	};
 
 	struct Output {
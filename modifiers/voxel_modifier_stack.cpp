@@ -166,7 +166,7 @@ VoxelModifier *VoxelModifierStack::get_modifier(uint32_t id) const {
 	return nullptr;
 }
 
-void VoxelModifierStack::apply(VoxelBuffer &voxels, AABB aabb) const {
+void VoxelModifierStack::apply(VoxelBuffer &voxels, AABB aabb, TaskCancellationToken cancellation_token) const {
 	ZN_PROFILE_SCOPE();
 	RWLockRead lock(_stack_lock);
 
@@ -203,6 +203,10 @@ void VoxelModifierStack::apply(VoxelBuffer &voxels, AABB aabb) const {
 		if (modifier_aabb.intersects(aabb)) {
 			ZN_PROFILE_SCOPE_NAMED("Intersecting modifier");
 
+			if (cancellation_token.is_valid_and_cancelled()) {
+				return;
+			}
+
 			if (any_intersection == false) {
 				ZN_PROFILE_SCOPE_NAMED("Read block");
 				any_intersection = true;
@@ -5,6 +5,7 @@
 #include "../util/containers/std_vector.h"
 #include "../util/math/vector3f.h"
 #include "../util/memory/memory.h"
+#include "../util/tasks/cancellation_token.h"
 #include "voxel_modifier.h"
 
 namespace zylann::voxel {
@@ -34,7 +35,9 @@ public:
 	void remove_modifier(uint32_t id);
 	bool has_modifier(uint32_t id) const;
 	VoxelModifier *get_modifier(uint32_t id) const;
-	void apply(VoxelBuffer &voxels, AABB aabb) const;
+	// If the cancellation token gets cancelled, voxels might be left unmodified.
+	void apply(VoxelBuffer &voxels, AABB aabb,
+			TaskCancellationToken cancellation_token = TaskCancellationToken()) const;
 	void apply(float &sdf, Vector3 position) const;
 	void apply(Span<const float> x_buffer, Span<const float> y_buffer, Span<const float> z_buffer,
 			Span<float> sdf_buffer, Vector3f min_pos, Vector3f max_pos) const;
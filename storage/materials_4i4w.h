@@ -2,6 +2,7 @@
 #define VOXEL_MATERIAL_FUNCS_4I4W_H
 
 #include "../util/containers/fixed_array.h"
+#include "../util/containers/span.h"
 #include "../util/math/funcs.h"
 #include <cstdint>
 
@@ -45,6 +46,46 @@ inline FixedArray<uint8_t, 4> decode_indices_from_packed_u16(uint16_t packed_ind
 	return indices;
 }
 
+// Bulk versions of the decoding functions above, for when many voxels have to be decoded. Each voxel is decoded into 4
+// bytes packed in a 32-bit integer (first value in the lowest byte), which can be read with `unpack_bytes_u32`.
+// They are written without branches or per-byte stores so compilers can vectorize them.
+
+inline void decode_indices_from_packed_u16(Span<const uint16_t> src, Span<uint32_t> dst) {
+#ifdef DEBUG_ENABLED
+	ZN_ASSERT_RETURN(src.size() == dst.size());
+#endif
+	const uint16_t *src_data = src.data();
+	uint32_t *dst_data = dst.data();
+	const size_t count = src.size();
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t v = src_data[i];
+		dst_data[i] = (v & 0xf) | ((v & 0xf0) << 4) | ((v & 0xf00) << 8) | ((v & 0xf000) << 12);
+	}
+}
+
+inline void decode_weights_from_packed_u16(Span<const uint16_t> src, Span<uint32_t> dst) {
+#ifdef DEBUG_ENABLED
+	ZN_ASSERT_RETURN(src.size() == dst.size());
+#endif
+	const uint16_t *src_data = src.data();
+	uint32_t *dst_data = dst.data();
+	const size_t count = src.size();
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t v = src_data[i];
+		// Same result as the single-voxel version, with each byte being a multiple of 16
+		dst_data[i] = ((v & 0xf) << 4) | ((v & 0xf0) << 8) | ((v & 0xf00) << 12) | ((v & 0xf000) << 16);
+	}
+}
+
+inline FixedArray<uint8_t, 4> unpack_bytes_u32(uint32_t v) {
+	FixedArray<uint8_t, 4> bytes;
+	bytes[0] = v & 0xff;
+	bytes[1] = (v >> 8) & 0xff;
+	bytes[2] = (v >> 16) & 0xff;
+	bytes[3] = (v >> 24) & 0xff;
+	return bytes;
+}
+
 inline constexpr uint16_t encode_indices_to_packed_u16(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
 	return (a & 0xf) | ((b & 0xf) << 4) | ((c & 0xf) << 8) | ((d & 0xf) << 12);
 }
@@ -3,6 +3,7 @@
 #include "../util/containers/container_funcs.h"
 #include "../util/containers/dynamic_bitset.h"
 #include "../util/dstack.h"
+#include "../util/memory/arena_allocator.h"
 #include "../util/profiling.h"
 #include "../util/string/format.h"
 #include "materials_4i4w.h"
@@ -11,11 +12,23 @@
 
 namespace zylann::voxel {
 
+namespace {
+
+ArenaAllocator &get_tls_temp_arena() {
+	// Enough for a few padded blocks with several channels. Larger buffers fall back to the heap.
+	static thread_local ArenaAllocator tls_arena(1024 * 1024);
+	return tls_arena;
+}
+
+} // namespace
+
 inline uint8_t *allocate_channel_data(size_t size, VoxelBuffer::Allocator allocator) {
 	ZN_DSTACK();
 	switch (allocator) {
 		case VoxelBuffer::ALLOCATOR_POOL:
 			return VoxelMemoryPool::get_singleton().allocate(size);
+		case VoxelBuffer::ALLOCATOR_TEMP:
+			return static_cast<uint8_t *>(get_tls_temp_arena().allocate(size));
 		case VoxelBuffer::ALLOCATOR_DEFAULT:
 			return (uint8_t *)ZN_ALLOC(size * sizeof(uint8_t));
 		default:
@@ -29,6 +42,9 @@ inline void free_channel_data(uint8_t *data, uint32_t size, VoxelBuffer::Allocat
 		case VoxelBuffer::ALLOCATOR_POOL:
 			VoxelMemoryPool::get_singleton().recycle(data, size);
 			break;
+		case VoxelBuffer::ALLOCATOR_TEMP:
+			get_tls_temp_arena().free(data, size);
+			break;
 		case VoxelBuffer::ALLOCATOR_DEFAULT:
 			ZN_FREE(data);
 			break;
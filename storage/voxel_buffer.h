@@ -56,6 +56,10 @@ public:
 		// VoxelMemoryPool. Should be faster but remains allocated. Preferred if buffers of similar size are frequently
 		// created at runtime. Don't use for large, infrequent allocations or in-editor, to avoid hoarding memory.
 		ALLOCATOR_POOL,
+		// Thread-local arena. Fastest, for temporary buffers that are created and destroyed within the same task or
+		// function. Must be destroyed on the thread that created it, and its data must not be moved to a buffer that
+		// outlives the task.
+		ALLOCATOR_TEMP,
 		ALLOCATOR_COUNT
 	};
 
@@ -176,8 +176,20 @@ void VoxelBuffer::remap_values(unsigned int channel_index, PackedInt32Array map)
 	}
 }
 
+VoxelBuffer::Allocator VoxelBuffer::get_script_allocator(zylann::voxel::VoxelBuffer::Allocator allocator) {
+	switch (allocator) {
+		case zylann::voxel::VoxelBuffer::ALLOCATOR_DEFAULT:
+			return ALLOCATOR_DEFAULT;
+		case zylann::voxel::VoxelBuffer::ALLOCATOR_POOL:
+			return ALLOCATOR_POOL;
+		default:
+			// ALLOCATOR_TEMP: data must not outlive the task that allocated it
+			return ALLOCATOR_DEFAULT;
+	}
+}
+
 VoxelBuffer::Allocator VoxelBuffer::get_allocator() const {
-	return static_cast<VoxelBuffer::Allocator>(_buffer->get_allocator());
+	return get_script_allocator(_buffer->get_allocator());
 }
 
 Variant VoxelBuffer::get_block_metadata() const {
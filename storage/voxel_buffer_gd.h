@@ -75,6 +75,10 @@ public:
 	// Workaround because the constructor with arguments cannot always be used due to Godot limitations
 	static Ref<VoxelBuffer> create_shared(std::shared_ptr<zylann::voxel::VoxelBuffer> &other);
 
+	// Gets the allocator a script-facing buffer should use in place of the given internal one. Allocators for
+	// temporary buffers are not exposed, because scripts can keep the buffers they are given.
+	static Allocator get_script_allocator(zylann::voxel::VoxelBuffer::Allocator allocator);
+
 	inline const zylann::voxel::VoxelBuffer &get_buffer() const {
 #ifdef DEBUG_ENABLED
 		CRASH_COND(_buffer == nullptr);
@@ -124,6 +124,72 @@ public:
 		return true;
 	}
 
+	// Reads voxels of a box into a dense buffer in ZXY order, converted to floats the same way as `get_voxel_f`.
+	// Voxels found in the grid get their flag set to 1 in `out_found`, others are left untouched.
+	// Blocks are accessed directly, which is much faster than getting voxels one by one.
+	// The grid must be locked for reading.
+	void read_box_f(Box3i voxel_box, VoxelBuffer::ChannelId channel, Span<float> out_values,
+			Span<uint8_t> out_found) const {
+		ZN_PROFILE_SCOPE();
+#ifdef DEBUG_ENABLED
+		ZN_ASSERT(_locked);
+#endif
+		ZN_ASSERT_RETURN(out_values.size() == static_cast<size_t>(Vector3iUtil::get_volume(voxel_box.size)));
+		ZN_ASSERT_RETURN(out_found.size() == out_values.size());
+
+		Box3i blocks_box = voxel_box.downscaled(_block_size);
+		blocks_box.clip(Box3i(_offset_in_blocks, _size_in_blocks));
+		const Vector3i block_size = Vector3iUtil::create(_block_size);
+
+		blocks_box.for_each_cell_zxy([&](const Vector3i bpos) {
+			const unsigned int loc = Vector3iUtil::get_zxy_index(bpos - _offset_in_blocks, _size_in_blocks);
+			const VoxelBuffer *voxels = _blocks[loc].get();
+			if (voxels == nullptr) {
+				return;
+			}
+			const Vector3i block_origin = bpos * _block_size;
+			Box3i src_box(voxel_box.position - block_origin, voxel_box.size);
+			src_box.clip(block_size);
+			const Vector3i dst_min = block_origin + src_box.position - voxel_box.position;
+
+			if (voxels->get_channel_compression(channel) == VoxelBuffer::COMPRESSION_UNIFORM) {
+				const float value = voxels->get_voxel_f(Vector3i(), channel);
+				fill_3d_region_zxy(out_values, voxel_box.size, dst_min, dst_min + src_box.size, value);
+				fill_3d_region_zxy(out_found, voxel_box.size, dst_min, dst_min + src_box.size, uint8_t(1));
+				return;
+			}
+
+			Span<const uint8_t> raw;
+			ZN_ASSERT_RETURN(voxels->get_channel_raw_read_only(channel, raw));
+
+			switch (voxels->get_channel_depth(channel)) {
+				case VoxelBuffer::DEPTH_8_BIT:
+					read_region_f(raw.reinterpret_cast_to<const int8_t>(), block_size, src_box, out_values,
+							out_found, voxel_box.size, dst_min, [](int8_t v) {
+								return s8_to_snorm(v) * constants::QUANTIZED_SDF_8_BITS_SCALE_INV;
+							});
+					break;
+				case VoxelBuffer::DEPTH_16_BIT:
+					read_region_f(raw.reinterpret_cast_to<const int16_t>(), block_size, src_box, out_values,
+							out_found, voxel_box.size, dst_min, [](int16_t v) {
+								return s16_to_snorm(v) * constants::QUANTIZED_SDF_16_BITS_SCALE_INV;
+							});
+					break;
+				case VoxelBuffer::DEPTH_32_BIT:
+					read_region_f(raw.reinterpret_cast_to<const float>(), block_size, src_box, out_values, out_found,
+							voxel_box.size, dst_min, [](float v) { return v; });
+					break;
+				case VoxelBuffer::DEPTH_64_BIT:
+					read_region_f(raw.reinterpret_cast_to<const double>(), block_size, src_box, out_values,
+							out_found, voxel_box.size, dst_min, [](double v) { return float(v); });
+					break;
+				default:
+					ZN_PRINT_ERROR("Unhandled depth");
+					break;
+			}
+		});
+	}
+
 	// D action(Vector3i pos, D value)
 	template <typename F>
 	void write_box(Box3i voxel_box, unsigned int channel, F action) {
@@ -196,6 +262,24 @@ private:
 		return _block_size;
 	}
 
+	template <typename TSrc, typename FConvert>
+	static void read_region_f(Span<const TSrc> src, Vector3i src_size, Box3i src_box, Span<float> dst,
+			Span<uint8_t> dst_found, Vector3i dst_size, Vector3i dst_min, FConvert convert) {
+		Vector3i pos;
+		for (pos.z = 0; pos.z < src_box.size.z; ++pos.z) {
+			for (pos.x = 0; pos.x < src_box.size.x; ++pos.x) {
+				unsigned int src_i = Vector3iUtil::get_zxy_index(src_box.position + pos, src_size);
+				unsigned int dst_i = Vector3iUtil::get_zxy_index(dst_min + pos, dst_size);
+				for (pos.y = 0; pos.y < src_box.size.y; ++pos.y) {
+					dst[dst_i] = convert(src[src_i]);
+					dst_found[dst_i] = 1;
+					++src_i;
+					++dst_i;
+				}
+			}
+		}
+	}
+
 	template <typename Block_F>
 	inline void _box_loop(Box3i voxel_box, Block_F block_action) {
 		Vector3i block_rpos;
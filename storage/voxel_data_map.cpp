@@ -221,7 +221,7 @@ void VoxelDataMap::copy(Vector3i min_pos, VoxelBuffer &dst_buffer, unsigned int
 											  .clipped(Box3i(min_pos, dst_buffer.get_size()));
 
 					// TODO Format?
-					VoxelBuffer temp(VoxelBuffer::ALLOCATOR_POOL);
+					VoxelBuffer temp(VoxelBuffer::ALLOCATOR_TEMP);
 					temp.create(box.size);
 					gen_func(callback_data, temp, box.position);
 
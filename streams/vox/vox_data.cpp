@@ -1,7 +1,9 @@
 #include "vox_data.h"
 #include "../../util/containers/std_unordered_set.h"
+#include "../../util/errors.h"
 #include "../../util/godot/classes/file_access.h"
 #include "../../util/godot/core/array.h"
+#include "../../util/hash_funcs.h"
 #include "../../util/io/log.h"
 #include "../../util/profiling.h"
 #include "../../util/string/format.h"
@@ -606,4 +608,60 @@ const Material &Data::get_material_by_id(int id) const {
 	return *material;
 }
 
+namespace {
+
+uint32_t get_model_hash(const Model &model) {
+	uint32_t h = hash_murmur3_one_32(model.size.x);
+	h = hash_murmur3_one_32(model.size.y, h);
+	h = hash_murmur3_one_32(model.size.z, h);
+	const uint8_t *data = model.color_indexes.data();
+	const size_t size = model.color_indexes.size();
+	size_t i = 0;
+	for (; i + 4 <= size; i += 4) {
+		h = hash_murmur3_one_32(data[i] | (data[i + 1] << 8) | (data[i + 2] << 16) | (data[i + 3] << 24), h);
+	}
+	for (; i < size; ++i) {
+		h = hash_murmur3_one_32(data[i], h);
+	}
+	return hash_fmix32(h);
+}
+
+bool is_same_model(const Model &a, const Model &b) {
+	return a.size == b.size && a.color_indexes == b.color_indexes;
+}
+
+} // namespace
+
+void find_unique_models(Span<const Model *const> models, StdVector<unsigned int> &out_model_to_unique) {
+	ZN_PROFILE_SCOPE();
+	out_model_to_unique.resize(models.size());
+	StdUnorderedMap<uint32_t, StdVector<unsigned int>> models_by_hash;
+
+	for (unsigned int model_index = 0; model_index < models.size(); ++model_index) {
+		ZN_ASSERT(models[model_index] != nullptr);
+		const Model &model = *models[model_index];
+		StdVector<unsigned int> &candidates = models_by_hash[get_model_hash(model)];
+
+		out_model_to_unique[model_index] = model_index;
+		for (const unsigned int candidate_index : candidates) {
+			if (is_same_model(*models[candidate_index], model)) {
+				out_model_to_unique[model_index] = candidate_index;
+				break;
+			}
+		}
+		if (out_model_to_unique[model_index] == model_index) {
+			candidates.push_back(model_index);
+		}
+	}
+}
+
+void find_unique_models(const Data &data, StdVector<unsigned int> &out_model_to_unique) {
+	StdVector<const Model *> models;
+	models.reserve(data.get_model_count());
+	for (unsigned int model_index = 0; model_index < data.get_model_count(); ++model_index) {
+		models.push_back(&data.get_model(model_index));
+	}
+	find_unique_models(to_span_const(models), out_model_to_unique);
+}
+
 } // namespace zylann::voxel::magica
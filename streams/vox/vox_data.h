@@ -2,6 +2,7 @@
 #define VOX_DATA_H
 
 #include "../../util/containers/fixed_array.h"
+#include "../../util/containers/span.h"
 #include "../../util/containers/std_unordered_map.h"
 #include "../../util/containers/std_vector.h"
 #include "../../util/godot/core/string.h"
@@ -131,6 +132,12 @@ private:
 	FixedArray<Color8, 256> _palette;
 };
 
+// Finds models with identical contents, so they can be processed only once.
+// For each model, gives the index of the first model having the same contents. Models for which that index is their
+// own are unique.
+void find_unique_models(Span<const Model *const> models, StdVector<unsigned int> &out_model_to_unique);
+void find_unique_models(const Data &data, StdVector<unsigned int> &out_model_to_unique);
+
 } // namespace zylann::voxel::magica
 
 #endif // VOX_DATA_H
@@ -2,7 +2,9 @@
 #include "../../meshers/cubes/voxel_color_palette.h"
 #include "../../storage/voxel_buffer_gd.h"
 #include "../../util/dstack.h"
+#include "../voxel_stream.h"
 #include "vox_data.h"
+#include "vox_scene_to_stream.h"
 
 namespace zylann::voxel {
 
@@ -75,9 +77,37 @@ int /*Error*/ VoxelVoxLoader::load_from_file(String fpath, Ref<godot::VoxelBuffe
 	return load_err;
 }
 
+int /*Error*/ VoxelVoxLoader::load_scene_to_stream(String fpath, Ref<VoxelStream> stream,
+		Ref<VoxelColorPalette> palette, godot::VoxelBuffer::ChannelId dst_channel, int lod_count) {
+	ZN_DSTACK();
+	ERR_FAIL_INDEX_V(dst_channel, godot::VoxelBuffer::MAX_CHANNELS, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(stream.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(lod_count < 1, ERR_INVALID_PARAMETER);
+
+	zylann::voxel::magica::Data data;
+	const Error load_err = data.load_from_file(fpath);
+	ERR_FAIL_COND_V(load_err != OK, load_err);
+
+	if (palette.is_valid()) {
+		Span<const Color8> src_palette = to_span_const(data.get_palette());
+		for (size_t i = 0; i < src_palette.size(); ++i) {
+			palette->set_color8(i, src_palette[i]);
+		}
+	}
+
+	magica::SceneToStreamParams params;
+	params.channel = dst_channel;
+	params.raw_colors = palette.is_null();
+	params.lod_count = lod_count;
+
+	return magica::convert_scene_to_stream(data, **stream, params);
+}
+
 void VoxelVoxLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_from_file", "fpath", "voxels", "palette", "dst_channel"),
 			&VoxelVoxLoader::load_from_file, DEFVAL(godot::VoxelBuffer::CHANNEL_COLOR));
+	ClassDB::bind_method(D_METHOD("load_scene_to_stream", "fpath", "stream", "palette", "dst_channel", "lod_count"),
+			&VoxelVoxLoader::load_scene_to_stream, DEFVAL(godot::VoxelBuffer::CHANNEL_COLOR), DEFVAL(1));
 }
 
 } // namespace zylann::voxel
@@ -7,6 +7,7 @@
 namespace zylann::voxel {
 
 class VoxelColorPalette;
+class VoxelStream;
 
 // Simple loader for MagicaVoxel
 class VoxelVoxLoader : public RefCounted {
@@ -16,6 +17,8 @@ public:
 	// TODO GDX: Can't bind functions returning a `godot::Error` enum
 	int /*Error*/ load_from_file(String fpath, Ref<godot::VoxelBuffer> p_voxels, Ref<VoxelColorPalette> palette,
 			godot::VoxelBuffer::ChannelId dst_channel);
+	int /*Error*/ load_scene_to_stream(String fpath, Ref<VoxelStream> stream, Ref<VoxelColorPalette> palette,
+			godot::VoxelBuffer::ChannelId dst_channel, int lod_count);
 	// TODO Have chunked loading for better memory usage
 	// TODO Saving
 
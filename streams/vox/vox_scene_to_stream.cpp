@@ -0,0 +1,346 @@
+#include "vox_scene_to_stream.h"
+#include "../../storage/voxel_buffer.h"
+#include "../../util/containers/container_funcs.h"
+#include "../../util/containers/std_unordered_map.h"
+#include "../../util/errors.h"
+#include "../../util/io/log.h"
+#include "../../util/math/box3i.h"
+#include "../../util/profiling.h"
+#include "../../util/string/format.h"
+#include "../../util/tasks/threaded_task_runner.h"
+#include "../../util/thread/thread.h"
+#include "../voxel_stream.h"
+
+namespace zylann::voxel::magica {
+
+namespace {
+
+// Rotations in MagicaVoxel scenes are only made of axis permutations and flips, so they can be applied exactly with
+// integers
+struct IntBasis {
+	FixedArray<Vector3i, 3> rows;
+
+	static IntBasis from_basis(const Basis &b) {
+		IntBasis ib;
+		for (unsigned int i = 0; i < 3; ++i) {
+			const Vector3 row = b.rows[i];
+			ib.rows[i] = Vector3i(static_cast<int>(Math::round(row.x)), static_cast<int>(Math::round(row.y)),
+					static_cast<int>(Math::round(row.z)));
+		}
+		return ib;
+	}
+
+	static IntBasis identity() {
+		IntBasis ib;
+		ib.rows[0] = Vector3i(1, 0, 0);
+		ib.rows[1] = Vector3i(0, 1, 0);
+		ib.rows[2] = Vector3i(0, 0, 1);
+		return ib;
+	}
+
+	inline Vector3i xform(const Vector3i v) const {
+		return Vector3i(rows[0].x * v.x + rows[0].y * v.y + rows[0].z * v.z,
+				rows[1].x * v.x + rows[1].y * v.y + rows[1].z * v.z,
+				rows[2].x * v.x + rows[2].y * v.y + rows[2].z * v.z);
+	}
+
+	inline Vector3i get_column(unsigned int i) const {
+		return Vector3i(rows[0][i], rows[1][i], rows[2][i]);
+	}
+
+	IntBasis transposed() const {
+		IntBasis ib;
+		for (unsigned int i = 0; i < 3; ++i) {
+			ib.rows[i] = get_column(i);
+		}
+		return ib;
+	}
+
+	IntBasis operator*(const IntBasis &other) const {
+		IntBasis ib;
+		for (unsigned int i = 0; i < 3; ++i) {
+			ib.rows[i] = other.transposed().xform(rows[i]);
+		}
+		return ib;
+	}
+};
+
+// A model placed in the scene.
+// In MagicaVoxel, models are rotated around their center `h = size / 2`, then translated by `t`. A model voxel `p`
+// ends up at world voxel `w`, where `2w + 1 = B * (2p + 1 - 2h) + 2t`. Using doubled coordinates keeps everything
+// exact with integers, because rotations swap and flip voxel centers.
+struct ModelInstance {
+	const Model *model;
+	IntBasis inverse_basis;
+	Vector3i origin2; // 2t - 1
+	Vector3i half_size2; // 2h - 1
+	Box3i box;
+
+	inline Vector3i world_to_model(const Vector3i w) const {
+		return (inverse_basis.xform(w * 2 - origin2) + half_size2) >> 1;
+	}
+};
+
+ModelInstance make_instance(const Model &model, const IntBasis &basis, const Vector3i translation) {
+	ModelInstance instance;
+	instance.model = &model;
+	instance.inverse_basis = basis.transposed();
+	instance.origin2 = translation * 2 - Vector3i(1, 1, 1);
+	instance.half_size2 = (model.size / 2) * 2 - Vector3i(1, 1, 1);
+
+	// Corners of the model, from the center of their voxels
+	const Vector3i w0 = (basis.xform(-instance.half_size2) + instance.origin2) >> 1;
+	const Vector3i w1 =
+			(basis.xform((model.size - Vector3i(1, 1, 1)) * 2 - instance.half_size2) + instance.origin2) >> 1;
+	instance.box = Box3i::from_min_max(math::min(w0, w1), math::max(w0, w1) + Vector3i(1, 1, 1));
+
+	return instance;
+}
+
+Error gather_instances_recursively(const Data &data, int node_id, const IntBasis &parent_basis,
+		const Vector3i parent_translation, int depth, StdVector<ModelInstance> &instances) {
+	// Same limit as when importing scenes
+	ERR_FAIL_COND_V(depth > 10, ERR_INVALID_DATA);
+	const Node *vox_node = data.get_node(node_id);
+
+	switch (vox_node->type) {
+		case Node::TYPE_TRANSFORM: {
+			const TransformNode *vox_transform_node = reinterpret_cast<const TransformNode *>(vox_node);
+			const IntBasis basis = parent_basis * IntBasis::from_basis(vox_transform_node->rotation.basis);
+			const Vector3i translation = parent_basis.xform(vox_transform_node->position) + parent_translation;
+			return gather_instances_recursively(
+					data, vox_transform_node->child_node_id, basis, translation, depth + 1, instances);
+		}
+
+		case Node::TYPE_GROUP: {
+			const GroupNode *vox_group_node = reinterpret_cast<const GroupNode *>(vox_node);
+			for (const int child_node_id : vox_group_node->child_node_ids) {
+				const Error err = gather_instances_recursively(
+						data, child_node_id, parent_basis, parent_translation, depth + 1, instances);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+		} break;
+
+		case Node::TYPE_SHAPE: {
+			const ShapeNode *vox_shape_node = reinterpret_cast<const ShapeNode *>(vox_node);
+			const Model &model = data.get_model(vox_shape_node->model_id);
+			instances.push_back(make_instance(model, parent_basis, parent_translation));
+		} break;
+
+		default:
+			ERR_FAIL_V(ERR_INVALID_DATA);
+			break;
+	}
+
+	return OK;
+}
+
+struct ConversionContext {
+	const Data &data;
+	VoxelStream &stream;
+	const SceneToStreamParams &params;
+	const StdVector<ModelInstance> &instances;
+	unsigned int block_size;
+	unsigned int lod_index;
+};
+
+struct BlockItem {
+	Vector3i position;
+	// Range in the list of instance indices
+	unsigned int instances_begin;
+	unsigned int instances_count;
+};
+
+// Returns false if no voxel was written
+bool convert_block(const ConversionContext &ctx, Vector3i block_position, Span<const uint32_t> instance_indices,
+		VoxelBuffer &voxels) {
+	const unsigned int channel = ctx.params.channel;
+	const unsigned int lod_index = ctx.lod_index;
+	const Vector3i block_size = Vector3iUtil::create(ctx.block_size);
+	// Origin of the block in LOD0 voxels
+	const Vector3i block_origin = (block_position * static_cast<int>(ctx.block_size)) << lod_index;
+	const FixedArray<Color8, 256> &palette = ctx.data.get_palette();
+
+	Span<uint8_t> dst8;
+	Span<uint16_t> dst16;
+	bool empty = true;
+
+	for (const uint32_t instance_index : instance_indices) {
+		const ModelInstance &instance = ctx.instances[instance_index];
+		const Model &model = *instance.model;
+
+		// Area of the block covered by the instance, in voxels of the block. Nearest-neighbor downscaling uses the
+		// lowest corner of each voxel, like `VoxelBuffer::downscale_to`.
+		const Box3i local_box = Box3i::from_min_max(
+				math::ceildiv(instance.box.position - block_origin, 1 << lod_index),
+				math::ceildiv(instance.box.position + instance.box.size - block_origin, 1 << lod_index))
+										.clipped(block_size);
+		if (local_box.is_empty()) {
+			continue;
+		}
+
+		// Stepping along Y in the block moves along a fixed axis in the model
+		const Vector3i model_step_y = instance.inverse_basis.get_column(1) * (1 << lod_index);
+
+		const Vector3i local_min = local_box.position;
+		const Vector3i local_max = local_box.position + local_box.size;
+
+		Vector3i local_pos;
+		for (local_pos.z = local_min.z; local_pos.z < local_max.z; ++local_pos.z) {
+			for (local_pos.x = local_min.x; local_pos.x < local_max.x; ++local_pos.x) {
+				local_pos.y = local_min.y;
+				Vector3i model_pos = instance.world_to_model(block_origin + (local_pos << lod_index));
+				unsigned int dst_index = Vector3iUtil::get_zxy_index(local_pos, block_size);
+
+				for (; local_pos.y < local_max.y; ++local_pos.y) {
+#ifdef DEBUG_ENABLED
+					ZN_ASSERT(Box3i(Vector3i(), model.size).contains(model_pos));
+#endif
+					const uint8_t color_index = model.color_indexes[Vector3iUtil::get_zxy_index(model_pos, model.size)];
+
+					if (color_index != 0) {
+						if (empty) {
+							voxels.decompress_channel(channel);
+							Span<uint8_t> raw;
+							ZN_ASSERT(voxels.get_channel_raw(channel, raw));
+							if (ctx.params.raw_colors) {
+								dst16 = raw.reinterpret_cast_to<uint16_t>();
+							} else {
+								dst8 = raw;
+							}
+							empty = false;
+						}
+						if (ctx.params.raw_colors) {
+							dst16[dst_index] = palette[color_index].to_u16();
+						} else {
+							dst8[dst_index] = color_index;
+						}
+					}
+
+					model_pos += model_step_y;
+					++dst_index;
+				}
+			}
+		}
+	}
+
+	return !empty;
+}
+
+class ConvertBlocksTask : public IThreadedTask {
+public:
+	ConvertBlocksTask(
+			const ConversionContext &ctx, Span<const BlockItem> blocks, Span<const uint32_t> instance_indices) :
+			_ctx(ctx), _blocks(blocks), _instance_indices(instance_indices) {}
+
+	void run(ThreadedTaskContext &task_context) override {
+		ZN_PROFILE_SCOPE();
+
+		StdVector<UniquePtr<VoxelBuffer>> buffers;
+		StdVector<VoxelStream::VoxelQueryData> queries;
+
+		const VoxelBuffer::Depth depth = _ctx.params.raw_colors ? VoxelBuffer::DEPTH_16_BIT : VoxelBuffer::DEPTH_8_BIT;
+
+		for (const BlockItem &item : _blocks) {
+			UniquePtr<VoxelBuffer> voxels = make_unique_instance<VoxelBuffer>(VoxelBuffer::ALLOCATOR_POOL);
+			voxels->set_channel_depth(_ctx.params.channel, depth);
+			voxels->create(Vector3iUtil::create(_ctx.block_size));
+
+			if (convert_block(_ctx, item.position,
+						_instance_indices.sub(item.instances_begin, item.instances_count), *voxels)) {
+				queries.push_back(VoxelStream::VoxelQueryData{
+						*voxels, item.position, static_cast<uint8_t>(_ctx.lod_index), VoxelStream::RESULT_ERROR });
+				buffers.push_back(std::move(voxels));
+			}
+		}
+
+		if (queries.size() > 0) {
+			_ctx.stream.save_voxel_blocks(to_span(queries));
+		}
+	}
+
+	const char *get_debug_name() const override {
+		return "ConvertVoxSceneBlocks";
+	}
+
+private:
+	const ConversionContext &_ctx;
+	Span<const BlockItem> _blocks;
+	Span<const uint32_t> _instance_indices;
+};
+
+} // namespace
+
+Error convert_scene_to_stream(const Data &data, VoxelStream &stream, const SceneToStreamParams &params) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT_RETURN_V(params.channel < VoxelBuffer::MAX_CHANNELS, ERR_INVALID_PARAMETER);
+	ZN_ASSERT_RETURN_V(params.lod_count >= 1, ERR_INVALID_PARAMETER);
+	ZN_ASSERT_RETURN_V(params.batch_size >= 1, ERR_INVALID_PARAMETER);
+	ZN_ASSERT_RETURN_V_MSG(static_cast<int>(params.lod_count) <= stream.get_lod_count(), ERR_INVALID_PARAMETER,
+			format("The stream supports {} LODs at most", stream.get_lod_count()));
+
+	StdVector<ModelInstance> instances;
+
+	if (data.get_root_node_id() != -1) {
+		const Error err = gather_instances_recursively(
+				data, data.get_root_node_id(), IntBasis::identity(), Vector3i(), 0, instances);
+		ERR_FAIL_COND_V(err != OK, err);
+
+	} else if (data.get_model_count() > 0) {
+		// Some vox files don't have a scene graph. Place the model with its lower corner at the origin.
+		const Model &model = data.get_model(0);
+		instances.push_back(make_instance(model, IntBasis::identity(), model.size / 2));
+	}
+
+	const unsigned int block_size = 1 << stream.get_block_size_po2();
+
+	ThreadedTaskRunner runner;
+	runner.set_name("VoxSceneConversion");
+	runner.set_thread_count(params.thread_count != 0 ? params.thread_count : Thread::get_hardware_concurrency());
+
+	for (unsigned int lod_index = 0; lod_index < params.lod_count; ++lod_index) {
+		ZN_PROFILE_SCOPE_NAMED("LOD");
+
+		// Find which blocks each instance overlaps
+		StdUnorderedMap<Vector3i, StdVector<uint32_t>> block_to_instances;
+		for (unsigned int instance_index = 0; instance_index < instances.size(); ++instance_index) {
+			const Box3i blocks_box = instances[instance_index].box.downscaled(block_size << lod_index);
+			blocks_box.for_each_cell_zxy([&block_to_instances, instance_index](Vector3i bpos) {
+				block_to_instances[bpos].push_back(instance_index);
+			});
+		}
+
+		StdVector<BlockItem> blocks;
+		StdVector<uint32_t> instance_indices;
+		blocks.reserve(block_to_instances.size());
+		for (auto it = block_to_instances.begin(); it != block_to_instances.end(); ++it) {
+			blocks.push_back(BlockItem{ it->first, static_cast<unsigned int>(instance_indices.size()),
+					static_cast<unsigned int>(it->second.size()) });
+			append_array(instance_indices, it->second);
+		}
+		block_to_instances.clear();
+
+		ZN_PRINT_VERBOSE(format("Converting {} blocks of .vox scene at LOD {}", blocks.size(), lod_index));
+
+		const ConversionContext ctx{ data, stream, params, instances, block_size, lod_index };
+
+		StdVector<IThreadedTask *> tasks;
+		for (unsigned int begin = 0; begin < blocks.size(); begin += params.batch_size) {
+			const unsigned int count = math::min(params.batch_size, static_cast<unsigned int>(blocks.size()) - begin);
+			tasks.push_back(ZN_NEW(ConvertBlocksTask(ctx, to_span_const(blocks).sub(begin, count),
+					to_span_const(instance_indices))));
+		}
+
+		runner.enqueue(to_span(tasks), false);
+		runner.wait_for_all_tasks();
+		runner.dequeue_completed_tasks([](IThreadedTask *task) { //
+			ZN_DELETE(task);
+		});
+	}
+
+	stream.flush();
+
+	return OK;
+}
+
+} // namespace zylann::voxel::magica
@@ -0,0 +1,33 @@
+#ifndef VOX_SCENE_TO_STREAM_H
+#define VOX_SCENE_TO_STREAM_H
+
+#include "vox_data.h"
+
+namespace zylann::voxel {
+
+class VoxelStream;
+
+namespace magica {
+
+struct SceneToStreamParams {
+	// Channel in which voxels will be written
+	unsigned int channel;
+	// If true, palette colors are written as 16-bit packed colors. Otherwise, 8-bit palette indices are written.
+	bool raw_colors = false;
+	// How many LODs to write. LODs are downscaled with nearest-neighbor sampling.
+	unsigned int lod_count = 1;
+	// Blocks are converted in parallel, in batches of this size. Only `batch_size` blocks per thread are kept in
+	// memory at once.
+	unsigned int batch_size = 32;
+	unsigned int thread_count = 0; // 0 means hardware concurrency
+};
+
+// Writes all models of a MagicaVoxel scene into voxel blocks of a stream, placed and rotated the same way as they are
+// in the scene graph. Unlike importing the scene as meshes, the result can be streamed and LOD-ed by a terrain.
+// Blocks entirely empty are not written.
+Error convert_scene_to_stream(const Data &data, VoxelStream &stream, const SceneToStreamParams &params);
+
+} // namespace magica
+} // namespace zylann::voxel
+
+#endif // VOX_SCENE_TO_STREAM_H
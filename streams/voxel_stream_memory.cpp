@@ -1,38 +1,65 @@
 #include "voxel_stream_memory.h"
 #include "../storage/voxel_buffer.h"
 #include "../util/containers/std_unordered_map.h"
+#include "../util/io/log.h"
+#include "../util/profiling.h"
+#include "../util/string/format.h"
 #include "../util/thread/thread.h"
 #include "instance_data.h"
+#include "voxel_block_serializer.h"
 
 namespace zylann::voxel {
 
 void VoxelStreamMemory::load_voxel_blocks(Span<VoxelQueryData> p_blocks) {
+	ZN_PROFILE_SCOPE();
+
+	StdVector<uint8_t> compressed_data;
+
 	for (VoxelQueryData &q : p_blocks) {
-		Lod &lod = _lods[q.lod_index];
+		Shard &shard = get_shard(q.lod_index, q.position_in_blocks);
 
-		MutexLock mlock(lod.mutex);
-		auto it = lod.voxel_blocks.find(q.position_in_blocks);
+		// Only copy under the lock, decompressing is the most expensive part
+		bool found = false;
+		{
+			MutexLock mlock(shard.mutex);
+			auto it = shard.voxel_blocks.find(q.position_in_blocks);
+			if (it != shard.voxel_blocks.end()) {
+				compressed_data = it->second;
+				found = true;
+			}
+		}
 
-		if (it == lod.voxel_blocks.end()) {
+		if (!found) {
 			q.result = VoxelStream::RESULT_BLOCK_NOT_FOUND;
 
-		} else {
+		} else if (BlockSerializer::decompress_and_deserialize(to_span_const(compressed_data), q.voxel_buffer)) {
 			q.result = VoxelStream::RESULT_BLOCK_FOUND;
-			it->second.voxels.copy_to(q.voxel_buffer, true);
+
+		} else {
+			ZN_PRINT_ERROR(format("Failed to deserialize block {} lod {}", q.position_in_blocks, int(q.lod_index)));
+			q.result = VoxelStream::RESULT_ERROR;
 		}
 	}
 }
 
 void VoxelStreamMemory::save_voxel_blocks(Span<VoxelQueryData> p_blocks) {
+	ZN_PROFILE_SCOPE();
+
 	for (const VoxelQueryData &q : p_blocks) {
 		if (_artificial_save_latency_usec > 0) {
 			Thread::sleep_usec(_artificial_save_latency_usec);
 		}
-		Lod &lod = _lods[q.lod_index];
+
+		// Compress before locking, it is the most expensive part
+		BlockSerializer::SerializeResult res = BlockSerializer::serialize_and_compress(q.voxel_buffer);
+		ERR_CONTINUE(!res.success);
+		StdVector<uint8_t> data = res.data;
+
+		Shard &shard = get_shard(q.lod_index, q.position_in_blocks);
 		{
-			MutexLock mlock(lod.mutex);
-			VoxelChunk &dst = lod.voxel_blocks[q.position_in_blocks];
-			q.voxel_buffer.copy_to(dst.voxels, true);
+			MutexLock mlock(shard.mutex);
+			// Swap so the previous data gets freed outside of the lock
+			shard.voxel_blocks[q.position_in_blocks].swap(data);
 		}
 	}
 }
@@ -51,12 +78,12 @@ bool VoxelStreamMemory::supports_instance_blocks() const {
 
 void VoxelStreamMemory::load_instance_blocks(Span<InstancesQueryData> out_blocks) {
 	for (InstancesQueryData &q : out_blocks) {
-		Lod &lod = _lods[q.lod_index];
+		Shard &shard = get_shard(q.lod_index, q.position_in_blocks);
 
-		MutexLock mlock(lod.mutex);
-		auto it = lod.instance_blocks.find(q.position_in_blocks);
+		MutexLock mlock(shard.mutex);
+		auto it = shard.instance_blocks.find(q.position_in_blocks);
 
-		if (it == lod.instance_blocks.end()) {
+		if (it == shard.instance_blocks.end()) {
 			q.result = VoxelStream::RESULT_BLOCK_NOT_FOUND;
 
 		} else {
@@ -69,13 +96,13 @@ void VoxelStreamMemory::load_instance_blocks(Span<InstancesQueryData> out_blocks
 
 void VoxelStreamMemory::save_instance_blocks(Span<InstancesQueryData> p_blocks) {
 	for (const InstancesQueryData &q : p_blocks) {
-		Lod &lod = _lods[q.lod_index];
-		MutexLock mlock(lod.mutex);
+		Shard &shard = get_shard(q.lod_index, q.position_in_blocks);
+		MutexLock mlock(shard.mutex);
 
 		if (q.data == nullptr) {
-			lod.instance_blocks.erase(q.position_in_blocks);
+			shard.instance_blocks.erase(q.position_in_blocks);
 		} else {
-			q.data->copy_to(lod.instance_blocks[q.position_in_blocks]);
+			q.data->copy_to(shard.instance_blocks[q.position_in_blocks]);
 		}
 	}
 }
@@ -85,48 +112,56 @@ bool VoxelStreamMemory::supports_loading_all_blocks() const {
 }
 
 void VoxelStreamMemory::load_all_blocks(FullLoadingResult &result) {
+	ZN_PROFILE_SCOPE();
+
 	// The return value couples instances and voxels, but our storage is decoupled, so it complicates things a bit
 	StdUnorderedMap<Vector3i, unsigned int> bpos_to_index;
 
 	for (unsigned int lod_index = 0; lod_index < _lods.size(); ++lod_index) {
-		const Lod &lod = _lods[lod_index];
-		bpos_to_index.clear();
+		// A given block position always belongs to the same shard, so shards can be processed separately
+		for (Shard &shard : _lods[lod_index].shards) {
+			bpos_to_index.clear();
 
-		MutexLock mlock(lod.mutex);
+			MutexLock mlock(shard.mutex);
 
-		for (auto it = lod.voxel_blocks.begin(); it != lod.voxel_blocks.end(); ++it) {
-			const Vector3i bpos = it->first;
-			const unsigned int index = result.blocks.size();
-			bpos_to_index.insert({ bpos, index });
-			result.blocks.resize(index + 1);
+			for (auto it = shard.voxel_blocks.begin(); it != shard.voxel_blocks.end(); ++it) {
+				const Vector3i bpos = it->first;
 
-			FullLoadingResult::Block &block = result.blocks[index];
-			block.position = bpos;
-			block.lod = lod_index;
+				std::shared_ptr<VoxelBuffer> voxels = make_shared_instance<VoxelBuffer>(VoxelBuffer::ALLOCATOR_POOL);
+				if (!BlockSerializer::decompress_and_deserialize(to_span_const(it->second), *voxels)) {
+					ZN_PRINT_ERROR(format("Failed to deserialize block {} lod {}", bpos, lod_index));
+					continue;
+				}
 
-			const VoxelChunk &src = it->second;
-			block.voxels = make_shared_instance<VoxelBuffer>(VoxelBuffer::ALLOCATOR_POOL);
-			src.voxels.copy_to(*block.voxels, true);
-		}
-
-		for (auto it = lod.instance_blocks.begin(); it != lod.instance_blocks.end(); ++it) {
-			const Vector3i bpos = it->first;
-			FullLoadingResult::Block *block = nullptr;
-			auto pos_it = bpos_to_index.find(bpos);
-			if (pos_it == bpos_to_index.end()) {
 				const unsigned int index = result.blocks.size();
+				bpos_to_index.insert({ bpos, index });
 				result.blocks.resize(index + 1);
-				block = &result.blocks.back();
-				block->position = bpos;
-				block->lod = lod_index;
-				// bpos_to_index.insert({ bpos, index });
-			} else {
-				const unsigned int index = pos_it->second;
-				block = &result.blocks[index];
+
+				FullLoadingResult::Block &block = result.blocks[index];
+				block.position = bpos;
+				block.lod = lod_index;
+				block.voxels = voxels;
 			}
 
-			block->instances_data = make_unique_instance<InstanceBlockData>();
-			it->second.copy_to(*block->instances_data);
+			for (auto it = shard.instance_blocks.begin(); it != shard.instance_blocks.end(); ++it) {
+				const Vector3i bpos = it->first;
+				FullLoadingResult::Block *block = nullptr;
+				auto pos_it = bpos_to_index.find(bpos);
+				if (pos_it == bpos_to_index.end()) {
+					const unsigned int index = result.blocks.size();
+					result.blocks.resize(index + 1);
+					block = &result.blocks.back();
+					block->position = bpos;
+					block->lod = lod_index;
+					// bpos_to_index.insert({ bpos, index });
+				} else {
+					const unsigned int index = pos_it->second;
+					block = &result.blocks[index];
+				}
+
+				block->instances_data = make_unique_instance<InstanceBlockData>();
+				it->second.copy_to(*block->instances_data);
+			}
 		}
 	}
 }
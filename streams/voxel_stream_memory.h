@@ -6,6 +6,8 @@
 #include "../util/containers/fixed_array.h"
 #include "../util/containers/span.h"
 #include "../util/containers/std_unordered_map.h"
+#include "../util/containers/std_vector.h"
+#include "../util/hash_funcs.h"
 #include "../util/math/vector3i.h"
 #include "../util/memory/memory.h"
 #include "../util/thread/mutex.h"
@@ -15,7 +17,8 @@
 namespace zylann::voxel {
 
 // "fake" stream that just stores copies of the data in memory instead of saving them to the filesystem. May be used for
-// testing.
+// testing, or as a RAM-resident save.
+// Voxel blocks are stored serialized and compressed, the same way they would be in a file.
 class VoxelStreamMemory : public VoxelStream {
 	GDCLASS(VoxelStreamMemory, VoxelStream)
 public:
@@ -41,17 +44,29 @@ public:
 private:
 	static void _bind_methods();
 
-	struct VoxelChunk {
-		VoxelBuffer voxels;
-		VoxelChunk() : voxels(VoxelBuffer::ALLOCATOR_POOL) {}
-	};
+	// Blocks are spread over several maps with their own lock, so threads accessing different blocks rarely wait on
+	// each other
+	static const unsigned int SHARD_COUNT = 16;
 
-	struct Lod {
-		StdUnorderedMap<Vector3i, VoxelChunk> voxel_blocks;
+	struct Shard {
+		// Serialized and compressed voxels
+		StdUnorderedMap<Vector3i, StdVector<uint8_t>> voxel_blocks;
 		StdUnorderedMap<Vector3i, InstanceBlockData> instance_blocks;
 		Mutex mutex;
 	};
 
+	struct Lod {
+		FixedArray<Shard, SHARD_COUNT> shards;
+	};
+
+	static inline unsigned int get_shard_index(Vector3i bpos) {
+		return hash_fmix32(Vector3iHasher::hash(bpos)) % SHARD_COUNT;
+	}
+
+	Shard &get_shard(unsigned int lod_index, Vector3i bpos) {
+		return _lods[lod_index].shards[get_shard_index(bpos)];
+	}
+
 	FixedArray<Lod, constants::MAX_LOD> _lods;
 	unsigned int _artificial_save_latency_usec = 0;
 };
@@ -2,6 +2,7 @@
 #define VOXEL_MESH_BLOCK_VT_H
 
 #include "../../util/godot/classes/material.h"
+#include "../../util/tasks/cancellation_token.h"
 #include "../voxel_mesh_block.h"
 
 namespace zylann::voxel {
@@ -26,6 +27,12 @@ public:
 	// collision, it may be a better idea to use `is_area_editable` and not use mesh blocks
 	bool is_loaded = false;
 
+	// Cancels meshing tasks scheduled for this block, in case they are still pending or running when it is no longer
+	// needed
+	TaskCancellationToken mesh_task_cancellation_token;
+	// Prevents the last meshing task scheduled for this block from starting, when a newer one replaces it
+	TaskCancellationToken mesh_task_start_cancellation_token;
+
 	VoxelMeshBlockVT(const Vector3i bpos, unsigned int size) : VoxelMeshBlock(bpos) {
 		_position_in_voxels = bpos * size;
 	}
@@ -34,6 +34,8 @@
 #include "../voxel_save_completion_tracker.h"
 #include "voxel_terrain_multiplayer_synchronizer.h"
 
+#include <algorithm>
+
 #ifdef TOOLS_ENABLED
 #include "../../meshers/transvoxel/voxel_mesher_transvoxel.h"
 #endif
@@ -101,6 +103,10 @@ VoxelTerrain::~VoxelTerrain() {
 	ZN_PRINT_VERBOSE("Destroying VoxelTerrain");
 	_streaming_dependency->valid = false;
 	_meshing_dependency->valid = false;
+	Ref<VoxelGenerator> generator = get_generator();
+	if (generator.is_valid()) {
+		generator->get_block_cache().unregister_user(_volume_id);
+	}
 	VoxelEngine::get_singleton().remove_volume(_volume_id);
 }
 
@@ -164,8 +170,12 @@ void VoxelTerrain::set_generator(Ref<VoxelGenerator> p_generator) {
 	Ref<VoxelGenerator> prev_generator = get_generator();
 	if (prev_generator.is_valid()) {
 		prev_generator->clear_cache();
-		// TODO if we were to share this generator on multiple terrains, cache should not be entirely cleared. Instead,
-		// we should just remove the area from all paired viewers.
+		// TODO if we were to share this generator on multiple terrains, its internal cache should not be entirely
+		// cleared. Instead, we should just remove the area from all paired viewers.
+		prev_generator->get_block_cache().unregister_user(_volume_id);
+	}
+	if (p_generator.is_valid()) {
+		p_generator->get_block_cache().register_user(_volume_id);
 	}
 
 	_data->set_generator(p_generator);
@@ -504,13 +514,17 @@ void VoxelTerrain::unload_mesh_block(Vector3i bpos) {
 	StdVector<Vector3i> &blocks_pending_update = _blocks_pending_update;
 
 	bool was_loaded = false;
-	_mesh_map.remove_block(bpos, [&blocks_pending_update, &was_loaded](const VoxelMeshBlockVT &block) {
+	_mesh_map.remove_block(bpos, [&blocks_pending_update, &was_loaded](VoxelMeshBlockVT &block) {
 		if (block.is_in_update_list) {
 			// That block was in the list of blocks to update later in the process loop, we'll need to unregister
 			// it. We expect that block to be in that list. If it isn't, something wrong happened with its state.
 			ERR_FAIL_COND(!unordered_remove_value(blocks_pending_update, block.position));
 		}
 		was_loaded = block.is_loaded;
+		if (block.mesh_task_cancellation_token.is_valid()) {
+			// The mesh is no longer needed, stop meshing it if it's still in progress
+			block.mesh_task_cancellation_token.cancel();
+		}
 	});
 
 	if (_instancer != nullptr) {
@@ -713,6 +727,12 @@ void VoxelTerrain::clear_mesh_map() {
 		});
 	}
 
+	_mesh_map.for_each_block([](VoxelMeshBlockVT &block) {
+		if (block.mesh_task_cancellation_token.is_valid()) {
+			block.mesh_task_cancellation_token.cancel();
+		}
+	});
+
 	_mesh_map.clear();
 }
 
@@ -730,6 +750,11 @@ void VoxelTerrain::reset_map() {
 	_blocks_pending_load.clear();
 	_blocks_pending_update.clear();
 	_blocks_to_save.clear();
+	_loaded_data_blocks_pending_meshing.clear();
+	// Edits are discarded along with the voxels they affected. The transaction depth is kept, because the caller
+	// still has to end transactions it began.
+	_pending_edited_areas.clear();
+	_pending_edited_areas_without_mesh_update.clear();
 
 	// No need to care about refcounts, we drop everything anyways. Will pair it back on next process.
 	_paired_viewers.clear();
@@ -737,6 +762,7 @@ void VoxelTerrain::reset_map() {
 	Ref<VoxelGenerator> generator = get_generator();
 	if (generator.is_valid()) {
 		generator->clear_cache();
+		generator->get_block_cache().clear();
 	}
 }
 
@@ -762,7 +788,184 @@ void VoxelTerrain::try_schedule_mesh_update_from_data(const Box3i &box_in_voxels
 	});
 }
 
+void VoxelTerrain::schedule_mesh_updates_from_loaded_data_blocks() {
+	ZN_PROFILE_SCOPE();
+
+	if (_loaded_data_blocks_pending_meshing.size() == 0) {
+		return;
+	}
+	if (_mesher.is_null()) {
+		// No mesher, can't do updates
+		_loaded_data_blocks_pending_meshing.clear();
+		return;
+	}
+
+	const int data_block_size = get_data_block_size();
+	const int mesh_block_size = get_mesh_block_size();
+	const int render_to_data_factor = mesh_block_size / data_block_size;
+
+	// Gather mesh blocks around loaded blocks. Most of them are shared when lots of blocks are loaded at once.
+	static thread_local StdVector<Vector3i> tls_mesh_positions;
+	tls_mesh_positions.clear();
+	for (const Vector3i data_bpos : _loaded_data_blocks_pending_meshing) {
+		// We pad by 1 because neighbor blocks might be affected visually (for example, baked ambient occlusion)
+		const Box3i mesh_box = Box3i(data_bpos * data_block_size, Vector3iUtil::create(data_block_size))
+									   .padded(1)
+									   .downscaled(mesh_block_size);
+		mesh_box.for_each_cell_zxy([](Vector3i mesh_bpos) { tls_mesh_positions.push_back(mesh_bpos); });
+	}
+	_loaded_data_blocks_pending_meshing.clear();
+
+	std::sort(tls_mesh_positions.begin(), tls_mesh_positions.end(), [](const Vector3i &a, const Vector3i &b) {
+		if (a.z != b.z) {
+			return a.z < b.z;
+		}
+		if (a.x != b.x) {
+			return a.x < b.x;
+		}
+		return a.y < b.y;
+	});
+	tls_mesh_positions.erase(
+			std::unique(tls_mesh_positions.begin(), tls_mesh_positions.end()), tls_mesh_positions.end());
+
+	// Keep only blocks that could be scheduled
+	static thread_local StdVector<VoxelMeshBlockVT *> tls_mesh_blocks;
+	tls_mesh_blocks.clear();
+	Box3i data_bounds;
+	for (const Vector3i mesh_bpos : tls_mesh_positions) {
+		VoxelMeshBlockVT *mesh_block = _mesh_map.get_block(mesh_bpos);
+		if (mesh_block == nullptr || mesh_block->is_in_update_list ||
+				(mesh_block->mesh_viewers.get() == 0 && mesh_block->collision_viewers.get() == 0)) {
+			continue;
+		}
+		const Box3i data_box =
+				Box3i(mesh_bpos * render_to_data_factor, Vector3iUtil::create(render_to_data_factor)).padded(1);
+		data_bounds = tls_mesh_blocks.size() == 0 ? data_box : Box3i::get_bounding_box(data_bounds, data_box);
+		tls_mesh_blocks.push_back(mesh_block);
+	}
+
+	if (tls_mesh_blocks.size() == 0) {
+		return;
+	}
+
+	const int neighborhood_size = render_to_data_factor + 2;
+	const int64_t neighborhood_volume = Vector3iUtil::get_volume(Vector3iUtil::create(neighborhood_size));
+
+	const int64_t max_checked_volume = static_cast<int64_t>(tls_mesh_blocks.size()) * neighborhood_volume;
+	if (Vector3iUtil::get_volume(data_bounds.size) > max_checked_volume) {
+		// Blocks are scattered (viewers far apart?), it's cheaper to check them individually
+		for (VoxelMeshBlockVT *mesh_block : tls_mesh_blocks) {
+			try_schedule_mesh_update(*mesh_block);
+		}
+		return;
+	}
+
+	// Count present data blocks with a summed volume table, so checking if all neighbors of a mesh block are present
+	// takes constant time, and every data block is queried only once. The table has a border of zeroes at its lower
+	// sides.
+	const Vector3i table_size = data_bounds.size + Vector3i(1, 1, 1);
+	static thread_local StdVector<uint32_t> tls_counts;
+	tls_counts.clear();
+	tls_counts.resize(Vector3iUtil::get_volume(table_size), 0);
+
+	const auto table_index = [table_size](int x, int y, int z) {
+		return Vector3iUtil::get_zxy_index(x, y, z, table_size.x, table_size.y);
+	};
+
+	for (int z = 1; z < table_size.z; ++z) {
+		for (int x = 1; x < table_size.x; ++x) {
+			for (int y = 1; y < table_size.y; ++y) {
+				tls_counts[table_index(x, y, z)] = 1;
+			}
+		}
+	}
+
+	static thread_local StdVector<Vector3i> tls_missing_blocks;
+	tls_missing_blocks.clear();
+	// Blocks outside of bounds are not reported, so they count as present like in `try_schedule_mesh_update`
+	_data->get_missing_blocks(data_bounds, 0, tls_missing_blocks);
+
+	for (const Vector3i missing_bpos : tls_missing_blocks) {
+		const Vector3i tpos = missing_bpos - data_bounds.position + Vector3i(1, 1, 1);
+		tls_counts[table_index(tpos.x, tpos.y, tpos.z)] = 0;
+	}
+
+	// Accumulate along each axis
+	for (int z = 1; z < table_size.z; ++z) {
+		for (int x = 1; x < table_size.x; ++x) {
+			for (int y = 1; y < table_size.y; ++y) {
+				tls_counts[table_index(x, y, z)] += tls_counts[table_index(x, y - 1, z)];
+			}
+		}
+	}
+	for (int z = 1; z < table_size.z; ++z) {
+		for (int x = 1; x < table_size.x; ++x) {
+			for (int y = 1; y < table_size.y; ++y) {
+				tls_counts[table_index(x, y, z)] += tls_counts[table_index(x - 1, y, z)];
+			}
+		}
+	}
+	for (int z = 1; z < table_size.z; ++z) {
+		for (int x = 1; x < table_size.x; ++x) {
+			for (int y = 1; y < table_size.y; ++y) {
+				tls_counts[table_index(x, y, z)] += tls_counts[table_index(x, y, z - 1)];
+			}
+		}
+	}
+
+	for (VoxelMeshBlockVT *mesh_block : tls_mesh_blocks) {
+		// Corners of the neighborhood in the table. Because of the border, the min corner is exclusive.
+		const Vector3i min_pos =
+				mesh_block->position * render_to_data_factor - Vector3i(1, 1, 1) - data_bounds.position;
+		const Vector3i max_pos = min_pos + Vector3iUtil::create(neighborhood_size);
+
+		const int64_t count = //
+				int64_t(tls_counts[table_index(max_pos.x, max_pos.y, max_pos.z)]) //
+				- tls_counts[table_index(min_pos.x, max_pos.y, max_pos.z)] //
+				- tls_counts[table_index(max_pos.x, min_pos.y, max_pos.z)] //
+				- tls_counts[table_index(max_pos.x, max_pos.y, min_pos.z)] //
+				+ tls_counts[table_index(min_pos.x, min_pos.y, max_pos.z)] //
+				+ tls_counts[table_index(min_pos.x, max_pos.y, min_pos.z)] //
+				+ tls_counts[table_index(max_pos.x, min_pos.y, min_pos.z)] //
+				- tls_counts[table_index(min_pos.x, min_pos.y, min_pos.z)];
+
+		if (count == neighborhood_volume) {
+			mesh_block->is_in_update_list = true;
+			_blocks_pending_update.push_back(mesh_block->position);
+		}
+	}
+}
+
+namespace {
+
+// Adds a box to a list, merging it with an existing box if they touch and merging doesn't cover too much space that
+// wasn't part of either box.
+void add_merged_box(StdVector<Box3i> &boxes, Box3i box) {
+	const int64_t volume = Vector3iUtil::get_volume(box.size);
+
+	for (unsigned int i = 0; i < boxes.size(); ++i) {
+		Box3i &other = boxes[i];
+		if (other.encloses(box)) {
+			return;
+		}
+		if (!other.padded(1).intersects(box)) {
+			continue;
+		}
+		const Box3i merged = Box3i::get_bounding_box(other, box);
+		if (Vector3iUtil::get_volume(merged.size) <= 2 * (volume + Vector3iUtil::get_volume(other.size))) {
+			// The merged box may now touch other boxes, but they will likely be merged by subsequent edits
+			other = merged;
+			return;
+		}
+	}
+
+	boxes.push_back(box);
+}
+
+} // namespace
+
 void VoxelTerrain::post_edit_area(Box3i box_in_voxels, bool update_mesh) {
+	// Done right away so saving can't miss modified blocks
 	_data->mark_area_modified(box_in_voxels, nullptr, false);
 
 	box_in_voxels.clip(_data->get_bounds());
@@ -772,20 +975,52 @@ void VoxelTerrain::post_edit_area(Box3i box_in_voxels, bool update_mesh) {
 		GDVIRTUAL_CALL(_on_area_edited, box_in_voxels.position, box_in_voxels.size);
 	}
 
-	if (_multiplayer_synchronizer != nullptr && _multiplayer_synchronizer->is_server()) {
-		// TODO This is not efficient when the user does many individual modifications in a specific area.
-		// We would either have to batch modified areas somehow, or expose a transactional API to the user
-		// (begin(area), edit in area, end(area))
-		_multiplayer_synchronizer->send_area(box_in_voxels);
+	if (box_in_voxels.is_empty()) {
+		return;
 	}
 
-	if (update_mesh) {
-		try_schedule_mesh_update_from_data(box_in_voxels);
+	// Many small edits often occur in the same area within a frame (or transaction), so they are merged and their
+	// side effects are processed later
+	add_merged_box(update_mesh ? _pending_edited_areas : _pending_edited_areas_without_mesh_update, box_in_voxels);
+}
+
+void VoxelTerrain::begin_edit_transaction() {
+	++_edit_transaction_depth;
+}
+
+void VoxelTerrain::end_edit_transaction() {
+	ERR_FAIL_COND_MSG(_edit_transaction_depth == 0, "No edit transaction was started");
+	--_edit_transaction_depth;
+	if (_edit_transaction_depth == 0) {
+		flush_pending_edited_areas();
+	}
+}
+
+void VoxelTerrain::flush_pending_edited_areas() {
+	ZN_PROFILE_SCOPE();
+
+	const bool send_to_peers = _multiplayer_synchronizer != nullptr && _multiplayer_synchronizer->is_server();
+
+	for (const Box3i &box : _pending_edited_areas) {
+		if (send_to_peers) {
+			_multiplayer_synchronizer->send_area(box);
+		}
+
+		try_schedule_mesh_update_from_data(box);
 
 		if (_instancer != nullptr) {
-			_instancer->on_area_edited(box_in_voxels);
+			_instancer->on_area_edited(box);
+		}
+	}
+
+	if (send_to_peers) {
+		for (const Box3i &box : _pending_edited_areas_without_mesh_update) {
+			_multiplayer_synchronizer->send_area(box);
 		}
 	}
+
+	_pending_edited_areas.clear();
+	_pending_edited_areas_without_mesh_update.clear();
 }
 
 void VoxelTerrain::_notification(int p_what) {
@@ -1127,6 +1362,13 @@ void VoxelTerrain::process() {
 	}
 
 	process_viewers();
+
+	if (_edit_transaction_depth == 0) {
+		flush_pending_edited_areas();
+	}
+
+	schedule_mesh_updates_from_loaded_data_blocks();
+
 	// process_received_data_blocks();
 	process_meshing();
 
@@ -1593,11 +1835,9 @@ void VoxelTerrain::apply_data_block_response(VoxelEngine::BlockDataOutput &ob) {
 		notify_data_block_enter(block, block_pos, viewer_id);
 	}
 
-	// The block itself might not be suitable for meshing yet, but blocks surrounding it might be now
-	// TODO Optimize: initial loading can hang for a while here.
-	// Because lots of blocks are loaded at once, which leads to many block queries.
-	try_schedule_mesh_update_from_data(
-			Box3i(_data->block_to_voxel(block_pos), Vector3iUtil::create(get_data_block_size())));
+	// The block itself might not be suitable for meshing yet, but blocks surrounding it might be now.
+	// Lots of blocks can be loaded at once, so they are checked together later.
+	_loaded_data_blocks_pending_meshing.push_back(block_pos);
 
 	// We might have requested some blocks again (if we got a dropped one while we still need them)
 	// if (stream_enabled) {
@@ -1654,8 +1894,7 @@ bool VoxelTerrain::try_set_block_data(Vector3i position, std::shared_ptr<VoxelBu
 	});
 
 	// The block itself might not be suitable for meshing yet, but blocks surrounding it might be now
-	try_schedule_mesh_update_from_data(
-			Box3i(_data->block_to_voxel(position), Vector3iUtil::create(get_data_block_size())));
+	_loaded_data_blocks_pending_meshing.push_back(position);
 
 	return true;
 }
@@ -1713,6 +1952,28 @@ void VoxelTerrain::process_meshing() {
 		task->collision_hint = _generate_collisions;
 		task->data = _data;
 
+		if (!mesh_block->mesh_task_cancellation_token.is_valid()) {
+			mesh_block->mesh_task_cancellation_token = TaskCancellationToken::create();
+		}
+		task->cancellation_token = mesh_block->mesh_task_cancellation_token;
+		// If a previous task is still pending for this block, its result would be replaced anyways. If it is already
+		// running, let it finish: when edits happen continuously, cancelling it would prevent the mesh from ever
+		// updating.
+		if (mesh_block->mesh_task_start_cancellation_token.is_valid()) {
+			mesh_block->mesh_task_start_cancellation_token.cancel();
+		}
+		mesh_block->mesh_task_start_cancellation_token = TaskCancellationToken::create();
+		task->start_cancellation_token = mesh_block->mesh_task_start_cancellation_token;
+		task->recycle_previous_mesh = true;
+		task->previous_mesh_signature = mesh_block->get_mesh_signature();
+
+		if (_instancer != nullptr && !mesh_block->has_mesh()) {
+			// The block will enter the instancer when it gets its mesh. Generating instances in the meshing task saves
+			// a round-trip to the main thread, and allows instances to appear at the same time as the mesh.
+			task->instance_library = _instancer->get_library();
+			task->instance_up_mode = _instancer->get_up_mode();
+		}
+
 		// This iteration order is specifically chosen to match VoxelEngine and threaded access
 		_data->get_blocks_with_voxel_data(data_box, 0, to_span(task->blocks));
 		task->blocks_count = Vector3iUtil::get_volume(data_box.size);
@@ -1780,7 +2041,25 @@ void VoxelTerrain::apply_mesh_update(const VoxelEngine::BlockMeshOutput &ob) {
 
 	Ref<ArrayMesh> mesh;
 	StdVector<uint16_t> material_indices;
-	if (ob.has_mesh_resource) {
+	// The mesh resource of the block can be kept if the task found it is still good, or can be updated in place.
+	// This avoids allocating new graphics buffers and freeing old ones.
+	bool recycled_mesh = false;
+	if ((ob.mesh_unchanged || ob.mesh_vertex_data.size() > 0) && block->has_mesh() &&
+			ob.previous_mesh_signature == block->get_mesh_signature() &&
+			// Vertex data can't be replaced if something else holds the mesh, it would see it change
+			(ob.mesh_unchanged || block->is_mesh_exclusively_owned())) {
+		mesh = block->get_mesh();
+		if (mesh.is_valid()) {
+			if (!ob.mesh_unchanged) {
+				update_mesh_vertex_data(**mesh, to_span_const(ob.mesh_vertex_data));
+			}
+			material_indices = std::move(ob.mesh_material_indices);
+			recycled_mesh = true;
+		}
+	}
+	if (recycled_mesh) {
+		// Mesh already assigned
+	} else if (ob.has_mesh_resource) {
 		// The mesh was already built as part of the threaded task
 		mesh = ob.mesh;
 		// It can be empty
@@ -1811,18 +2090,24 @@ void VoxelTerrain::apply_mesh_update(const VoxelEngine::BlockMeshOutput &ob) {
 		// We would have to know if specific voxels got edited, or different from the generator
 		// TODO Support multi-surfaces in VoxelInstancer
 		if (_instancer != nullptr) {
-			_instancer->on_mesh_block_enter(ob.position, ob.lod, ob.surfaces.surfaces[0].arrays);
+			_instancer->on_mesh_block_enter(
+					ob.position, ob.lod, ob.surfaces.surfaces[0].arrays, to_span_const(ob.generated_instances));
 		}
 	}
 
-	block->set_mesh(
-			mesh, get_gi_mode(), RenderingServer::ShadowCastingSetting(get_shadow_casting()), get_render_layers_mask());
+	if (!recycled_mesh) {
+		block->set_mesh(mesh, get_gi_mode(), RenderingServer::ShadowCastingSetting(get_shadow_casting()),
+				get_render_layers_mask());
+	}
+	block->set_mesh_signature(ob.mesh_signature);
 
 	if (_material_override.is_valid()) {
 		block->set_material_override(_material_override);
 	}
 
-	const bool gen_collisions = _generate_collisions && block->collision_viewers.get() > 0;
+	const bool gen_collisions = _generate_collisions && block->collision_viewers.get() > 0 &&
+			// The collision surface is part of the mesh content, no need to rebuild the shape if it didn't change
+			!(recycled_mesh && ob.mesh_unchanged && block->has_collision_shape());
 	if (gen_collisions) {
 		Ref<Shape3D> collision_shape = make_collision_shape_from_mesher_output(ob.surfaces, **_mesher);
 		const bool debug_collisions = is_inside_tree() ? get_tree()->is_debugging_collisions_hint() : false;
@@ -2166,6 +2451,9 @@ void VoxelTerrain::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("has_data_block", "block_position"), &VoxelTerrain::has_data_block);
 	ClassDB::bind_method(D_METHOD("is_area_meshed", "area_in_voxels"), &VoxelTerrain::_b_is_area_meshed);
 
+	ClassDB::bind_method(D_METHOD("begin_edit_transaction"), &VoxelTerrain::begin_edit_transaction);
+	ClassDB::bind_method(D_METHOD("end_edit_transaction"), &VoxelTerrain::end_edit_transaction);
+
 	ClassDB::bind_method(D_METHOD("debug_set_draw_enabled", "enabled"), &VoxelTerrain::debug_set_draw_enabled);
 	ClassDB::bind_method(D_METHOD("debug_is_draw_enabled"), &VoxelTerrain::debug_is_draw_enabled);
 	ClassDB::bind_method(D_METHOD("debug_set_draw_flag", "flag_index", "enabled"), &VoxelTerrain::debug_set_draw_flag);
@@ -64,8 +64,14 @@ public:
 	void set_mesh_block_size(unsigned int p_block_size);
 
 	void post_edit_voxel(Vector3i pos);
+	// Edited areas are accumulated and merged, then propagated to meshes, instances and network peers once per frame.
 	void post_edit_area(Box3i box_in_voxels, bool update_mesh);
 
+	// Edits posted between these calls are propagated only when the outermost transaction ends, which can span
+	// multiple frames. Transactions can be nested.
+	void begin_edit_transaction();
+	void end_edit_transaction();
+
 	void set_generate_collisions(bool enabled);
 	bool get_generate_collisions() const {
 		return _generate_collisions;
@@ -220,6 +226,8 @@ private:
 	// void make_data_block_dirty(Vector3i bpos);
 	void try_schedule_mesh_update(VoxelMeshBlockVT &block);
 	void try_schedule_mesh_update_from_data(const Box3i &box_in_voxels);
+	void flush_pending_edited_areas();
+	void schedule_mesh_updates_from_loaded_data_blocks();
 
 	void save_all_modified_blocks(bool with_copy, std::shared_ptr<AsyncDependencyTracker> tracker);
 	void get_viewer_pos_and_direction(Vector3 &out_pos, Vector3 &out_direction) const;
@@ -326,6 +334,14 @@ private:
 		Vector3i position;
 	};
 	StdVector<QuickReloadingBlock> _quick_reloading_blocks;
+	// Data blocks that were loaded or set since the last process call. Mesh blocks around them might be ready to be
+	// meshed. The order in that list does not matter.
+	StdVector<Vector3i> _loaded_data_blocks_pending_meshing;
+	// Areas edited since the last time edits were propagated, merged when close to each other.
+	StdVector<Box3i> _pending_edited_areas;
+	// Same, for edits not requiring mesh updates (metadata)
+	StdVector<Box3i> _pending_edited_areas_without_mesh_update;
+	unsigned int _edit_transaction_depth = 0;
 
 	Ref<VoxelMesher> _mesher;
 
@@ -18,6 +18,7 @@ LoadInstanceChunkTask::LoadInstanceChunkTask( //
 		std::shared_ptr<VoxelInstancerQuickReloadingCache> quick_reload_cache,
 		Ref<VoxelInstanceLibrary> library, //
 		Array mesh_arrays, //
+		StdVector<VoxelInstanceGeneratorOutput> &&generated_instances, //
 		Vector3i grid_position, //
 		uint8_t lod_index, //
 		uint8_t instance_block_size, //
@@ -30,6 +31,7 @@ LoadInstanceChunkTask::LoadInstanceChunkTask( //
 		_quick_reload_cache(quick_reload_cache), //
 		_library(library), //
 		_mesh_arrays(mesh_arrays), //
+		_generated_instances(std::move(generated_instances)), //
 		_render_grid_position(grid_position), //
 		_lod_index(lod_index), //
 		_instance_block_size(instance_block_size), //
@@ -219,6 +221,19 @@ void LoadInstanceChunkTask::run(ThreadedTaskContext &ctx) {
 						continue;
 					}
 
+					if (layer.edited_mask == 0) {
+						size_t generated_index;
+						if (find(_generated_instances, generated_index,
+									[layer_id](const VoxelInstanceGeneratorOutput &g) {
+										return g.layer_id == layer_id;
+									})) {
+							// Instances were already generated along with the mesh
+							layer.id = layer_id;
+							layer.transforms = std::move(_generated_instances[generated_index].transforms);
+							continue;
+						}
+					}
+
 					PackedVector3Array vertices = _mesh_arrays[ArrayMesh::ARRAY_VERTEX];
 
 					if (vertices.size() != 0) {
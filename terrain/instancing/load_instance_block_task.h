@@ -1,6 +1,7 @@
 #ifndef VOXEL_LOAD_INSTANCE_BLOCK_TASK_H
 #define VOXEL_LOAD_INSTANCE_BLOCK_TASK_H
 
+#include "../../engine/instance_generator_output.h"
 #include "../../streams/voxel_stream.h"
 #include "../../util/godot/core/array.h"
 #include "../../util/math/vector3i.h"
@@ -23,6 +24,7 @@ public:
 			std::shared_ptr<VoxelInstancerQuickReloadingCache> quick_reload_cache,
 			Ref<VoxelInstanceLibrary> library, //
 			Array mesh_arrays, //
+			StdVector<VoxelInstanceGeneratorOutput> &&generated_instances, //
 			Vector3i grid_position, //
 			uint8_t lod_index, //
 			uint8_t instance_block_size, //
@@ -42,6 +44,8 @@ private:
 	std::shared_ptr<VoxelInstancerQuickReloadingCache> _quick_reload_cache;
 	Ref<VoxelInstanceLibrary> _library;
 	Array _mesh_arrays;
+	// Instances that were already generated on the mesh, used for layers that don't have edited data
+	StdVector<VoxelInstanceGeneratorOutput> _generated_instances;
 	Vector3i _render_grid_position;
 	uint8_t _lod_index;
 	uint8_t _instance_block_size;
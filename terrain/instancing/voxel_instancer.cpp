@@ -995,11 +995,12 @@ void VoxelInstancer::remove_block(unsigned int block_index) {
 // 	lod.loaded_instances_data.insert(std::make_pair(grid_position, std::move(instances)));
 // }
 
-void VoxelInstancer::on_mesh_block_enter(Vector3i render_grid_position, unsigned int lod_index, Array surface_arrays) {
+void VoxelInstancer::on_mesh_block_enter(Vector3i render_grid_position, unsigned int lod_index, Array surface_arrays,
+		Span<const VoxelInstanceGeneratorOutput> generated_instances) {
 	if (lod_index >= _lods.size()) {
 		return;
 	}
-	create_render_blocks(render_grid_position, lod_index, surface_arrays);
+	create_render_blocks(render_grid_position, lod_index, surface_arrays, generated_instances);
 }
 
 void VoxelInstancer::on_mesh_block_exit(Vector3i render_grid_position, unsigned int lod_index) {
@@ -1327,7 +1328,32 @@ void VoxelInstancer::update_block_from_transforms( //
 	}
 }
 
-void VoxelInstancer::create_render_blocks(Vector3i render_grid_position, int lod_index, Array surface_arrays) {
+namespace {
+
+bool are_all_generated_layers_present(const VoxelInstanceLibrary &library, unsigned int lod_index,
+		Span<const VoxelInstanceGeneratorOutput> generated_instances) {
+	static thread_local StdVector<VoxelInstanceLibrary::PackedItem> tls_items;
+	tls_items.clear();
+	library.get_packed_items_at_lod(tls_items, lod_index);
+
+	for (const VoxelInstanceLibrary::PackedItem &item : tls_items) {
+		if (item.generator.is_null()) {
+			continue;
+		}
+		size_t index;
+		const unsigned int layer_id = item.id;
+		if (!find(generated_instances, index,
+					[layer_id](const VoxelInstanceGeneratorOutput &g) { return g.layer_id == layer_id; })) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+void VoxelInstancer::create_render_blocks(Vector3i render_grid_position, int lod_index, Array surface_arrays,
+		Span<const VoxelInstanceGeneratorOutput> generated_instances) {
 	ZN_PROFILE_SCOPE();
 	ZN_ASSERT_RETURN(_library.is_valid());
 	ZN_ASSERT_RETURN(_parent != nullptr);
@@ -1352,12 +1378,33 @@ void VoxelInstancer::create_render_blocks(Vector3i render_grid_position, int lod
 		create_block(layer, layer_id, render_grid_position, true);
 	}
 
+	if (stream.is_null() && are_all_generated_layers_present(**_library, lod_index, generated_instances)) {
+		// Nothing can be loaded, and instances were already generated with the mesh, so we don't need a task
+		MutexLock mlock(_loading_results->mutex);
+		for (const VoxelInstanceGeneratorOutput &generated : generated_instances) {
+			VoxelInstanceLoadingTaskOutput o;
+			o.layer_id = generated.layer_id;
+			o.edited_mask = 0;
+			o.render_block_position = render_grid_position;
+			o.transforms = generated.transforms;
+			_loading_results->results.push_back(std::move(o));
+		}
+		return;
+	}
+
+	StdVector<VoxelInstanceGeneratorOutput> generated_instances_copy;
+	generated_instances_copy.reserve(generated_instances.size());
+	for (const VoxelInstanceGeneratorOutput &generated : generated_instances) {
+		generated_instances_copy.push_back(generated);
+	}
+
 	LoadInstanceChunkTask *task = ZN_NEW(LoadInstanceChunkTask( //
 			_loading_results, //
 			stream, //
 			lod.quick_reload_cache, //
 			_library, //
 			surface_arrays, //
+			std::move(generated_instances_copy), //
 			render_grid_position, //
 			lod_index, //
 			render_block_size, //
@@ -2,6 +2,7 @@
 #define VOXEL_INSTANCER_H
 
 #include "../../constants/voxel_constants.h"
+#include "../../engine/instance_generator_output.h"
 #include "../../streams/instance_data.h"
 #include "../../util/containers/fixed_array.h"
 #include "../../util/containers/std_unordered_map.h"
@@ -14,6 +15,7 @@
 #include "voxel_instance_generator.h"
 #include "voxel_instance_library.h"
 #include "voxel_instance_library_multimesh_item.h"
+#include "voxel_instancer_task_output_queue.h"
 
 #ifdef TOOLS_ENABLED
 #include "../../util/godot/core/version.h"
@@ -78,7 +80,9 @@ public:
 
 	// void on_data_block_loaded(Vector3i grid_position, unsigned int lod_index, UniquePtr<InstanceBlockData>
 	// instances);
-	void on_mesh_block_enter(Vector3i render_grid_position, unsigned int lod_index, Array surface_arrays);
+	// `generated_instances` may contain instances already generated on the mesh, for layers having a generator.
+	void on_mesh_block_enter(Vector3i render_grid_position, unsigned int lod_index, Array surface_arrays,
+			Span<const VoxelInstanceGeneratorOutput> generated_instances);
 	void on_mesh_block_exit(Vector3i render_grid_position, unsigned int lod_index);
 	void on_area_edited(Box3i p_voxel_box);
 	void on_body_removed(Vector3i data_block_position, unsigned int render_block_index, unsigned int instance_index);
@@ -154,7 +158,8 @@ private:
 	void regenerate_layer(uint16_t layer_id, bool regenerate_blocks);
 	void update_layer_meshes(int layer_id);
 	void update_layer_scenes(int layer_id);
-	void create_render_blocks(Vector3i grid_position, int lod_index, Array surface_arrays);
+	void create_render_blocks(Vector3i grid_position, int lod_index, Array surface_arrays,
+			Span<const VoxelInstanceGeneratorOutput> generated_instances);
 
 #ifdef TOOLS_ENABLED
 	void process_gizmos();
@@ -0,0 +1,293 @@
+#include "mesh_batch_vlt.h"
+#include "../../engine/voxel_engine.h"
+#include "../../util/godot/classes/mesh.h"
+#include "../../util/godot/classes/rendering_server.h"
+#include "../../util/io/log.h"
+#include "../../util/profiling.h"
+#include "voxel_mesh_block_vlt.h"
+
+namespace zylann::voxel {
+
+namespace {
+
+template <typename TPackedArray>
+void append_packed_array(Array &dst_arrays, const Array &src_arrays, unsigned int array_index) {
+	TPackedArray dst = dst_arrays[array_index];
+	const TPackedArray src = src_arrays[array_index];
+	// Avoiding stupid CoW, assuming the destination holds the only instance of this array
+	dst_arrays[array_index] = Variant();
+	dst.append_array(src);
+	dst_arrays[array_index] = dst;
+}
+
+// Returns false if the array has a type that can't be appended
+bool append_array(Array &dst_arrays, const Array &src_arrays, unsigned int array_index) {
+	switch (src_arrays[array_index].get_type()) {
+		case Variant::PACKED_VECTOR3_ARRAY:
+			append_packed_array<PackedVector3Array>(dst_arrays, src_arrays, array_index);
+			break;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			append_packed_array<PackedVector2Array>(dst_arrays, src_arrays, array_index);
+			break;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			append_packed_array<PackedFloat32Array>(dst_arrays, src_arrays, array_index);
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			append_packed_array<PackedInt32Array>(dst_arrays, src_arrays, array_index);
+			break;
+		case Variant::PACKED_COLOR_ARRAY:
+			append_packed_array<PackedColorArray>(dst_arrays, src_arrays, array_index);
+			break;
+		case Variant::PACKED_BYTE_ARRAY:
+			append_packed_array<PackedByteArray>(dst_arrays, src_arrays, array_index);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+// Returns the number of elements in an array of a surface, or -1 if it has a type that can't be appended
+int get_appendable_array_size(const Variant &v) {
+	switch (v.get_type()) {
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return PackedVector3Array(v).size();
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return PackedVector2Array(v).size();
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return PackedFloat32Array(v).size();
+		case Variant::PACKED_INT32_ARRAY:
+			return PackedInt32Array(v).size();
+		case Variant::PACKED_COLOR_ARRAY:
+			return PackedColorArray(v).size();
+		case Variant::PACKED_BYTE_ARRAY:
+			return PackedByteArray(v).size();
+		default:
+			return -1;
+	}
+}
+
+inline bool is_mergeable_surface(const Array &arrays) {
+	return arrays.size() == Mesh::ARRAY_MAX && zylann::godot::is_surface_triangulated(arrays);
+}
+
+// Checks that a surface can be appended to another, which can be null if there is none yet. Arrays must have the same
+// types and the same number of elements per vertex, otherwise the merged surface would be corrupted.
+bool is_surface_appendable(const Array &src_arrays, const Array *dst_arrays) {
+	const int src_vertex_count = get_appendable_array_size(src_arrays[Mesh::ARRAY_VERTEX]);
+	if (src_vertex_count <= 0) {
+		return false;
+	}
+	const int dst_vertex_count =
+			dst_arrays != nullptr ? get_appendable_array_size((*dst_arrays)[Mesh::ARRAY_VERTEX]) : 0;
+
+	for (unsigned int array_index = 0; array_index < Mesh::ARRAY_MAX; ++array_index) {
+		const Variant &src_array = src_arrays[array_index];
+		if (dst_vertex_count > 0 && src_array.get_type() != (*dst_arrays)[array_index].get_type()) {
+			return false;
+		}
+		if (src_array.get_type() == Variant::NIL) {
+			continue;
+		}
+		const int src_size = get_appendable_array_size(src_array);
+		if (src_size < 0) {
+			return false;
+		}
+		if (array_index == Mesh::ARRAY_INDEX) {
+			if (src_size % 3 != 0) {
+				return false;
+			}
+			continue;
+		}
+		if (src_size % src_vertex_count != 0) {
+			return false;
+		}
+		if (dst_vertex_count > 0) {
+			const int dst_size = get_appendable_array_size((*dst_arrays)[array_index]);
+			if (src_size / src_vertex_count != dst_size / dst_vertex_count) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+bool append_mesh_block_surfaces(StdVector<VoxelMesher::Output::Surface> &dst,
+		Span<const VoxelMesher::Output::Surface> src, Vector3 offset, int mesh_flags) {
+	ZN_PROFILE_SCOPE();
+
+	// Validate everything first, so we don't leave a partially appended surface if something is wrong
+	for (unsigned int src_index = 0; src_index < src.size(); ++src_index) {
+		const VoxelMesher::Output::Surface &src_surface = src[src_index];
+		if (!is_mergeable_surface(src_surface.arrays)) {
+			continue;
+		}
+		// Surfaces using the same material end up merged together, whether they come from `dst` or `src`
+		const Array *dst_arrays = nullptr;
+		for (const VoxelMesher::Output::Surface &s : dst) {
+			if (s.material_index == src_surface.material_index) {
+				dst_arrays = &s.arrays;
+				break;
+			}
+		}
+		for (unsigned int i = 0; i < src_index && dst_arrays == nullptr; ++i) {
+			if (src[i].material_index == src_surface.material_index && is_mergeable_surface(src[i].arrays)) {
+				dst_arrays = &src[i].arrays;
+			}
+		}
+		if (!is_surface_appendable(src_surface.arrays, dst_arrays)) {
+			return false;
+		}
+	}
+
+	const bool has_secondary_positions =
+			((mesh_flags >> Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT) & Mesh::ARRAY_FORMAT_CUSTOM_MASK) ==
+			RenderingServer::ARRAY_CUSTOM_RGBA_FLOAT;
+
+	for (const VoxelMesher::Output::Surface &src_surface : src) {
+		const Array &src_arrays = src_surface.arrays;
+		if (!is_mergeable_surface(src_arrays)) {
+			continue;
+		}
+
+		VoxelMesher::Output::Surface *dst_surface = nullptr;
+		for (VoxelMesher::Output::Surface &s : dst) {
+			if (s.material_index == src_surface.material_index) {
+				dst_surface = &s;
+				break;
+			}
+		}
+		if (dst_surface == nullptr) {
+			dst.push_back(VoxelMesher::Output::Surface());
+			dst_surface = &dst.back();
+			dst_surface->material_index = src_surface.material_index;
+			dst_surface->arrays.resize(Mesh::ARRAY_MAX);
+		}
+		Array &dst_arrays = dst_surface->arrays;
+
+		const PackedVector3Array dst_positions = dst_arrays[Mesh::ARRAY_VERTEX];
+		const int vertex_base = dst_positions.size();
+
+		for (unsigned int array_index = 0; array_index < Mesh::ARRAY_MAX; ++array_index) {
+			const Variant::Type src_type = src_arrays[array_index].get_type();
+			const Variant::Type dst_type = dst_arrays[array_index].get_type();
+			if (src_type == Variant::NIL && dst_type == Variant::NIL) {
+				continue;
+			}
+			if (dst_type == Variant::NIL && vertex_base == 0) {
+				// First surface: share arrays, they will be copied on write if they have to be offset
+				dst_arrays[array_index] = src_arrays[array_index];
+				continue;
+			}
+			// Formats were validated earlier
+			append_array(dst_arrays, src_arrays, array_index);
+		}
+
+		{
+			PackedVector3Array positions = dst_arrays[Mesh::ARRAY_VERTEX];
+			dst_arrays[Mesh::ARRAY_VERTEX] = PackedVector3Array();
+			Vector3 *positions_data = positions.ptrw();
+			for (int i = vertex_base; i < positions.size(); ++i) {
+				positions_data[i] += offset;
+			}
+			dst_arrays[Mesh::ARRAY_VERTEX] = positions;
+		}
+
+		if (has_secondary_positions && dst_arrays[Mesh::ARRAY_CUSTOM0].get_type() == Variant::PACKED_FLOAT32_ARRAY) {
+			// Transvoxel stores secondary positions in XYZ, and packed flags in W
+			PackedFloat32Array custom0 = dst_arrays[Mesh::ARRAY_CUSTOM0];
+			dst_arrays[Mesh::ARRAY_CUSTOM0] = PackedFloat32Array();
+			float *custom0_data = custom0.ptrw();
+			for (int i = vertex_base * 4; i + 2 < custom0.size(); i += 4) {
+				custom0_data[i] += offset.x;
+				custom0_data[i + 1] += offset.y;
+				custom0_data[i + 2] += offset.z;
+			}
+			dst_arrays[Mesh::ARRAY_CUSTOM0] = custom0;
+		}
+
+		if (vertex_base > 0) {
+			const PackedInt32Array src_indices = src_arrays[Mesh::ARRAY_INDEX];
+			PackedInt32Array indices = dst_arrays[Mesh::ARRAY_INDEX];
+			dst_arrays[Mesh::ARRAY_INDEX] = PackedInt32Array();
+			int32_t *indices_data = indices.ptrw();
+			for (int i = indices.size() - src_indices.size(); i < indices.size(); ++i) {
+				indices_data[i] += vertex_base;
+			}
+			dst_arrays[Mesh::ARRAY_INDEX] = indices;
+		}
+	}
+
+	return true;
+}
+
+void release_mesh_block_surfaces(StdVector<VoxelMesher::Output::Surface> &surfaces) {
+	unsigned int dst_index = 0;
+	for (unsigned int src_index = 0; src_index < surfaces.size(); ++src_index) {
+		VoxelMesher::Output::Surface &surface = surfaces[src_index];
+		// Same criteria as when building the mesh, so the remaining surfaces match those of the mesh
+		if (!is_mergeable_surface(surface.arrays)) {
+			continue;
+		}
+		surfaces[dst_index].material_index = surface.material_index;
+		surfaces[dst_index].arrays = Array();
+		++dst_index;
+	}
+	surfaces.resize(dst_index);
+	surfaces.shrink_to_fit();
+}
+
+bool are_mesh_block_surfaces_released(Span<const VoxelMesher::Output::Surface> surfaces) {
+	return surfaces.size() > 0 && surfaces[0].arrays.is_empty();
+}
+
+bool reload_mesh_block_surfaces(const Mesh &mesh, StdVector<VoxelMesher::Output::Surface> &surfaces) {
+	ZN_PROFILE_SCOPE();
+	if (mesh.get_surface_count() != static_cast<int>(surfaces.size())) {
+		return false;
+	}
+	for (unsigned int surface_index = 0; surface_index < surfaces.size(); ++surface_index) {
+		surfaces[surface_index].arrays = mesh.surface_get_arrays(surface_index);
+	}
+	return true;
+}
+
+void MeshBatchTaskVLT::run(ThreadedTaskContext &ctx) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT(output_queue != nullptr);
+
+	StdVector<VoxelMesher::Output::Surface> surfaces;
+	for (const Member &member : members) {
+		if (!append_mesh_block_surfaces(surfaces, to_span_const(member.surfaces), member.offset, mesh_flags)) {
+			// Leaving surfaces empty will make the batch get destroyed, so members are drawn individually
+			ZN_PRINT_ERROR("Could not merge mesh blocks having different formats");
+			surfaces.clear();
+			break;
+		}
+	}
+
+	MeshBatchTaskOutputVLT o;
+	o.batch_position = batch_position;
+	o.lod_index = lod_index;
+	o.version = version;
+	o.members_mask = members_mask;
+	o.mesh_flags = mesh_flags;
+
+	if (VoxelEngine::get_singleton().is_threaded_graphics_resource_building_enabled()) {
+		// Material is assigned on the main thread
+		o.mesh = build_mesh(to_span_const(surfaces), Mesh::PRIMITIVE_TRIANGLES, mesh_flags, Ref<Material>());
+		o.has_mesh_resource = true;
+	} else {
+		o.surfaces = std::move(surfaces);
+		o.has_mesh_resource = false;
+	}
+
+	{
+		MutexLock mlock(output_queue->mutex);
+		output_queue->results.push_back(std::move(o));
+	}
+}
+
+} // namespace zylann::voxel
@@ -0,0 +1,103 @@
+#ifndef VOXEL_MESH_BATCH_VLT_H
+#define VOXEL_MESH_BATCH_VLT_H
+
+#include "../../meshers/voxel_mesher.h"
+#include "../../util/containers/std_vector.h"
+#include "../../util/godot/classes/array_mesh.h"
+#include "../../util/godot/classes/shader_material.h"
+#include "../../util/godot/direct_mesh_instance.h"
+#include "../../util/math/vector3i.h"
+#include "../../util/tasks/threaded_task.h"
+#include "../../util/thread/mutex.h"
+
+#include <memory>
+
+namespace zylann::voxel {
+
+// Draws the meshes of a group of 2x2x2 sibling mesh blocks of `VoxelLodTerrain` with a single mesh instance.
+// At distant LODs, blocks are small on screen yet each of them costs a draw call and per-instance overhead, so merging
+// them reduces that several times. A batch is only drawn while all its members are in a "simple" state (active, no
+// transitions, no fading). Otherwise it is split back and members are drawn individually.
+struct MeshBatchVLT {
+	// Member blocks are within the 2x2x2 group starting at this position, in mesh blocks of the same LOD
+	static inline Vector3i get_origin_block_position(Vector3i batch_position) {
+		return batch_position * 2;
+	}
+
+	static inline uint8_t get_member_index(Vector3i bpos) {
+		return (bpos.x & 1) | ((bpos.y & 1) << 1) | ((bpos.z & 1) << 2);
+	}
+
+	// Declared before the mesh instance so it gets released after it
+	Ref<ShaderMaterial> shader_material;
+	zylann::godot::DirectMeshInstance mesh_instance;
+	// Incremented every time members change, so results of outdated merging tasks can be discarded
+	uint32_t version = 0;
+	// Members that were merged into the mesh of the current version (bits indexed with `get_member_index`)
+	uint8_t members_mask = 0;
+	// True when a merging task is in progress for the current version
+	bool pending = false;
+	// True when the batch is drawn in place of its members
+	bool active = false;
+};
+
+struct MeshBatchTaskOutputVLT {
+	Vector3i batch_position;
+	uint8_t lod_index;
+	uint32_t version;
+	uint8_t members_mask;
+	int mesh_flags;
+	bool has_mesh_resource;
+	// Only valid if `has_mesh_resource` is true. Can be null if the merged mesh is empty.
+	Ref<ArrayMesh> mesh;
+	// Merged surfaces, only filled if the mesh resource could not be built in the task
+	StdVector<VoxelMesher::Output::Surface> surfaces;
+};
+
+struct MeshBatchTaskOutputQueueVLT {
+	StdVector<MeshBatchTaskOutputVLT> results;
+	Mutex mutex;
+};
+
+// Concatenates surfaces of the members of a batch, in a thread.
+class MeshBatchTaskVLT : public IThreadedTask {
+public:
+	struct Member {
+		// Surfaces are shared with the mesh block. They are not modified.
+		StdVector<VoxelMesher::Output::Surface> surfaces;
+		// Offset to apply to vertices, relative to the origin of the batch
+		Vector3 offset;
+	};
+
+	Vector3i batch_position;
+	uint8_t lod_index;
+	uint8_t members_mask;
+	uint32_t version;
+	int mesh_flags;
+	StdVector<Member> members;
+	std::shared_ptr<MeshBatchTaskOutputQueueVLT> output_queue;
+
+	const char *get_debug_name() const override {
+		return "MeshBatchVLT";
+	}
+
+	void run(ThreadedTaskContext &ctx) override;
+};
+
+// Appends surfaces of `src` to `dst`, merging surfaces having the same material index.
+// Vertex positions are offset by `offset`, and so are secondary positions of Transvoxel meshes, if present in CUSTOM0.
+// Returns false if surfaces to merge have different formats, in which case `dst` is left unchanged.
+bool append_mesh_block_surfaces(StdVector<VoxelMesher::Output::Surface> &dst,
+		Span<const VoxelMesher::Output::Surface> src, Vector3 offset, int mesh_flags);
+
+// Frees arrays of the surfaces of a block once they were merged, only keeping what's needed to reload them from the
+// mesh of the block if they have to be merged again.
+void release_mesh_block_surfaces(StdVector<VoxelMesher::Output::Surface> &surfaces);
+bool are_mesh_block_surfaces_released(Span<const VoxelMesher::Output::Surface> surfaces);
+// Gets arrays of released surfaces back from the mesh of the block. This is slower than keeping them in memory, but
+// only happens when a batch has to be merged again. Returns false if the mesh doesn't match surfaces.
+bool reload_mesh_block_surfaces(const Mesh &mesh, StdVector<VoxelMesher::Output::Surface> &surfaces);
+
+} // namespace zylann::voxel
+
+#endif // VOXEL_MESH_BATCH_VLT_H
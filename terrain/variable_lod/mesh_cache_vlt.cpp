@@ -0,0 +1,147 @@
+#include "mesh_cache_vlt.h"
+#include "../../util/containers/std_vector.h"
+#include "../../util/profiling.h"
+
+#include <algorithm>
+
+namespace zylann::voxel {
+
+void MeshCacheVLT::set_capacity(unsigned int capacity) {
+	MutexLock mlock(_mutex);
+	_capacity = capacity;
+	if (_capacity == 0) {
+		for (StdUnorderedMap<Vector3i, Entry> &map : _lods) {
+			map.clear();
+		}
+		_count = 0;
+	} else if (_count > _capacity) {
+		evict_least_recently_used();
+	}
+}
+
+unsigned int MeshCacheVLT::get_capacity() const {
+	MutexLock mlock(_mutex);
+	return _capacity;
+}
+
+uint32_t MeshCacheVLT::get_revision() const {
+	MutexLock mlock(_mutex);
+	return _revision;
+}
+
+void MeshCacheVLT::put(VoxelEngine::BlockMeshOutput output, uint32_t revision) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT_RETURN(output.lod < _lods.size());
+
+	MutexLock mlock(_mutex);
+
+	if (_capacity == 0 || revision != _revision) {
+		return;
+	}
+
+	StdUnorderedMap<Vector3i, Entry> &map = _lods[output.lod];
+	auto p = map.insert({ output.position, Entry() });
+	if (p.second) {
+		++_count;
+	}
+	Entry &entry = p.first->second;
+	entry.output = std::move(output);
+	// Detail textures are requested separately when they are needed
+	entry.output.detail_textures.reset();
+	entry.last_used_time = ++_time;
+
+	if (_count > _capacity) {
+		evict_least_recently_used();
+	}
+}
+
+bool MeshCacheVLT::try_get(Vector3i block_position, unsigned int lod_index, VoxelEngine::BlockMeshOutput &out_output) {
+	ZN_ASSERT_RETURN_V(lod_index < _lods.size(), false);
+
+	MutexLock mlock(_mutex);
+
+	StdUnorderedMap<Vector3i, Entry> &map = _lods[lod_index];
+	auto it = map.find(block_position);
+	if (it == map.end()) {
+		return false;
+	}
+	Entry &entry = it->second;
+	entry.last_used_time = ++_time;
+	out_output = entry.output;
+	return true;
+}
+
+void MeshCacheVLT::invalidate(Box3i block_box, unsigned int lod_index) {
+	ZN_ASSERT_RETURN(lod_index < _lods.size());
+
+	MutexLock mlock(_mutex);
+
+	++_revision;
+
+	StdUnorderedMap<Vector3i, Entry> &map = _lods[lod_index];
+	if (map.size() == 0) {
+		return;
+	}
+
+	// Edited areas are usually small, but changes to generated areas can cover a lot of blocks
+	if (Vector3iUtil::get_volume(block_box.size) < static_cast<int64_t>(map.size())) {
+		block_box.for_each_cell([&map, this](Vector3i bpos) {
+			if (map.erase(bpos) != 0) {
+				--_count;
+			}
+		});
+	} else {
+		for (auto it = map.begin(); it != map.end();) {
+			if (block_box.contains(it->first)) {
+				it = map.erase(it);
+				--_count;
+			} else {
+				++it;
+			}
+		}
+	}
+}
+
+void MeshCacheVLT::clear() {
+	MutexLock mlock(_mutex);
+
+	++_revision;
+
+	for (StdUnorderedMap<Vector3i, Entry> &map : _lods) {
+		map.clear();
+	}
+	_count = 0;
+}
+
+void MeshCacheVLT::evict_least_recently_used() {
+	ZN_PROFILE_SCOPE();
+
+	// Evict a bit more than necessary, so we don't have to do this every time a block is added
+	const unsigned int target_count = _capacity - _capacity / 8;
+	const unsigned int remove_count = _count - target_count;
+
+	static thread_local StdVector<uint32_t> tls_times;
+	tls_times.clear();
+	for (const StdUnorderedMap<Vector3i, Entry> &map : _lods) {
+		for (auto it = map.begin(); it != map.end(); ++it) {
+			tls_times.push_back(it->second.last_used_time);
+		}
+	}
+
+	// Times are unique, so this finds the most recent time among blocks to remove
+	std::nth_element(tls_times.begin(), tls_times.begin() + (remove_count - 1), tls_times.end());
+	const uint32_t max_time_to_remove = tls_times[remove_count - 1];
+
+	for (StdUnorderedMap<Vector3i, Entry> &map : _lods) {
+		for (auto it = map.begin(); it != map.end();) {
+			if (it->second.last_used_time <= max_time_to_remove) {
+				it = map.erase(it);
+				--_count;
+			} else {
+				++it;
+			}
+		}
+	}
+}
+
+} // namespace zylann::voxel
@@ -0,0 +1,58 @@
+#ifndef VOXEL_MESH_CACHE_VLT_H
+#define VOXEL_MESH_CACHE_VLT_H
+
+#include "../../constants/voxel_constants.h"
+#include "../../engine/voxel_engine.h"
+#include "../../util/containers/fixed_array.h"
+#include "../../util/containers/std_unordered_map.h"
+#include "../../util/math/box3i.h"
+#include "../../util/thread/mutex.h"
+
+namespace zylann::voxel {
+
+// Keeps results of recent meshing tasks of `VoxelLodTerrain`, so they can be reused when a mesh block gets requested
+// again while its voxels did not change. This typically happens when a viewer moves back and forth around LOD
+// boundaries: the same blocks get unloaded and loaded again, and would otherwise be remeshed every time.
+// When the cache is full, least recently used blocks are removed first.
+// Can be accessed from multiple threads.
+class MeshCacheVLT {
+public:
+	// Maximum number of mesh blocks kept in the cache. 0 disables caching.
+	void set_capacity(unsigned int capacity);
+	unsigned int get_capacity() const;
+
+	// Incremented every time blocks are invalidated. Meshes computed while an invalidation occurred may have used old
+	// voxels, so the revision has to be obtained before their meshing tasks are scheduled, and passed along with them.
+	uint32_t get_revision() const;
+
+	// Stores a copy of the output. It is expected to contain a mesh resource, if it has one.
+	// Does nothing if blocks got invalidated since `revision` was obtained.
+	void put(VoxelEngine::BlockMeshOutput output, uint32_t revision);
+
+	// Gets a copy of the output cached for a block, if any
+	bool try_get(Vector3i block_position, unsigned int lod_index, VoxelEngine::BlockMeshOutput &out_output);
+
+	// Removes cached blocks within a box, in mesh block coordinates of the given LOD
+	void invalidate(Box3i block_box, unsigned int lod_index);
+
+	void clear();
+
+private:
+	void evict_least_recently_used();
+
+	struct Entry {
+		VoxelEngine::BlockMeshOutput output;
+		uint32_t last_used_time;
+	};
+
+	FixedArray<StdUnorderedMap<Vector3i, Entry>, constants::MAX_LOD> _lods;
+	unsigned int _capacity = 0;
+	unsigned int _count = 0;
+	uint32_t _time = 0;
+	uint32_t _revision = 0;
+	mutable BinaryMutex _mutex;
+};
+
+} // namespace zylann::voxel
+
+#endif // VOXEL_MESH_CACHE_VLT_H
@@ -116,6 +116,7 @@ VoxelLodTerrain::VoxelLodTerrain() {
 	_update_data->task_is_complete = true;
 	_streaming_dependency = make_shared_instance<StreamingDependency>();
 	_meshing_dependency = make_shared_instance<MeshingDependency>();
+	_mesh_batch_results = make_shared_instance<MeshBatchTaskOutputQueueVLT>();
 
 	set_notify_transform(true);
 
@@ -173,6 +174,10 @@ VoxelLodTerrain::~VoxelLodTerrain() {
 	abort_async_edits();
 	_streaming_dependency->valid = false;
 	_meshing_dependency->valid = false;
+	Ref<VoxelGenerator> generator = get_generator();
+	if (generator.is_valid()) {
+		generator->get_block_cache().unregister_user(_volume_id);
+	}
 	VoxelEngine::get_singleton().remove_volume(_volume_id);
 	// Instancer can take care of itself
 }
@@ -215,12 +220,6 @@ void VoxelLodTerrain::set_material(Ref<Material> p_material) {
 
 	update_shader_material_pool_template();
 
-	{
-		// Detect presence of lod_index usage in the shader
-		Span<const StringName> uniforms = _shader_material_pool.get_cached_shader_uniforms();
-		_material_uses_lod_info = contains(uniforms, VoxelStringNames::get_singleton().u_voxel_lod_info);
-	}
-
 	// TODO Update when shader changes?
 	// TODO Update when material changes?
 
@@ -234,6 +233,20 @@ void VoxelLodTerrain::set_material(Ref<Material> p_material) {
 					// No visuals loaded (collision only?)
 					return;
 				}
+				block.set_use_instance_shader_parameters(_material_uses_instance_parameters);
+				block.set_shared_material(
+						_material_uses_instance_parameters ? _shader_material_pool.get_template() : Ref<Material>());
+
+				if (!needs_shader_material_per_block(lod_index)) {
+					// Previous material can't be recycled, it might be using a different shader
+					block.set_shader_material(Ref<ShaderMaterial>());
+					if (_material_uses_lod_info) {
+						block.set_shader_parameter(VoxelStringNames::get_singleton().u_voxel_lod_info,
+								encode_lod_info_for_shader_uniform(lod_index, lod_count));
+					}
+					return;
+				}
+
 				Ref<ShaderMaterial> sm = _shader_material_pool.allocate();
 				Ref<ShaderMaterial> prev_material = block.get_shader_material();
 				if (prev_material.is_valid()) {
@@ -260,6 +273,8 @@ void VoxelLodTerrain::set_material(Ref<Material> p_material) {
 					// No visuals loaded (collision only?)
 					return;
 				}
+				block.set_use_instance_shader_parameters(false);
+				block.set_shared_material(Ref<Material>());
 				block.set_shader_material(Ref<ShaderMaterial>());
 
 				Ref<Mesh> mesh = block.get_mesh();
@@ -272,6 +287,9 @@ void VoxelLodTerrain::set_material(Ref<Material> p_material) {
 			});
 		}
 	}
+
+	// Batches have their own material, rebuild them
+	reset_mesh_batches();
 }
 
 unsigned int VoxelLodTerrain::get_data_block_size() const {
@@ -325,6 +343,14 @@ void VoxelLodTerrain::set_generator(Ref<VoxelGenerator> p_generator) {
 		return;
 	}
 
+	Ref<VoxelGenerator> prev_generator = get_generator();
+	if (prev_generator.is_valid()) {
+		prev_generator->get_block_cache().unregister_user(_volume_id);
+	}
+	if (p_generator.is_valid()) {
+		p_generator->get_block_cache().register_user(_volume_id);
+	}
+
 	_data->set_generator(p_generator);
 
 	MeshingDependency::reset(_meshing_dependency, _mesher, p_generator);
@@ -357,6 +383,11 @@ void VoxelLodTerrain::_on_gi_mode_changed() {
 		_mesh_maps_per_lod[lod_index].for_each_block([gi_mode](VoxelMeshBlockVLT &block) { //
 			block.set_gi_mode(gi_mode);
 		});
+		for (auto it = _mesh_batches_per_lod[lod_index].begin(); it != _mesh_batches_per_lod[lod_index].end(); ++it) {
+			if (it->second.mesh_instance.is_valid()) {
+				it->second.mesh_instance.set_gi_mode(gi_mode);
+			}
+		}
 	}
 }
 
@@ -366,6 +397,11 @@ void VoxelLodTerrain::_on_shadow_casting_changed() {
 		_mesh_maps_per_lod[lod_index].for_each_block([mode](VoxelMeshBlockVLT &block) { //
 			block.set_shadow_casting(mode);
 		});
+		for (auto it = _mesh_batches_per_lod[lod_index].begin(); it != _mesh_batches_per_lod[lod_index].end(); ++it) {
+			if (it->second.mesh_instance.is_valid()) {
+				it->second.mesh_instance.set_cast_shadows_setting(mode);
+			}
+		}
 	}
 }
 
@@ -375,6 +411,11 @@ void VoxelLodTerrain::_on_render_layers_mask_changed() {
 		_mesh_maps_per_lod[lod_index].for_each_block([mask](VoxelMeshBlockVLT &block) { //
 			block.set_render_layers_mask(mask);
 		});
+		for (auto it = _mesh_batches_per_lod[lod_index].begin(); it != _mesh_batches_per_lod[lod_index].end(); ++it) {
+			if (it->second.mesh_instance.is_valid()) {
+				it->second.mesh_instance.set_render_layers_mask(mask);
+			}
+		}
 	}
 }
 
@@ -384,6 +425,37 @@ void VoxelLodTerrain::update_shader_material_pool_template() {
 		shader_material = _mesher->get_default_lod_material();
 	}
 	_shader_material_pool.set_template(shader_material);
+
+	const VoxelStringNames &sn = VoxelStringNames::get_singleton();
+
+	// Detect presence of lod_index usage in the shader
+	Span<const StringName> uniforms = _shader_material_pool.get_cached_shader_uniforms();
+	_material_uses_lod_info = contains(uniforms, sn.u_voxel_lod_info);
+
+	_material_uses_instance_parameters = false;
+	Ref<ShaderMaterial> template_material = _shader_material_pool.get_template();
+	if (template_material.is_valid()) {
+		Ref<Shader> shader = template_material->get_shader();
+		if (shader.is_valid()) {
+			// Instance uniforms are not listed with other uniforms. They are searched in the code of the shader, so if
+			// they are declared in an included file, blocks fall back to using one material each.
+			_material_uses_lod_info |= shader_has_instance_uniform(**shader, sn.u_voxel_lod_info);
+			// Transition masks and fading are required. Other per-block parameters are optional, but can't be
+			// regular uniforms since the material would be shared.
+			_material_uses_instance_parameters = shader_has_instance_uniform(**shader, sn.u_transition_mask) &&
+					shader_has_instance_uniform(**shader, sn.u_lod_fade) &&
+					!contains(uniforms, sn.u_block_local_transform) && !contains(uniforms, sn.u_voxel_lod_info);
+		}
+	}
+}
+
+bool VoxelLodTerrain::needs_shader_material_per_block(unsigned int lod_index) const {
+	if (!_material_uses_instance_parameters) {
+		return true;
+	}
+	// Textures can't be instance uniforms
+	const DetailRenderingSettings &detail_settings = _update_data->settings.detail_texture_settings;
+	return detail_settings.enabled && lod_index >= detail_settings.begin_lod_index;
 }
 
 void VoxelLodTerrain::set_mesher(Ref<VoxelMesher> p_mesher) {
@@ -537,6 +609,7 @@ void VoxelLodTerrain::set_mesh_block_visual_active(
 
 	// TODO Shouldn't we switch colliders with `active` instead of `visible`?
 	block.visual_active = active;
+	mark_mesh_batch_dirty(block.position, lod_index);
 
 	if (!with_fading) {
 		block.set_visible(active);
@@ -547,19 +620,13 @@ void VoxelLodTerrain::set_mesh_block_visual_active(
 
 			_fading_blocks_per_lod[lod_index].erase(block.position);
 
-			Ref<ShaderMaterial> mat = block.get_shader_material();
-			if (mat.is_valid()) {
-				mat->set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, Vector2(0.0, 0.0));
-			}
+			block.set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, Vector2(0.0, 0.0));
 
 		} else if (active && _lod_fade_duration > 0.f) {
 			// WHen LOD fade is enabled, it is possible that a block is disabled with a fade out, but later has to be
 			// enabled without a fade-in (because behind the camera for example). In this case we have to reset the
 			// parameter. Otherwise, it would be active but invisible due to still being faded out.
-			Ref<ShaderMaterial> mat = block.get_shader_material();
-			if (mat.is_valid()) {
-				mat->set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, Vector2(0.0, 0.0));
-			}
+			block.set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, Vector2(0.0, 0.0));
 		}
 
 		return;
@@ -862,11 +929,19 @@ void VoxelLodTerrain::reset_maps() {
 	abort_async_edits();
 
 	reset_mesh_maps();
+
+	// Blocks other volumes got from the generator might no longer match what this one expects
+	Ref<VoxelGenerator> generator = get_generator();
+	if (generator.is_valid()) {
+		generator->get_block_cache().clear();
+	}
 }
 
 void VoxelLodTerrain::reset_mesh_maps() {
 	_update_data->wait_for_end_of_task();
 
+	clear_mesh_batches();
+
 	const unsigned int lod_count = get_lod_count();
 	VoxelLodTerrainUpdateData::State &state = _update_data->state;
 
@@ -903,10 +978,13 @@ void VoxelLodTerrain::reset_mesh_maps() {
 		lod.mesh_blocks_to_deactivate_collision.clear();
 		lod.mesh_blocks_to_unload.clear();
 		lod.mesh_blocks_to_update_transitions.clear();
+		lod.reused_mesh_outputs.clear();
 
 		_deferred_collision_updates_per_lod[lod_index].clear();
 	}
 
+	state.mesh_cache.clear();
+
 	// Reset LOD octrees
 	LodOctree::NoDestroyAction nda;
 	for (StdMap<Vector3i, VoxelLodTerrainUpdateData::OctreeItem>::iterator it =
@@ -931,6 +1009,8 @@ int VoxelLodTerrain::get_lod_count() const {
 
 void VoxelLodTerrain::set_generate_collisions(bool enabled) {
 	_update_data->settings.collision_enabled = enabled;
+	// Cached meshes only have collision surfaces if they were generated with collisions enabled
+	_update_data->state.mesh_cache.clear();
 }
 
 bool VoxelLodTerrain::get_generate_collisions() const {
@@ -1073,6 +1153,7 @@ void VoxelLodTerrain::_notification(int p_what) {
 					block.set_world(world);
 				});
 			}
+			set_mesh_batches_world(is_visible() ? world : nullptr);
 #ifdef TOOLS_ENABLED
 			if (debug_is_draw_enabled()) {
 				_debug_renderer.set_world(is_visible_in_tree() ? world : nullptr);
@@ -1090,6 +1171,7 @@ void VoxelLodTerrain::_notification(int p_what) {
 					block.set_world(nullptr);
 				});
 			}
+			set_mesh_batches_world(nullptr);
 #ifdef TOOLS_ENABLED
 			_debug_renderer.set_world(nullptr);
 #endif
@@ -1105,6 +1187,7 @@ void VoxelLodTerrain::_notification(int p_what) {
 					block.set_parent_visible(visible);
 				});
 			}
+			set_mesh_batches_world(visible ? *get_world_3d() : nullptr);
 
 #ifdef TOOLS_ENABLED
 			if (debug_is_draw_enabled()) {
@@ -1132,6 +1215,16 @@ void VoxelLodTerrain::_notification(int p_what) {
 				mesh_map.for_each_block([&transform](VoxelMeshBlockVLT &block) { //
 					block.set_parent_transform(transform);
 				});
+
+				const int batch_size = get_mesh_block_size() << (lod_index + 1);
+				StdUnorderedMap<Vector3i, MeshBatchVLT> &batches = _mesh_batches_per_lod[lod_index];
+				for (auto it = batches.begin(); it != batches.end(); ++it) {
+					MeshBatchVLT &batch = it->second;
+					if (batch.mesh_instance.is_valid()) {
+						batch.mesh_instance.set_transform(
+								transform * Transform3D(Basis(), to_vec3(it->first * batch_size)));
+					}
+				}
 			}
 
 			for (FadingOutMesh &item : _fading_out_meshes) {
@@ -1253,6 +1346,9 @@ void VoxelLodTerrain::process(float delta) {
 
 	// Do it after we change mesh block states so materials are updated
 	process_fading_blocks(delta);
+
+	// Do it after fading, so blocks that finished fading can be batched
+	process_mesh_batches();
 }
 
 void VoxelLodTerrain::apply_main_thread_update_tasks() {
@@ -1373,6 +1469,7 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 			}
 			block->drop_visuals();
 			remove_shader_material_from_block(*block, _shader_material_pool);
+			mark_mesh_batch_dirty(bpos, lod_index);
 			// Also update the state in the threaded representation
 			auto it = lod.mesh_map_state.map.find(bpos);
 			if (it != lod.mesh_map_state.map.end()) {
@@ -1423,7 +1520,7 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 					if (mesh_block != nullptr && mesh_block->is_visible()) {
 						Ref<ShaderMaterial> shader_material = mesh_block->get_shader_material();
 
-						if (shader_material.is_valid()) {
+						if (shader_material.is_valid() || mesh_block->is_using_instance_shader_parameters()) {
 							FadingOutMesh item;
 
 							item.local_position = mesh_block->position * mesh_block_size;
@@ -1452,17 +1549,26 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 							// TODO Do we actually have to instantiate a material? We could just re-use the one from the
 							// block, since it gets removed and no change occurs in that material (contrary to
 							// transition mask changes)
-							item.shader_material = _shader_material_pool.allocate();
-							ZN_ASSERT(item.shader_material.is_valid());
-							zylann::godot::copy_shader_params(**shader_material, **item.shader_material,
-									_shader_material_pool.get_cached_shader_uniforms());
+							if (shader_material.is_valid()) {
+								item.shader_material = _shader_material_pool.allocate();
+								ZN_ASSERT(item.shader_material.is_valid());
+								zylann::godot::copy_shader_params(**shader_material, **item.shader_material,
+										_shader_material_pool.get_cached_shader_uniforms());
+							}
 
 							item.mesh_instance.create();
 							item.mesh_instance.set_mesh(mesh_block->get_mesh());
 							item.mesh_instance.set_gi_mode(get_gi_mode());
 							item.mesh_instance.set_transform(
 									volume_transform * Transform3D(Basis(), item.local_position));
-							item.mesh_instance.set_material_override(item.shader_material);
+							if (item.shader_material.is_valid()) {
+								item.mesh_instance.set_material_override(item.shader_material);
+							} else {
+								item.mesh_instance.set_material_override(_shader_material_pool.get_template());
+							}
+							if (mesh_block->is_using_instance_shader_parameters()) {
+								mesh_block->apply_instance_shader_parameters(item.mesh_instance);
+							}
 							item.mesh_instance.set_world(*get_world_3d());
 							// TODO What if the terrain is hidden?
 							item.mesh_instance.set_visible(true);
@@ -1478,6 +1584,7 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 			}
 
 			mesh_map.remove_block(bpos, BeforeUnloadMeshAction{ _shader_material_pool });
+			mark_mesh_batch_dirty(bpos, lod_index);
 
 			if (_instancer != nullptr) {
 				_instancer->on_mesh_block_exit(bpos, lod_index);
@@ -1516,7 +1623,8 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 				// Fade stitching transitions to avoid cracks.
 				// This is done by triggering a fade-in on the block, while a copy of it fades out with the previous
 				// material settings. This causes a bit of overdraw, but LOD fading does anyways.
-				if (_lod_fade_duration > 0.f && shader_material.is_valid() &&
+				if (_lod_fade_duration > 0.f &&
+						(shader_material.is_valid() || block->is_using_instance_shader_parameters()) &&
 						activated_visual_blocks.find(block) == activated_visual_blocks.end() &&
 						tu.transition_mask != block->get_transition_mask()) {
 					//
@@ -1533,10 +1641,12 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 						// Wayyyy too slow, initially because of https://github.com/godotengine/godot/issues/34741
 						// but also generally slow because of how `duplicate` is implemented
 						// item.shader_material = shader_material->duplicate(false);
-						item.shader_material = _shader_material_pool.allocate();
-						ZN_ASSERT(item.shader_material.is_valid());
-						zylann::godot::copy_shader_params(**shader_material, **item.shader_material,
-								_shader_material_pool.get_cached_shader_uniforms());
+						if (shader_material.is_valid()) {
+							item.shader_material = _shader_material_pool.allocate();
+							ZN_ASSERT(item.shader_material.is_valid());
+							zylann::godot::copy_shader_params(**shader_material, **item.shader_material,
+									_shader_material_pool.get_cached_shader_uniforms());
+						}
 
 						// item.shader_material->set_shader_param(
 						// 		VoxelStringNames::get_singleton().u_lod_fade, Vector2(item.progress, 0.f));
@@ -1545,7 +1655,15 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 						item.mesh_instance.set_mesh(block->get_mesh());
 						item.mesh_instance.set_gi_mode(get_gi_mode());
 						item.mesh_instance.set_transform(volume_transform * Transform3D(Basis(), item.local_position));
-						item.mesh_instance.set_material_override(item.shader_material);
+						if (item.shader_material.is_valid()) {
+							item.mesh_instance.set_material_override(item.shader_material);
+						} else {
+							item.mesh_instance.set_material_override(_shader_material_pool.get_template());
+						}
+						if (block->is_using_instance_shader_parameters()) {
+							// Parameters are captured before the transition mask changes
+							block->apply_instance_shader_parameters(item.mesh_instance);
+						}
 						item.mesh_instance.set_world(*get_world_3d());
 						item.mesh_instance.set_visible(true);
 
@@ -1559,10 +1677,23 @@ void VoxelLodTerrain::apply_main_thread_update_tasks() {
 					}
 				}
 
+				if (tu.transition_mask != block->get_transition_mask()) {
+					mark_mesh_batch_dirty(block->position, lod_index);
+				}
 				block->set_transition_mask(tu.transition_mask);
 			}
 		}
 
+		if (lod.reused_mesh_outputs.size() > 0) {
+			// Cached meshes go through the same path as results of meshing tasks
+			const VoxelEngine::VolumeCallbacks callbacks =
+					VoxelEngine::get_singleton().get_volume_callbacks(get_volume_id());
+			for (VoxelEngine::BlockMeshOutput &ob : lod.reused_mesh_outputs) {
+				callbacks.mesh_output_callback(callbacks.data, ob);
+			}
+			lod.reused_mesh_outputs.clear();
+		}
+
 		lod.mesh_blocks_to_unload.clear();
 		lod.mesh_blocks_to_update_transitions.clear();
 
@@ -1743,6 +1874,7 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 	bool first_visual_load = false;
 	bool visual_expected = false;
 	bool collision_expected = false;
+	bool became_up_to_date = false;
 	{
 		VoxelLodTerrainUpdateData::Lod &lod = update_data.state.lods[ob.lod];
 		RWLockRead rlock(lod.mesh_map_state.map_lock);
@@ -1768,7 +1900,8 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 		// The state can become "up to date" only if no other unsent update was pending.
 		VoxelLodTerrainUpdateData::MeshState expected = VoxelLodTerrainUpdateData::MESH_UPDATE_SENT;
 		// TODO We need to separate visuals from collider
-		mesh_block_state.state.compare_exchange_strong(expected, VoxelLodTerrainUpdateData::MESH_UP_TO_DATE);
+		became_up_to_date =
+				mesh_block_state.state.compare_exchange_strong(expected, VoxelLodTerrainUpdateData::MESH_UP_TO_DATE);
 		visual_active = mesh_block_state.visual_active;
 		collision_active = mesh_block_state.collision_active;
 
@@ -1822,6 +1955,18 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 		}
 	}
 
+	if (became_up_to_date && ob.visual_was_required && visual_expected &&
+			update_data.state.mesh_cache.get_capacity() > 0) {
+		// Keep the result in case the block gets requested again while its voxels remain the same.
+		// Surface arrays are shared, and the mesh resource will not have to be built again.
+		VoxelEngine::BlockMeshOutput cached_output = ob;
+		cached_output.mesh = mesh;
+		cached_output.has_mesh_resource = true;
+		// The revision was obtained when the task was scheduled. If voxels got edited since then, the result may be
+		// outdated even if the block is considered up to date, so it won't be cached.
+		update_data.state.mesh_cache.put(std::move(cached_output), ob.mesh_cache_revision);
+	}
+
 	// TODO We could simplify this by having a flag returned by MeshTask saying it's actually empty
 	if (mesh.is_null() && voxel::is_mesh_empty(to_span(ob.surfaces.surfaces)) &&
 			ob.surfaces.collision_surface.indices.size() == 0) {
@@ -1830,6 +1975,7 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 			// No surface anymore in this block, destroy it
 			// TODO Factor removal in a function, it's done in a few places
 			mesh_map.remove_block(ob.position, BeforeUnloadMeshAction{ _shader_material_pool });
+			mark_mesh_batch_dirty(ob.position, ob.lod);
 
 			if (_instancer != nullptr) {
 				_instancer->on_mesh_block_exit(ob.position, ob.lod);
@@ -1857,7 +2003,8 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 			// unexpectedly generate instances on it
 
 			// We would have to know if specific voxels got edited, or different from the generator
-			_instancer->on_mesh_block_enter(ob.position, ob.lod, ob.surfaces.surfaces[0].arrays);
+			_instancer->on_mesh_block_enter(
+					ob.position, ob.lod, ob.surfaces.surfaces[0].arrays, to_span_const(ob.generated_instances));
 		}
 
 		block->set_collision_enabled(collision_active);
@@ -1885,25 +2032,34 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 			// set_mesh_block_active(*block, false);
 			block->set_parent_visible(is_visible());
 
-			if (_shader_material_pool.get_template().is_valid() && block->get_shader_material().is_null()) {
-				ZN_PROFILE_SCOPE_NAMED("Add ShaderMaterial");
-
-				// Pooling shader materials is necessary for now, to avoid stuttering in the editor.
-				// Due to a signal used to keep the inspector up to date, even though these
-				// material copies will never be seen in the inspector
-				// See https://github.com/godotengine/godot/issues/34741
-				Ref<ShaderMaterial> sm = _shader_material_pool.allocate();
+			if (_shader_material_pool.get_template().is_valid()) {
+				if (_material_uses_instance_parameters) {
+					// Dynamic parameters are set on mesh instances, the material can be shared
+					block->set_use_instance_shader_parameters(true);
+					block->set_shared_material(_shader_material_pool.get_template());
+				}
 
-				if (sm.is_valid() && _material_uses_lod_info) {
+				if (_material_uses_lod_info) {
 					// This is mainly for debugging purposes
 					const int lod_count = get_lod_count();
-					sm->set_shader_parameter(VoxelStringNames::get_singleton().u_voxel_lod_info,
+					block->set_shader_parameter(VoxelStringNames::get_singleton().u_voxel_lod_info,
 							encode_lod_info_for_shader_uniform(ob.lod, lod_count));
 				}
 
-				// Set individual shader material, because each block can have dynamic parameters,
-				// used to smooth seams without re-uploading meshes and allow to implement LOD fading
-				block->set_shader_material(sm);
+				if (block->get_shader_material().is_null() && needs_shader_material_per_block(ob.lod)) {
+					ZN_PROFILE_SCOPE_NAMED("Add ShaderMaterial");
+
+					// Pooling shader materials is necessary for now, to avoid stuttering in the editor.
+					// Due to a signal used to keep the inspector up to date, even though these
+					// material copies will never be seen in the inspector
+					// See https://github.com/godotengine/godot/issues/34741
+					Ref<ShaderMaterial> sm = _shader_material_pool.allocate();
+
+					// Set individual shader material, because each block can have dynamic parameters,
+					// used to smooth seams without re-uploading meshes and allow to implement LOD fading.
+					// Parameters previously set on the block are applied to it.
+					block->set_shader_material(sm);
+				}
 			}
 
 			block->set_transition_mask(transition_mask);
@@ -1911,6 +2067,17 @@ void VoxelLodTerrain::apply_mesh_update(VoxelEngine::BlockMeshOutput &ob) {
 
 		block->set_mesh(mesh, get_gi_mode(), RenderingServer::ShadowCastingSetting(get_shadow_casting()),
 				get_render_layers_mask());
+
+		if (is_mesh_batching_lod(ob.lod) && mesh_data.primitive_type == Mesh::PRIMITIVE_TRIANGLES) {
+			// Keep surfaces around so the block can be merged with its siblings
+			block->batchable_mesh = true;
+			block->batch_surfaces = mesh_data.surfaces;
+			block->batch_mesh_flags = mesh_data.mesh_flags;
+		} else {
+			block->batchable_mesh = false;
+			block->batch_surfaces.clear();
+		}
+		mark_mesh_batch_dirty(ob.position, ob.lod);
 	}
 
 	// TODO Remove this eventually, we no longer use separate transition mesh instances
@@ -2094,6 +2261,12 @@ void VoxelLodTerrain::apply_detail_texture_update_to_block(
 	}
 
 	Ref<ShaderMaterial> material = block.get_shader_material();
+	if (material.is_null() && _material_uses_instance_parameters && _shader_material_pool.get_template().is_valid()) {
+		// The block was sharing its material, but textures can't be instance uniforms so it needs its own copy.
+		// Parameters previously set on the block are applied to it.
+		material = _shader_material_pool.allocate();
+		block.set_shader_material(material);
+	}
 	if (material.is_valid()) {
 		const VoxelStringNames &sn = VoxelStringNames::get_singleton();
 
@@ -2227,6 +2400,7 @@ void VoxelLodTerrain::process_fading_blocks(float delta) {
 				const bool finished = block->update_fading(speed);
 
 				if (finished) {
+					mark_mesh_batch_dirty(block->position, lod_index);
 					// `erase` returns the next iterator
 					it = fading_blocks.erase(it);
 
@@ -2245,7 +2419,9 @@ void VoxelLodTerrain::process_fading_blocks(float delta) {
 			item.progress -= speed;
 			if (item.progress <= 0.f) {
 				FreeMeshTask::try_add_and_destroy(item.mesh_instance);
-				_shader_material_pool.recycle(item.shader_material);
+				if (item.shader_material.is_valid()) {
+					_shader_material_pool.recycle(item.shader_material);
+				}
 				// TODO Optimize: mesh instances destroyed here can be really slow due to materials...
 				// Profiling has shown that `RendererSceneCull::free` of a mesh instance
 				// leads to `RendererRD::MaterialStorage::_update_queued_materials()` to be called, which internally
@@ -2256,8 +2432,13 @@ void VoxelLodTerrain::process_fading_blocks(float delta) {
 				_fading_out_meshes[i] = std::move(_fading_out_meshes.back());
 				_fading_out_meshes.pop_back();
 			} else {
-				item.shader_material->set_shader_parameter(
-						VoxelStringNames::get_singleton().u_lod_fade, Vector2(1.f - item.progress, 0.f));
+				const Vector2 lod_fade(1.f - item.progress, 0.f);
+				if (_material_uses_instance_parameters) {
+					item.mesh_instance.set_shader_instance_parameter(
+							VoxelStringNames::get_singleton().u_lod_fade, lod_fade);
+				} else if (item.shader_material.is_valid()) {
+					item.shader_material->set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, lod_fade);
+				}
 				++i;
 			}
 		}
@@ -2296,6 +2477,316 @@ void VoxelLodTerrain::process_fading_blocks(float delta) {
 	}
 }
 
+bool VoxelLodTerrain::is_mesh_batching_lod(unsigned int lod_index) const {
+	if (!_mesh_batching_enabled || lod_index < _mesh_batching_begin_lod_index) {
+		return false;
+	}
+	// Detail normalmaps are specific to each block, batches can't use them
+	const DetailRenderingSettings &detail_settings = _update_data->settings.detail_texture_settings;
+	return !(detail_settings.enabled && lod_index >= detail_settings.begin_lod_index);
+}
+
+void VoxelLodTerrain::mark_mesh_batch_dirty(Vector3i mesh_block_position, unsigned int lod_index) {
+	if (!_mesh_batching_enabled) {
+		return;
+	}
+	StdUnorderedMap<Vector3i, MeshBatchVLT> &batches = _mesh_batches_per_lod[lod_index];
+	const Vector3i batch_position = mesh_block_position >> 1;
+	// Existing batches have to be split even if the LOD is no longer batched
+	if (is_mesh_batching_lod(lod_index) || batches.find(batch_position) != batches.end()) {
+		_dirty_mesh_batches_per_lod[lod_index].insert(batch_position);
+	}
+}
+
+void VoxelLodTerrain::process_mesh_batches() {
+	ZN_PROFILE_SCOPE();
+
+	const unsigned int lod_count = get_lod_count();
+
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		StdUnorderedSet<Vector3i> &dirty_batches = _dirty_mesh_batches_per_lod[lod_index];
+		for (const Vector3i batch_position : dirty_batches) {
+			update_mesh_batch(batch_position, lod_index);
+		}
+		dirty_batches.clear();
+	}
+
+	// Results are applied after dirty batches were updated, so outdated ones get discarded
+	static thread_local StdVector<MeshBatchTaskOutputVLT> tls_results;
+	StdVector<MeshBatchTaskOutputVLT> &results = tls_results;
+	{
+		MutexLock mlock(_mesh_batch_results->mutex);
+		StdVector<MeshBatchTaskOutputVLT> &src = _mesh_batch_results->results;
+		results.resize(src.size());
+		for (unsigned int i = 0; i < src.size(); ++i) {
+			results[i] = std::move(src[i]);
+		}
+		src.clear();
+	}
+
+	for (MeshBatchTaskOutputVLT &o : results) {
+		apply_mesh_batch_result(o);
+	}
+	results.clear();
+}
+
+void VoxelLodTerrain::update_mesh_batch(Vector3i batch_position, unsigned int lod_index) {
+	ZN_PROFILE_SCOPE();
+
+	VoxelMeshMap<VoxelMeshBlockVLT> &mesh_map = _mesh_maps_per_lod[lod_index];
+	StdUnorderedMap<Vector3i, MeshBatchVLT> &batches = _mesh_batches_per_lod[lod_index];
+	const Vector3i origin_bpos = MeshBatchVLT::get_origin_block_position(batch_position);
+
+	FixedArray<VoxelMeshBlockVLT *, 8> members;
+	fill(members, static_cast<VoxelMeshBlockVLT *>(nullptr));
+	uint8_t members_mask = 0;
+	unsigned int member_count = 0;
+	bool batchable = is_mesh_batching_lod(lod_index);
+	uint32_t mesh_flags = 0;
+
+	for (unsigned int i = 0; i < members.size(); ++i) {
+		const Vector3i bpos = origin_bpos + Vector3i(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+		VoxelMeshBlockVLT *block = mesh_map.get_block(bpos);
+		if (block == nullptr || !block->has_mesh()) {
+			continue;
+		}
+		members[i] = block;
+		members_mask |= (1 << i);
+
+		// Only merge blocks in a stable state. Transitions, fading and hidden blocks require individual instances.
+		if (!block->visual_active || !block->is_visible() || block->fading_state != VoxelMeshBlockVLT::FADING_NONE ||
+				block->get_transition_mask() != 0 || !block->batchable_mesh ||
+				(member_count > 0 && block->batch_mesh_flags != mesh_flags)) {
+			batchable = false;
+		}
+		mesh_flags = block->batch_mesh_flags;
+		++member_count;
+	}
+
+	if (member_count < 2) {
+		// Nothing to gain
+		batchable = false;
+	}
+
+	auto batch_it = batches.find(batch_position);
+	if (batch_it != batches.end()) {
+		// Members changed, split the batch. If still batchable, it will be shown again when the new merged mesh is
+		// ready.
+		MeshBatchVLT &batch = batch_it->second;
+		for (VoxelMeshBlockVLT *block : members) {
+			if (block != nullptr) {
+				block->set_batched(false);
+			}
+		}
+		if (!batchable) {
+			destroy_mesh_batch(batch, batch_position, lod_index);
+			batches.erase(batch_it);
+			return;
+		}
+		if (batch.active) {
+			batch.active = false;
+			batch.mesh_instance.set_world(nullptr);
+		}
+		++batch.version;
+	}
+
+	if (!batchable) {
+		return;
+	}
+
+	for (VoxelMeshBlockVLT *block : members) {
+		if (block != nullptr && are_mesh_block_surfaces_released(to_span(block->batch_surfaces))) {
+			// Surfaces were merged in a previous version of the batch
+			Ref<Mesh> mesh = block->get_mesh();
+			ZN_ASSERT_RETURN(mesh.is_valid());
+			ZN_ASSERT_RETURN(reload_mesh_block_surfaces(**mesh, block->batch_surfaces));
+		}
+	}
+
+	MeshBatchVLT &batch = batches[batch_position];
+	batch.pending = true;
+
+	const int block_size = get_mesh_block_size() << lod_index;
+
+	MeshBatchTaskVLT *task = ZN_NEW(MeshBatchTaskVLT);
+	task->batch_position = batch_position;
+	task->lod_index = lod_index;
+	task->members_mask = members_mask;
+	task->version = batch.version;
+	task->mesh_flags = mesh_flags;
+	task->output_queue = _mesh_batch_results;
+	task->members.reserve(member_count);
+	for (unsigned int i = 0; i < members.size(); ++i) {
+		const VoxelMeshBlockVLT *block = members[i];
+		if (block != nullptr) {
+			const Vector3 offset = to_vec3((block->position - origin_bpos) * block_size);
+			task->members.push_back(MeshBatchTaskVLT::Member{ block->batch_surfaces, offset });
+		}
+	}
+
+	VoxelEngine::get_singleton().push_async_task(task);
+}
+
+void VoxelLodTerrain::apply_mesh_batch_result(MeshBatchTaskOutputVLT &o) {
+	ZN_PROFILE_SCOPE();
+
+	if (o.lod_index >= get_lod_count()) {
+		return;
+	}
+	StdUnorderedMap<Vector3i, MeshBatchVLT> &batches = _mesh_batches_per_lod[o.lod_index];
+	auto batch_it = batches.find(o.batch_position);
+	if (batch_it == batches.end()) {
+		// Got split since
+		return;
+	}
+	MeshBatchVLT &batch = batch_it->second;
+	if (batch.version != o.version) {
+		// Members changed since, a more recent task was scheduled
+		return;
+	}
+	batch.pending = false;
+
+	Ref<ArrayMesh> mesh;
+	if (o.has_mesh_resource) {
+		mesh = o.mesh;
+		if (mesh.is_valid()) {
+			const unsigned int surface_count = mesh->get_surface_count();
+			for (unsigned int surface_index = 0; surface_index < surface_count; ++surface_index) {
+				mesh->surface_set_material(surface_index, _material);
+			}
+		}
+	} else {
+		mesh = build_mesh(to_span_const(o.surfaces), Mesh::PRIMITIVE_TRIANGLES, o.mesh_flags, _material);
+	}
+
+	if (mesh.is_null()) {
+		// Members were not empty, so merging must have failed
+		destroy_mesh_batch(batch, o.batch_position, o.lod_index);
+		batches.erase(batch_it);
+		return;
+	}
+
+	const int batch_size = get_mesh_block_size() << (o.lod_index + 1);
+	const Transform3D local_transform(Basis(), to_vec3(o.batch_position * batch_size));
+
+	if (!batch.mesh_instance.is_valid()) {
+		batch.mesh_instance.create();
+		batch.mesh_instance.set_gi_mode(get_gi_mode());
+		batch.mesh_instance.set_cast_shadows_setting(RenderingServer::ShadowCastingSetting(get_shadow_casting()));
+		batch.mesh_instance.set_render_layers_mask(get_render_layers_mask());
+		batch.mesh_instance.set_transform(get_global_transform() * local_transform);
+	}
+
+	const VoxelStringNames &sn = VoxelStringNames::get_singleton();
+
+	if (_material_uses_instance_parameters) {
+		// Batches are never at LODs using detail textures, so the material can be shared
+		batch.mesh_instance.set_shader_instance_parameter(sn.u_block_local_transform, local_transform);
+		if (_material_uses_lod_info) {
+			batch.mesh_instance.set_shader_instance_parameter(
+					sn.u_voxel_lod_info, encode_lod_info_for_shader_uniform(o.lod_index, get_lod_count()));
+		}
+
+	} else if (batch.shader_material.is_null() && _shader_material_pool.get_template().is_valid()) {
+		batch.shader_material = _shader_material_pool.allocate();
+		ZN_ASSERT(batch.shader_material.is_valid());
+		batch.shader_material->set_shader_parameter(sn.u_block_local_transform, local_transform);
+		if (_material_uses_lod_info) {
+			batch.shader_material->set_shader_parameter(
+					sn.u_voxel_lod_info, encode_lod_info_for_shader_uniform(o.lod_index, get_lod_count()));
+		}
+	}
+
+	batch.mesh_instance.set_mesh(mesh);
+	if (batch.shader_material.is_valid()) {
+		batch.mesh_instance.set_material_override(batch.shader_material);
+	} else if (_material_uses_instance_parameters) {
+		batch.mesh_instance.set_material_override(_shader_material_pool.get_template());
+	}
+
+	// Hide members and show the batch in the same frame
+	VoxelMeshMap<VoxelMeshBlockVLT> &mesh_map = _mesh_maps_per_lod[o.lod_index];
+	const Vector3i origin_bpos = MeshBatchVLT::get_origin_block_position(o.batch_position);
+	for (unsigned int i = 0; i < 8; ++i) {
+		if ((o.members_mask & (1 << i)) == 0) {
+			continue;
+		}
+		VoxelMeshBlockVLT *block = mesh_map.get_block(origin_bpos + Vector3i(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+		// Any change of members should have increased the version
+		ZN_ASSERT_CONTINUE(block != nullptr);
+		block->set_batched(true);
+		// The batch has its own copy now
+		release_mesh_block_surfaces(block->batch_surfaces);
+	}
+
+	batch.members_mask = o.members_mask;
+	batch.active = true;
+	batch.mesh_instance.set_world(is_inside_tree() && is_visible() ? *get_world_3d() : nullptr);
+}
+
+void VoxelLodTerrain::destroy_mesh_batch(MeshBatchVLT &batch, Vector3i batch_position, unsigned int lod_index) {
+	VoxelMeshMap<VoxelMeshBlockVLT> &mesh_map = _mesh_maps_per_lod[lod_index];
+	const Vector3i origin_bpos = MeshBatchVLT::get_origin_block_position(batch_position);
+	for (unsigned int i = 0; i < 8; ++i) {
+		VoxelMeshBlockVLT *block = mesh_map.get_block(origin_bpos + Vector3i(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+		if (block != nullptr) {
+			block->set_batched(false);
+		}
+	}
+
+	if (batch.mesh_instance.is_valid()) {
+		// Same reason as for mesh blocks, the material must not be destroyed before the instance
+		batch.mesh_instance.set_material_override(Ref<Material>());
+	}
+	FreeMeshTask::try_add_and_destroy(batch.mesh_instance);
+
+	if (batch.shader_material.is_valid()) {
+		_shader_material_pool.recycle(batch.shader_material);
+		batch.shader_material.unref();
+	}
+}
+
+void VoxelLodTerrain::clear_mesh_batches() {
+	for (unsigned int lod_index = 0; lod_index < _mesh_batches_per_lod.size(); ++lod_index) {
+		StdUnorderedMap<Vector3i, MeshBatchVLT> &batches = _mesh_batches_per_lod[lod_index];
+		for (auto it = batches.begin(); it != batches.end(); ++it) {
+			destroy_mesh_batch(it->second, it->first, lod_index);
+		}
+		batches.clear();
+		_dirty_mesh_batches_per_lod[lod_index].clear();
+	}
+	// Pending results will be dropped since their batches no longer exist
+}
+
+void VoxelLodTerrain::reset_mesh_batches() {
+	clear_mesh_batches();
+
+	const unsigned int lod_count = get_lod_count();
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		if (!is_mesh_batching_lod(lod_index)) {
+			continue;
+		}
+		StdUnorderedSet<Vector3i> &dirty_batches = _dirty_mesh_batches_per_lod[lod_index];
+		_mesh_maps_per_lod[lod_index].for_each_block([&dirty_batches](VoxelMeshBlockVLT &block) {
+			if (block.has_mesh()) {
+				dirty_batches.insert(block.position >> 1);
+			}
+		});
+	}
+}
+
+void VoxelLodTerrain::set_mesh_batches_world(World3D *world) {
+	for (unsigned int lod_index = 0; lod_index < _mesh_batches_per_lod.size(); ++lod_index) {
+		StdUnorderedMap<Vector3i, MeshBatchVLT> &batches = _mesh_batches_per_lod[lod_index];
+		for (auto it = batches.begin(); it != batches.end(); ++it) {
+			MeshBatchVLT &batch = it->second;
+			if (batch.active && batch.mesh_instance.is_valid()) {
+				batch.mesh_instance.set_world(world);
+			}
+		}
+	}
+}
+
 VoxelLodTerrain::LocalCameraInfo VoxelLodTerrain::get_local_camera_info() const {
 	LocalCameraInfo info;
 	if (!is_inside_tree()) {
@@ -2467,6 +2958,8 @@ void VoxelLodTerrain::restart_stream() {
 void VoxelLodTerrain::remesh_all_blocks() {
 	// Requests a new mesh for all mesh blocks, without dropping everything first
 	_update_data->wait_for_end_of_task();
+	// Cached meshes would be outdated too
+	_update_data->state.mesh_cache.clear();
 	const unsigned int lod_count = get_lod_count();
 	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
 		VoxelLodTerrainUpdateData::Lod &lod = _update_data->state.lods[lod_index];
@@ -2563,8 +3056,59 @@ float VoxelLodTerrain::get_lod_fade_duration() const {
 	return _lod_fade_duration;
 }
 
+void VoxelLodTerrain::set_mesh_batching_enabled(bool enabled) {
+	if (enabled == _mesh_batching_enabled) {
+		return;
+	}
+	_mesh_batching_enabled = enabled;
+	clear_mesh_batches();
+
+	if (enabled) {
+		// Blocks only keep a copy of their surfaces when batching applies to them, so they have to be remeshed
+		remesh_all_blocks();
+	} else {
+		for (unsigned int lod_index = 0; lod_index < _mesh_maps_per_lod.size(); ++lod_index) {
+			_mesh_maps_per_lod[lod_index].for_each_block([](VoxelMeshBlockVLT &block) { //
+				block.batchable_mesh = false;
+				block.batch_surfaces.clear();
+			});
+		}
+	}
+}
+
+bool VoxelLodTerrain::is_mesh_batching_enabled() const {
+	return _mesh_batching_enabled;
+}
+
+void VoxelLodTerrain::set_mesh_batching_begin_lod_index(int lod_index) {
+	ERR_FAIL_INDEX(lod_index, int(constants::MAX_LOD));
+	if (lod_index == _mesh_batching_begin_lod_index) {
+		return;
+	}
+	_mesh_batching_begin_lod_index = lod_index;
+	reset_mesh_batches();
+	if (_mesh_batching_enabled) {
+		remesh_all_blocks();
+	}
+}
+
+int VoxelLodTerrain::get_mesh_batching_begin_lod_index() const {
+	return _mesh_batching_begin_lod_index;
+}
+
+void VoxelLodTerrain::set_mesh_cache_capacity(int capacity) {
+	ERR_FAIL_COND(capacity < 0);
+	_update_data->state.mesh_cache.set_capacity(capacity);
+}
+
+int VoxelLodTerrain::get_mesh_cache_capacity() const {
+	return _update_data->state.mesh_cache.get_capacity();
+}
+
 void VoxelLodTerrain::set_normalmap_enabled(bool enable) {
 	_update_data->settings.detail_texture_settings.enabled = enable;
+	// Affects which LODs can be batched
+	reset_mesh_batches();
 }
 
 bool VoxelLodTerrain::is_normalmap_enabled() const {
@@ -2590,6 +3134,8 @@ int VoxelLodTerrain::get_normalmap_tile_resolution_max() const {
 void VoxelLodTerrain::set_normalmap_begin_lod_index(int lod_index) {
 	ERR_FAIL_INDEX(lod_index, int(constants::MAX_LOD));
 	_update_data->settings.detail_texture_settings.begin_lod_index = lod_index;
+	// Affects which LODs can be batched
+	reset_mesh_batches();
 }
 
 int VoxelLodTerrain::get_normalmap_begin_lod_index() const {
@@ -2700,11 +3246,12 @@ void VoxelLodTerrain::get_configuration_warnings(PackedStringArray &warnings) co
 			} else {
 				Ref<Shader> shader = shader_material->get_shader();
 				if (shader.is_valid()) {
-					if (!shader_has_uniform(**shader, VoxelStringNames::get_singleton().u_transition_mask)) {
+					const StringName &uniform_name = VoxelStringNames::get_singleton().u_transition_mask;
+					if (!shader_has_uniform(**shader, uniform_name) &&
+							!shader_has_instance_uniform(**shader, uniform_name)) {
 						warnings.append(ZN_TTR(
 								"The current mesher ({0}) requires to use shader with specific uniforms. Missing: {1}")
-												.format(varray(mesher->get_class(),
-														VoxelStringNames::get_singleton().u_transition_mask)));
+												.format(varray(mesher->get_class(), uniform_name)));
 					}
 				}
 			}
@@ -2721,10 +3268,12 @@ void VoxelLodTerrain::get_configuration_warnings(PackedStringArray &warnings) co
 					warnings.append(String("Lod fading is enabled but the current material is missing a shader.")
 											.format(varray(ShaderMaterial::get_class_static())));
 				} else {
-					if (!shader_has_uniform(**shader, VoxelStringNames::get_singleton().u_lod_fade)) {
+					const StringName &uniform_name = VoxelStringNames::get_singleton().u_lod_fade;
+					if (!shader_has_uniform(**shader, uniform_name) &&
+							!shader_has_instance_uniform(**shader, uniform_name)) {
 						warnings.append(ZN_TTR(
 								"Lod fading is enabled but it requires to use a specific shader uniform. Missing: {0}")
-												.format(varray(VoxelStringNames::get_singleton().u_lod_fade)));
+												.format(varray(uniform_name)));
 					}
 				}
 			}
@@ -3451,6 +4000,19 @@ void VoxelLodTerrain::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_lod_fade_duration"), &VoxelLodTerrain::get_lod_fade_duration);
 	ClassDB::bind_method(D_METHOD("set_lod_fade_duration", "seconds"), &VoxelLodTerrain::set_lod_fade_duration);
 
+	ClassDB::bind_method(
+			D_METHOD("set_mesh_batching_enabled", "enabled"), &VoxelLodTerrain::set_mesh_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_mesh_batching_enabled"), &VoxelLodTerrain::is_mesh_batching_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_mesh_batching_begin_lod_index", "lod_index"),
+			&VoxelLodTerrain::set_mesh_batching_begin_lod_index);
+	ClassDB::bind_method(
+			D_METHOD("get_mesh_batching_begin_lod_index"), &VoxelLodTerrain::get_mesh_batching_begin_lod_index);
+
+	ClassDB::bind_method(
+			D_METHOD("set_mesh_cache_capacity", "capacity"), &VoxelLodTerrain::set_mesh_cache_capacity);
+	ClassDB::bind_method(D_METHOD("get_mesh_cache_capacity"), &VoxelLodTerrain::get_mesh_cache_capacity);
+
 	ClassDB::bind_method(D_METHOD("set_lod_count", "lod_count"), &VoxelLodTerrain::set_lod_count);
 	ClassDB::bind_method(D_METHOD("get_lod_count"), &VoxelLodTerrain::get_lod_count);
 
@@ -3599,6 +4161,10 @@ void VoxelLodTerrain::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "secondary_lod_distance"), "set_secondary_lod_distance",
 			"get_secondary_lod_distance");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_fade_duration"), "set_lod_fade_duration", "get_lod_fade_duration");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "mesh_batching_enabled"), "set_mesh_batching_enabled",
+			"is_mesh_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "mesh_batching_begin_lod_index"), "set_mesh_batching_begin_lod_index",
+			"get_mesh_batching_begin_lod_index");
 
 	ADD_GROUP("Material", "");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "material", PROPERTY_HINT_RESOURCE_TYPE,
@@ -3648,6 +4214,8 @@ void VoxelLodTerrain::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_gpu_generation"), "set_generator_use_gpu", "get_generator_use_gpu");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "streaming_system", PROPERTY_HINT_ENUM, "Octree (legacy),Clipbox"),
 			"set_streaming_system", "get_streaming_system");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "mesh_cache_capacity", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"),
+			"set_mesh_cache_capacity", "get_mesh_cache_capacity");
 
 	ADD_GROUP("Debug Drawing", "debug_");
 
@@ -6,10 +6,12 @@
 #include "../../storage/voxel_data.h"
 #include "../../util/containers/std_map.h"
 #include "../../util/containers/std_unordered_map.h"
+#include "../../util/containers/std_unordered_set.h"
 #include "../../util/containers/std_vector.h"
 #include "../voxel_mesh_map.h"
 #include "../voxel_node.h"
 #include "lod_octree.h"
+#include "mesh_batch_vlt.h"
 #include "shader_material_pool_vlt.h"
 #include "voxel_lod_terrain_update_data.h"
 #include "voxel_mesh_block_vlt.h"
@@ -146,6 +148,19 @@ public:
 	void set_lod_fade_duration(float seconds);
 	float get_lod_fade_duration() const;
 
+	// Mesh batching
+
+	void set_mesh_batching_enabled(bool enabled);
+	bool is_mesh_batching_enabled() const;
+
+	void set_mesh_batching_begin_lod_index(int lod_index);
+	int get_mesh_batching_begin_lod_index() const;
+
+	// Mesh cache
+
+	void set_mesh_cache_capacity(int capacity);
+	int get_mesh_cache_capacity() const;
+
 	enum ProcessCallback { //
 		PROCESS_CALLBACK_IDLE = 0,
 		PROCESS_CALLBACK_PHYSICS,
@@ -302,12 +317,23 @@ private:
 	void _on_stream_params_changed();
 
 	void update_shader_material_pool_template();
+	bool needs_shader_material_per_block(unsigned int lod_index) const;
 
 	void save_all_modified_blocks(bool with_copy, std::shared_ptr<AsyncDependencyTracker> tracker);
 
 	void process_deferred_collision_updates(uint32_t timeout_msec);
 	void process_fading_blocks(float delta);
 
+	bool is_mesh_batching_lod(unsigned int lod_index) const;
+	void mark_mesh_batch_dirty(Vector3i mesh_block_position, unsigned int lod_index);
+	void process_mesh_batches();
+	void update_mesh_batch(Vector3i batch_position, unsigned int lod_index);
+	void apply_mesh_batch_result(MeshBatchTaskOutputVLT &o);
+	void destroy_mesh_batch(MeshBatchVLT &batch, Vector3i batch_position, unsigned int lod_index);
+	void clear_mesh_batches();
+	void reset_mesh_batches();
+	void set_mesh_batches_world(World3D *world);
+
 	struct LocalCameraInfo {
 		Vector3 position;
 		Vector3 forward;
@@ -341,10 +367,15 @@ private:
 
 	Ref<Material> _material;
 	bool _material_uses_lod_info = false;
+	// True if the shader declares per-block parameters as `instance uniform`. In that case they are set on mesh
+	// instances, which can then share the same material instead of each getting a copy from the pool.
+	bool _material_uses_instance_parameters = false;
 
 	// The main reason this pool even exists is because of this: https://github.com/godotengine/godot/issues/34741
 	// Blocks need individual shader parameters for several features,
 	// so a lot of ShaderMaterial copies using the same shader are created.
+	// If the shader uses instance uniforms, copies are only needed for parameters that can't be per-instance, such as
+	// detail textures.
 	// The terrain must be able to run in editor, but in that context, Godot connects a signal of Shader to
 	// every ShaderMaterial using it. Godot does that in order to update properties in THE inspector if the shader
 	// changes (which is debatable since only the edited material needs this, if it even is edited!).
@@ -391,6 +422,14 @@ private:
 
 	StdVector<FadingDetailTexture> _fading_detail_textures;
 
+	// Groups of sibling mesh blocks drawn with a single mesh instance at distant LODs
+	bool _mesh_batching_enabled = false;
+	uint8_t _mesh_batching_begin_lod_index = 2;
+	FixedArray<StdUnorderedMap<Vector3i, MeshBatchVLT>, constants::MAX_LOD> _mesh_batches_per_lod;
+	// Batches to re-evaluate because some of their members changed
+	FixedArray<StdUnorderedSet<Vector3i>, constants::MAX_LOD> _dirty_mesh_batches_per_lod;
+	std::shared_ptr<MeshBatchTaskOutputQueueVLT> _mesh_batch_results;
+
 	VoxelInstancer *_instancer = nullptr;
 
 	Ref<VoxelMesher> _mesher;
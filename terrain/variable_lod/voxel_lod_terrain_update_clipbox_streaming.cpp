@@ -1464,23 +1464,8 @@ void process_loaded_mesh_blocks_trigger_visibility_changes( //
 		}
 	}
 
-	{
-		uint32_t lods_to_update_transitions = 0;
-		for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
-			VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
-			// Only update transition masks when visuals change, this is a rendering feature
-			if (lod.mesh_blocks_to_activate_visuals.size() > 0 || lod.mesh_blocks_to_deactivate_visuals.size() > 0) {
-				lods_to_update_transitions |= (0b111 << lod_index);
-			}
-		}
-		// TODO This is quite slow (see implementation).
-		// Maybe there is a way to optimize it with the clipbox logic (updates could be grouped per new/old boxes,
-		// however it wouldn't work as-is because mesh updates take time before they actually become visible. Could
-		// also update masks incrementally somehow?). The initial reason this streaming system was added was to help
-		// with server-side performance. This feature is client-only, so it didn't need to be optimized too at the
-		// moment.
-		update_transition_masks(state, lods_to_update_transitions, lod_count, true);
-	}
+	// Only blocks around those which changed visual state are updated
+	update_transition_masks(state, lod_count, true);
 }
 
 } // namespace
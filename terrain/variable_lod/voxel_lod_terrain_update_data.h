@@ -13,6 +13,7 @@
 #include "../../util/tasks/cancellation_token.h"
 #include "../voxel_mesh_map.h"
 #include "lod_octree.h"
+#include "mesh_cache_vlt.h"
 
 namespace zylann {
 
@@ -211,6 +212,8 @@ struct VoxelLodTerrainUpdateData {
 		StdVector<Vector3i> mesh_blocks_to_deactivate_collision;
 		StdVector<Vector3i> mesh_blocks_to_drop_visual;
 		StdVector<Vector3i> mesh_blocks_to_drop_collision;
+		// Results taken from the mesh cache instead of scheduling meshing tasks
+		StdVector<VoxelEngine::BlockMeshOutput> reused_mesh_outputs;
 
 		inline bool has_loading_block(const Vector3i &pos) const {
 			return loading_blocks.find(pos) != loading_blocks.end();
@@ -330,6 +333,9 @@ struct VoxelLodTerrainUpdateData {
 		StdVector<Box3i> changed_generated_areas;
 		BinaryMutex changed_generated_areas_mutex;
 
+		// Meshes of blocks whose voxels did not change since they were last meshed
+		MeshCacheVLT mesh_cache;
+
 		Stats stats;
 	};
 
@@ -508,9 +508,6 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 
 	unsigned int blocked_octree_nodes = 0;
 
-	// Off by one bit: second bit is LOD0, first bit is unused
-	uint32_t lods_to_update_transitions = 0;
-
 	// TODO Optimization: Maintain a vector to make iteration faster?
 	for (auto octree_it = state.octree_streaming.lod_octrees.begin();
 			octree_it != state.octree_streaming.lod_octrees.end(); ++octree_it) {
@@ -525,7 +522,6 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 			unsigned int blocked_count = 0;
 			float lod_distance_octree_space;
 			Vector3 viewer_pos_octree_space;
-			uint32_t &lods_to_update_transitions;
 
 			void create_child(Vector3i node_pos, int lod_index, LodOctree::NodeData &node_data) {
 				VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
@@ -541,7 +537,6 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 				lod.mesh_blocks_to_activate_collision.push_back(bpos);
 				mesh_block_it->second.visual_active = true;
 				mesh_block_it->second.collision_active = true;
-				lods_to_update_transitions |= (0b111 << lod_index);
 			}
 
 			void destroy_child(Vector3i node_pos, int lod_index) {
@@ -555,7 +550,6 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 					mesh_block_it->second.collision_active = false;
 					lod.mesh_blocks_to_deactivate_visuals.push_back(bpos);
 					lod.mesh_blocks_to_deactivate_collision.push_back(bpos);
-					lods_to_update_transitions |= (0b111 << lod_index);
 				}
 			}
 
@@ -575,7 +569,6 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 					mesh_block_it->second.collision_active = true;
 					lod.mesh_blocks_to_activate_visuals.push_back(bpos);
 					lod.mesh_blocks_to_activate_collision.push_back(bpos);
-					lods_to_update_transitions |= (0b111 << lod_index);
 				}
 			}
 
@@ -672,8 +665,7 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 			block_offset_lod0, //
 			0, //
 			lod_distance_octree_space, //
-			relative_viewer_pos / octree_leaf_node_size, //
-			lods_to_update_transitions
+			relative_viewer_pos / octree_leaf_node_size //
 		};
 		VoxelLodTerrainUpdateData::OctreeItem &item = octree_it->second;
 		item.octree.update(octree_actions);
@@ -685,8 +677,6 @@ void process_octrees_fitting(VoxelLodTerrainUpdateData::State &state,
 	// If not, something in block management prevents LODs from properly show up and should be fixed.
 	state.stats.blocked_lods = blocked_octree_nodes;
 	state.octree_streaming.had_blocked_octree_nodes_previous_update = blocked_octree_nodes > 0;
-
-	update_transition_masks(state, lods_to_update_transitions, lod_count, false);
 }
 
 } // namespace
@@ -716,6 +706,9 @@ void process_octree_streaming(VoxelLodTerrainUpdateData::State &state, VoxelData
 	if (stream_enabled) {
 		process_octrees_fitting(state, settings, data, viewer_pos, data_blocks_to_load);
 	}
+
+	// Done last, so it accounts for blocks unloaded or hidden by sliding boxes as well as octree changes
+	update_transition_masks(state, data.get_lod_count(), false);
 }
 
 } // namespace zylann::voxel
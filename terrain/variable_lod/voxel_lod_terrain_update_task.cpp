@@ -18,6 +18,8 @@
 #include "voxel_lod_terrain_update_clipbox_streaming.h"
 #include "voxel_lod_terrain_update_octree_streaming.h"
 
+#include <algorithm>
+
 namespace zylann::voxel {
 
 namespace {
@@ -256,6 +258,7 @@ void send_mesh_requests( //
 		std::shared_ptr<MeshingDependency> meshing_dependency, //
 		std::shared_ptr<PriorityDependency::ViewersData> &shared_viewers_data, //
 		const Transform3D &volume_transform, //
+		const bool use_mesh_cache, //
 		BufferedTaskScheduler &task_scheduler //
 ) {
 	ZN_PROFILE_SCOPE();
@@ -268,10 +271,18 @@ void send_mesh_requests( //
 	const int render_to_data_factor = mesh_block_size / data_block_size;
 	const unsigned int lod_count = data.get_lod_count();
 
+	// Obtained before tasks read voxels. If an edit invalidates blocks in the meantime, results will not be cached.
+	const uint32_t mesh_cache_revision = state.mesh_cache.get_revision();
+
 	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
 		ZN_PROFILE_SCOPE();
 		VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
 
+		// Detail textures are not cached, so blocks using them are always meshed again
+		const bool use_mesh_cache_in_lod = use_mesh_cache &&
+				!(settings.detail_texture_settings.enabled &&
+						lod_index >= settings.detail_texture_settings.begin_lod_index);
+
 		for (unsigned int bi = 0; bi < lod.mesh_blocks_pending_update.size(); ++bi) {
 			ZN_PROFILE_SCOPE();
 			const VoxelLodTerrainUpdateData::MeshToUpdate &mesh_to_update = lod.mesh_blocks_pending_update[bi];
@@ -283,6 +294,20 @@ void send_mesh_requests( //
 			// All blocks we get here must be in the scheduled state
 			ZN_ASSERT_CONTINUE(mesh_block.state == VoxelLodTerrainUpdateData::MESH_UPDATE_NOT_SENT);
 
+			if (use_mesh_cache_in_lod) {
+				// Voxels may not have changed since this block was last meshed
+				VoxelEngine::BlockMeshOutput cached_output;
+				if (state.mesh_cache.try_get(mesh_to_update.position, lod_index, cached_output) &&
+						(cached_output.visual_was_required || !mesh_to_update.require_visual)) {
+					cached_output.visual_was_required = mesh_to_update.require_visual;
+					cached_output.mesh_cache_revision = mesh_cache_revision;
+					lod.reused_mesh_outputs.push_back(std::move(cached_output));
+					mesh_block.state = VoxelLodTerrainUpdateData::MESH_UPDATE_SENT;
+					mesh_block.update_list_index = -1;
+					continue;
+				}
+			}
+
 			// Get block and its neighbors
 			// VoxelEngine::BlockMeshInput mesh_request;
 			// mesh_request.render_block_position = mesh_block_pos;
@@ -305,6 +330,7 @@ void send_mesh_requests( //
 			task->detail_texture_use_gpu = settings.detail_textures_use_gpu;
 			task->block_generation_use_gpu = settings.generator_use_gpu;
 			task->cancellation_token = mesh_to_update.cancellation_token;
+			task->mesh_cache_revision = mesh_cache_revision;
 
 			// Don't update a detail texture if one update is already processing
 			if (settings.detail_texture_settings.enabled &&
@@ -534,6 +560,8 @@ void process_changed_generated_areas( //
 							lod.mesh_blocks_pending_update, block_it->second.mesh_viewers.get() > 0);
 				}
 			});
+
+			state.mesh_cache.invalidate(bbox, lod_index);
 		}
 	}
 
@@ -625,6 +653,9 @@ void VoxelLodTerrainUpdateTask::flush_pending_lod_edits( //
 					);
 				}
 			});
+
+			// Done after scheduling updates, so meshes being applied at the same time can't be cached with old voxels
+			state.mesh_cache.invalidate(mesh_block_box, lod_index);
 		}
 	}
 
@@ -738,70 +769,161 @@ uint8_t VoxelLodTerrainUpdateTask::get_transition_mask( //
 	return transition_mask;
 }
 
+namespace {
+
+// Adds positions of blocks of which the transition mask may depend on the visual state of the block at `bpos`.
+// Transition masks only depend on face neighbors of the same LOD, of the parent LOD and of the child LOD, so that
+// neighborhood is all there is to update when the block gets activated, deactivated or unloaded.
+void add_transition_dependents(FixedArray<StdVector<Vector3i>, constants::MAX_LOD> &dirty_positions_per_lod,
+		Vector3i bpos, unsigned int lod_index, unsigned int lod_count) {
+	// Same LOD: the block itself and its neighbors
+	StdVector<Vector3i> &same_lod_positions = dirty_positions_per_lod[lod_index];
+	same_lod_positions.push_back(bpos);
+	for (unsigned int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
+		same_lod_positions.push_back(bpos + Cube::g_side_normals[dir]);
+	}
+
+	// Parent LOD: blocks touching this one, which check one of their child-sized neighbors
+	if (lod_index + 1 < lod_count) {
+		StdVector<Vector3i> &parent_lod_positions = dirty_positions_per_lod[lod_index + 1];
+		const Vector3i parent_pos = bpos >> 1;
+		for (unsigned int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
+			const Vector3i npos = (bpos + Cube::g_side_normals[dir]) >> 1;
+			if (npos != parent_pos) {
+				parent_lod_positions.push_back(npos);
+			}
+		}
+	}
+
+	// Child LOD: blocks touching this one, which check their parent-sized neighbors
+	if (lod_index > 0) {
+		StdVector<Vector3i> &child_lod_positions = dirty_positions_per_lod[lod_index - 1];
+		const Vector3i child_origin = bpos << 1;
+		for (unsigned int child_index = 0; child_index < 8; ++child_index) {
+			const Vector3i child_pos =
+					child_origin + Vector3i(child_index & 1, (child_index >> 1) & 1, (child_index >> 2) & 1);
+			for (unsigned int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
+				const Vector3i npos = child_pos + Cube::g_side_normals[dir];
+				if ((npos >> 1) != bpos) {
+					child_lod_positions.push_back(npos);
+				}
+			}
+		}
+	}
+}
+
+#ifdef DEV_ENABLED
+
+// Recomputes masks the way it was done before updates became incremental: when any block changed state in LOD N, all
+// transitions in LODs N-1, N, and N+1 are recomputed. Used to validate incremental updates, which used to miss some
+// spots in the past, causing cracks to show up.
+void check_transition_masks(const VoxelLodTerrainUpdateData::State &state, unsigned int lod_count, bool use_refcounts) {
+	ZN_PROFILE_SCOPE_NAMED("Transition checks");
+
+	// Off by one bit: second bit is LOD0, first bit is unused
+	uint32_t lods_to_update_transitions = 0;
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		const VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+		if (lod.mesh_blocks_to_activate_visuals.size() > 0 || lod.mesh_blocks_to_deactivate_visuals.size() > 0 ||
+				lod.mesh_blocks_to_unload.size() > 0) {
+			lods_to_update_transitions |= (0b111 << lod_index);
+		}
+	}
+	lods_to_update_transitions >>= 1;
+
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		if ((lods_to_update_transitions & (1 << lod_index)) == 0) {
+			continue;
+		}
+		const VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+		RWLockRead rlock(lod.mesh_map_state.map_lock);
+		for (auto it = lod.mesh_map_state.map.begin(); it != lod.mesh_map_state.map.end(); ++it) {
+			const VoxelLodTerrainUpdateData::MeshBlockState &mesh_block = it->second;
+			if (mesh_block.visual_active && (!use_refcounts || mesh_block.mesh_viewers.get() > 0)) {
+				const uint8_t recomputed_mask =
+						VoxelLodTerrainUpdateTask::get_transition_mask(state, it->first, lod_index, lod_count);
+				ZN_ASSERT_MSG(recomputed_mask == mesh_block.transition_mask,
+						"Incremental transition mask update differs from full recompute");
+			}
+		}
+	}
+}
+
+#endif
+
+} // namespace
+
 void update_transition_masks( //
 		VoxelLodTerrainUpdateData::State &state, //
-		uint32_t lods_to_update_transitions, //
 		unsigned int lod_count, //
 		// Currently needed to keep supporting the old octree streaming system, which doesn't support multiple viewers
 		bool use_refcounts //
 ) {
-	// TODO Optimize: this works but it's not smart.
-	// It doesn't take too long (100 microseconds when octrees update with lod distance 60).
-	// We used to only update positions based on which blocks were added/removed in the octree update,
-	// which was faster than this. However it missed some spots, which caused annoying cracks to show up.
-	// So instead, when any block changes state in LOD N, we update all transitions in LODs N-1, N, and N+1.
-	// It is unclear yet why the old approach didn't work, maybe because it didn't properly made N-1 and N+1 update.
-	// If you find a better approach, it has to comply with the validation check below.
-	if (lods_to_update_transitions != 0) {
-		ZN_PROFILE_SCOPE_NAMED("Transition masks");
-		// We pass a mask that gets populated with (0b111 << index), because we want to add lod+1, lod+0 and lod-1. But
-		// because the case of -1 would require more code, we instead offset the mask by 1. Then at the end, we
-		// only need to undo that offset once here.
-		lods_to_update_transitions >>= 1;
-
-		for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
-			if ((lods_to_update_transitions & (1 << lod_index)) == 0) {
-				continue;
-			}
+	// Masks are updated incrementally: only blocks in the neighborhood of those which got activated, deactivated or
+	// unloaded during this update are recomputed. Before, all blocks of LODs N-1, N and N+1 were recomputed when any
+	// block of LOD N changed state, which got slow with large view distances and fast movement.
+	// An older incremental approach missed some spots and caused cracks, so in dev builds results are compared with
+	// the full recompute.
+	ZN_PROFILE_SCOPE_NAMED("Transition masks");
 
-			VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+	static thread_local FixedArray<StdVector<Vector3i>, constants::MAX_LOD> tls_dirty_positions_per_lod;
 
-			// TODO Might not be necessary because we run this in the update task. No other thread is allowed to modify
-			// this map while the task is running.
-			RWLockRead rlock(lod.mesh_map_state.map_lock);
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		tls_dirty_positions_per_lod[lod_index].clear();
+	}
 
-			for (auto it = lod.mesh_map_state.map.begin(); it != lod.mesh_map_state.map.end(); ++it) {
-				VoxelLodTerrainUpdateData::MeshBlockState &mesh_block = it->second;
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		const VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+		// Only visuals matter, this is a rendering feature
+		for (const Vector3i bpos : lod.mesh_blocks_to_activate_visuals) {
+			add_transition_dependents(tls_dirty_positions_per_lod, bpos, lod_index, lod_count);
+		}
+		for (const Vector3i bpos : lod.mesh_blocks_to_deactivate_visuals) {
+			add_transition_dependents(tls_dirty_positions_per_lod, bpos, lod_index, lod_count);
+		}
+		for (const Vector3i bpos : lod.mesh_blocks_to_unload) {
+			add_transition_dependents(tls_dirty_positions_per_lod, bpos, lod_index, lod_count);
+		}
+	}
 
-				if (mesh_block.visual_active && (!use_refcounts || mesh_block.mesh_viewers.get() > 0)) {
-					const uint8_t recomputed_mask =
-							VoxelLodTerrainUpdateTask::get_transition_mask(state, it->first, lod_index, lod_count);
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		StdVector<Vector3i> &dirty_positions = tls_dirty_positions_per_lod[lod_index];
+		if (dirty_positions.size() == 0) {
+			continue;
+		}
 
-					if (recomputed_mask != it->second.transition_mask) {
-						mesh_block.transition_mask = recomputed_mask;
-						lod.mesh_blocks_to_update_transitions.push_back(
-								VoxelLodTerrainUpdateData::TransitionUpdate{ it->first, recomputed_mask });
-					}
-				}
+		// Neighborhoods of changed blocks overlap a lot
+		std::sort(dirty_positions.begin(), dirty_positions.end());
+		dirty_positions.erase(std::unique(dirty_positions.begin(), dirty_positions.end()), dirty_positions.end());
+
+		VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+
+		// TODO Might not be necessary because we run this in the update task. No other thread is allowed to modify
+		// this map while the task is running.
+		RWLockRead rlock(lod.mesh_map_state.map_lock);
+
+		for (const Vector3i bpos : dirty_positions) {
+			auto it = lod.mesh_map_state.map.find(bpos);
+			if (it == lod.mesh_map_state.map.end()) {
+				continue;
 			}
-		}
-	}
-#if 0
-	// DEBUG: Validation check for transition mask updates.
-	{
-		ZN_PROFILE_SCOPE_NAMED("Transition checks");
-		for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
-			const VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
-			RWLockRead rlock(lod.mesh_map_state.map_lock);
-			for (auto it = lod.mesh_map_state.map.begin(); it != lod.mesh_map_state.map.end(); ++it) {
-				if (it->second.active) {
-					const uint8_t recomputed_mask =
-							VoxelLodTerrainUpdateTask::get_transition_mask(state, it->first, lod_index, lod_count);
-					CRASH_COND(recomputed_mask != it->second.transition_mask);
+			VoxelLodTerrainUpdateData::MeshBlockState &mesh_block = it->second;
+
+			if (mesh_block.visual_active && (!use_refcounts || mesh_block.mesh_viewers.get() > 0)) {
+				const uint8_t recomputed_mask =
+						VoxelLodTerrainUpdateTask::get_transition_mask(state, bpos, lod_index, lod_count);
+
+				if (recomputed_mask != mesh_block.transition_mask) {
+					mesh_block.transition_mask = recomputed_mask;
+					lod.mesh_blocks_to_update_transitions.push_back(
+							VoxelLodTerrainUpdateData::TransitionUpdate{ bpos, recomputed_mask });
 				}
 			}
 		}
 	}
+
+#ifdef DEV_ENABLED
+	check_transition_masks(state, lod_count, use_refcounts);
 #endif
 }
 
@@ -987,6 +1109,8 @@ void VoxelLodTerrainUpdateTask::run(ThreadedTaskContext &ctx) {
 				_meshing_dependency, //
 				_shared_viewers_data, //
 				_volume_transform, //
+				// Without a stream, edited voxels are lost when unloaded, so meshes seen before could be outdated
+				stream.is_valid() || !data.is_streaming_enabled(), //
 				task_scheduler //
 		);
 	}
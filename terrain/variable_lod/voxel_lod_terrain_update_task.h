@@ -105,9 +105,10 @@ private:
 	Transform3D _volume_transform;
 };
 
+// Recomputes transition masks of visible blocks in the neighborhood of those which changed visual state during the
+// current update. Changed masks are added to `mesh_blocks_to_update_transitions`.
 void update_transition_masks( //
 		VoxelLodTerrainUpdateData::State &state, //
-		uint32_t lods_to_update_transitions, //
 		unsigned int lod_count, //
 		bool use_refcounts //
 );
@@ -13,6 +13,9 @@ VoxelMeshBlockVLT::VoxelMeshBlockVLT(const Vector3i bpos, unsigned int size, uns
 		VoxelMeshBlock(bpos) {
 	_position_in_voxels = bpos * (size << p_lod_index);
 
+	set_shader_parameter(
+			VoxelStringNames::get_singleton().u_block_local_transform, Transform3D(Basis(), _position_in_voxels));
+
 #ifdef VOXEL_DEBUG_LOD_MATERIALS
 	Ref<SpatialMaterial> debug_material;
 	debug_material.instance();
@@ -63,13 +66,17 @@ void VoxelMeshBlockVLT::set_mesh(Ref<Mesh> mesh, GeometryInstance3D::GIMode gi_m
 			_mesh_instance.set_gi_mode(gi_mode);
 			_mesh_instance.set_cast_shadows_setting(shadow_casting);
 			_mesh_instance.set_render_layers_mask(render_layers_mask);
-			set_mesh_instance_visible(_mesh_instance, _visible && _parent_visible);
+			if (_use_instance_shader_parameters) {
+				apply_instance_shader_parameters(_mesh_instance);
+			}
+			set_mesh_instance_visible(_mesh_instance, _is_mesh_instance_visible());
 		}
 
 		_mesh_instance.set_mesh(mesh);
 
-		if (_shader_material.is_valid()) {
-			_mesh_instance.set_material_override(_shader_material);
+		const Ref<Material> material_override = _get_material_override();
+		if (material_override.is_valid()) {
+			_mesh_instance.set_material_override(material_override);
 		}
 #ifdef VOXEL_DEBUG_LOD_MATERIALS
 		_mesh_instance.set_material_override(_debug_material);
@@ -108,6 +115,14 @@ void VoxelMeshBlockVLT::drop_visuals() {
 	fading_progress = 0.f;
 	visual_active = false;
 	_transition_mask = 0;
+	_batched = false;
+	batchable_mesh = false;
+	batch_surfaces.clear();
+
+	// Other parameters are reset along with the state they represent
+	_shader_parameters.clear();
+	set_shader_parameter(
+			VoxelStringNames::get_singleton().u_block_local_transform, Transform3D(Basis(), _position_in_voxels));
 }
 
 void VoxelMeshBlockVLT::set_gi_mode(GeometryInstance3D::GIMode mode) {
@@ -151,13 +166,17 @@ void VoxelMeshBlockVLT::set_transition_mesh(Ref<Mesh> mesh, unsigned int side, G
 			mesh_instance.set_gi_mode(gi_mode);
 			mesh_instance.set_cast_shadows_setting(shadow_casting);
 			mesh_instance.set_render_layers_mask(render_layers_mask);
-			set_mesh_instance_visible(mesh_instance, _visible && _parent_visible && _is_transition_visible(side));
+			if (_use_instance_shader_parameters) {
+				apply_instance_shader_parameters(mesh_instance);
+			}
+			set_mesh_instance_visible(mesh_instance, _is_mesh_instance_visible() && _is_transition_visible(side));
 		}
 
 		mesh_instance.set_mesh(mesh);
 
-		if (_shader_material.is_valid()) {
-			mesh_instance.set_material_override(_shader_material);
+		const Ref<Material> material_override = _get_material_override();
+		if (material_override.is_valid()) {
+			mesh_instance.set_material_override(material_override);
 		}
 #ifdef VOXEL_DEBUG_LOD_MATERIALS
 		mesh_instance.set_material_override(_debug_transition_material);
@@ -176,7 +195,7 @@ void VoxelMeshBlockVLT::set_world(Ref<World3D> p_world) {
 		_world = p_world;
 
 		// To update world. I replaced visibility by presence in world because Godot 3 culling performance is horrible
-		_set_visible(_visible && _parent_visible);
+		_set_visible(_is_mesh_instance_visible());
 
 		if (_static_body.is_valid()) {
 			_static_body.set_world(*p_world);
@@ -189,7 +208,7 @@ void VoxelMeshBlockVLT::set_visible(bool visible) {
 		return;
 	}
 	_visible = visible;
-	_set_visible(_visible && _parent_visible);
+	_set_visible(_is_mesh_instance_visible());
 }
 
 void VoxelMeshBlockVLT::_set_visible(bool visible) {
@@ -204,23 +223,93 @@ void VoxelMeshBlockVLT::_set_visible(bool visible) {
 
 void VoxelMeshBlockVLT::set_shader_material(Ref<ShaderMaterial> material) {
 	_shader_material = material;
+	_update_material_override();
+
+	if (_shader_material.is_valid()) {
+		const VoxelStringNames &sn = VoxelStringNames::get_singleton();
+		_shader_material->set_shader_parameter(sn.u_voxel_virtual_texture_offset_scale, Vector4(0, 0, 0, 1));
+		for (const ShaderParameter &param : _shader_parameters) {
+			_shader_material->set_shader_parameter(param.name, param.value);
+		}
+	}
+}
+
+void VoxelMeshBlockVLT::set_shared_material(Ref<Material> material) {
+	if (_shared_material == material) {
+		return;
+	}
+	_shared_material = material;
+	if (_shader_material.is_null()) {
+		_update_material_override();
+	}
+}
 
+void VoxelMeshBlockVLT::_update_material_override() {
 	if (_mesh_instance.is_valid()) {
-		_mesh_instance.set_material_override(_shader_material);
+		const Ref<Material> material_override = _get_material_override();
+		_mesh_instance.set_material_override(material_override);
 
 		for (int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
 			DirectMeshInstance &mi = _transition_mesh_instances[dir];
 			if (mi.is_valid()) {
-				mi.set_material_override(_shader_material);
+				mi.set_material_override(material_override);
 			}
 		}
 	}
+}
+
+void VoxelMeshBlockVLT::set_shader_parameter(const StringName &name, const Variant &value) {
+	bool found = false;
+	for (ShaderParameter &param : _shader_parameters) {
+		if (param.name == name) {
+			param.value = value;
+			found = true;
+			break;
+		}
+	}
+	if (!found) {
+		_shader_parameters.push_back(ShaderParameter{ name, value });
+	}
 
 	if (_shader_material.is_valid()) {
-		const Transform3D local_transform(Basis(), _position_in_voxels);
-		const VoxelStringNames &sn = VoxelStringNames::get_singleton();
-		_shader_material->set_shader_parameter(sn.u_block_local_transform, local_transform);
-		_shader_material->set_shader_parameter(sn.u_voxel_virtual_texture_offset_scale, Vector4(0, 0, 0, 1));
+		_shader_material->set_shader_parameter(name, value);
+	}
+
+	if (_use_instance_shader_parameters) {
+		if (_mesh_instance.is_valid()) {
+			_mesh_instance.set_shader_instance_parameter(name, value);
+		}
+		for (unsigned int dir = 0; dir < _transition_mesh_instances.size(); ++dir) {
+			DirectMeshInstance &mi = _transition_mesh_instances[dir];
+			if (mi.is_valid()) {
+				mi.set_shader_instance_parameter(name, value);
+			}
+		}
+	}
+}
+
+void VoxelMeshBlockVLT::set_use_instance_shader_parameters(bool enabled) {
+	if (_use_instance_shader_parameters == enabled) {
+		return;
+	}
+	_use_instance_shader_parameters = enabled;
+
+	if (enabled) {
+		if (_mesh_instance.is_valid()) {
+			apply_instance_shader_parameters(_mesh_instance);
+		}
+		for (unsigned int dir = 0; dir < _transition_mesh_instances.size(); ++dir) {
+			DirectMeshInstance &mi = _transition_mesh_instances[dir];
+			if (mi.is_valid()) {
+				apply_instance_shader_parameters(mi);
+			}
+		}
+	}
+}
+
+void VoxelMeshBlockVLT::apply_instance_shader_parameters(DirectMeshInstance &mi) const {
+	for (const ShaderParameter &param : _shader_parameters) {
+		mi.set_shader_instance_parameter(param.name, param.value);
 	}
 }
 
@@ -242,27 +331,26 @@ void VoxelMeshBlockVLT::set_transition_mask(uint8_t m) {
 		return;
 	}
 	_transition_mask = m;
-	if (_shader_material.is_valid()) {
-		// TODO Needs translation here, because Cube:: tables use slightly different order...
-		// We may get rid of this once cube tables respects -x+x-y+y-z+z order
-		uint8_t bits[Cube::SIDE_COUNT];
-		for (unsigned int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
-			bits[dir] = (m >> dir) & 1;
-		}
-		uint8_t tm = bits[Cube::SIDE_NEGATIVE_X];
-		tm |= bits[Cube::SIDE_POSITIVE_X] << 1;
-		tm |= bits[Cube::SIDE_NEGATIVE_Y] << 2;
-		tm |= bits[Cube::SIDE_POSITIVE_Y] << 3;
-		tm |= bits[Cube::SIDE_NEGATIVE_Z] << 4;
-		tm |= bits[Cube::SIDE_POSITIVE_Z] << 5;
 
-		// TODO Godot 4: we may replace this with a per-instance parameter so we can lift material access limitation
-		_shader_material->set_shader_parameter(VoxelStringNames::get_singleton().u_transition_mask, tm);
+	// TODO Needs translation here, because Cube:: tables use slightly different order...
+	// We may get rid of this once cube tables respects -x+x-y+y-z+z order
+	uint8_t bits[Cube::SIDE_COUNT];
+	for (unsigned int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
+		bits[dir] = (m >> dir) & 1;
 	}
+	uint8_t tm = bits[Cube::SIDE_NEGATIVE_X];
+	tm |= bits[Cube::SIDE_POSITIVE_X] << 1;
+	tm |= bits[Cube::SIDE_NEGATIVE_Y] << 2;
+	tm |= bits[Cube::SIDE_POSITIVE_Y] << 3;
+	tm |= bits[Cube::SIDE_NEGATIVE_Z] << 4;
+	tm |= bits[Cube::SIDE_POSITIVE_Z] << 5;
+
+	set_shader_parameter(VoxelStringNames::get_singleton().u_transition_mask, tm);
+
 	for (int dir = 0; dir < Cube::SIDE_COUNT; ++dir) {
 		DirectMeshInstance &mi = _transition_mesh_instances[dir];
 		if (mi.is_valid() && (diff & (1 << dir))) {
-			set_mesh_instance_visible(mi, _visible && _parent_visible && _is_transition_visible(dir));
+			set_mesh_instance_visible(mi, _is_mesh_instance_visible() && _is_transition_visible(dir));
 		}
 	}
 }
@@ -272,7 +360,15 @@ void VoxelMeshBlockVLT::set_parent_visible(bool parent_visible) {
 		return;
 	}
 	_parent_visible = parent_visible;
-	_set_visible(_visible && _parent_visible);
+	_set_visible(_is_mesh_instance_visible());
+}
+
+void VoxelMeshBlockVLT::set_batched(bool batched) {
+	if (_batched == batched) {
+		return;
+	}
+	_batched = batched;
+	_set_visible(_is_mesh_instance_visible());
 }
 
 void VoxelMeshBlockVLT::set_parent_transform(const Transform3D &parent_transform) {
@@ -355,9 +451,7 @@ bool VoxelMeshBlockVLT::update_fading(float speed) {
 			break;
 	}
 
-	if (_shader_material.is_valid()) {
-		_shader_material->set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, p);
-	}
+	set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, p);
 
 	return finished;
 }
@@ -365,9 +459,7 @@ bool VoxelMeshBlockVLT::update_fading(float speed) {
 void VoxelMeshBlockVLT::clear_fading() {
 	fading_state = FADING_NONE;
 	fading_progress = 0.f;
-	if (_shader_material.is_valid()) {
-		_shader_material->set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, Vector2(0.0, 0.0));
-	}
+	set_shader_parameter(VoxelStringNames::get_singleton().u_lod_fade, Vector2(0.0, 0.0));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
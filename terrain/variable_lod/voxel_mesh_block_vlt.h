@@ -39,6 +39,13 @@ public:
 	uint64_t last_collider_update_time = 0;
 	UniquePtr<VoxelMesher::Output> deferred_collider_data;
 
+	// True when the mesh of the block can be merged with its siblings into a mesh batch
+	bool batchable_mesh = false;
+	// Copy of the surfaces of the rendering mesh, kept until they get merged into a batch. Arrays are shared, not
+	// duplicated. Once merged, they are released to save memory, and read back from the mesh if needed again.
+	StdVector<VoxelMesher::Output::Surface> batch_surfaces;
+	uint32_t batch_mesh_flags = 0;
+
 	VoxelMeshBlockVLT(const Vector3i bpos, unsigned int size, unsigned int p_lod_index);
 	~VoxelMeshBlockVLT();
 
@@ -53,6 +60,12 @@ public:
 
 	void set_parent_visible(bool parent_visible);
 
+	// When batched, the block is drawn by a mesh batch instead of its own mesh instance
+	void set_batched(bool batched);
+	inline bool is_batched() const {
+		return _batched;
+	}
+
 	void set_mesh(Ref<Mesh> mesh, GeometryInstance3D::GIMode gi_mode,
 			RenderingServer::ShadowCastingSetting shadow_casting, int render_layers_mask);
 	void drop_visuals();
@@ -74,6 +87,24 @@ public:
 		return _shader_material;
 	}
 
+	// Material used when the block has no ShaderMaterial of its own. It may be shared with other blocks, so per-block
+	// parameters are never set on it.
+	void set_shared_material(Ref<Material> material);
+
+	// Sets a shader parameter specific to this block. It is set on the block's ShaderMaterial if any, and on its mesh
+	// instances if instance shader parameters are used. Values are remembered, so they can be applied again when the
+	// material or mesh instances change.
+	void set_shader_parameter(const StringName &name, const Variant &value);
+
+	// When enabled, per-block shader parameters are also set on mesh instances, which allows shaders declaring them as
+	// `instance uniform` to share a single material between all blocks.
+	void set_use_instance_shader_parameters(bool enabled);
+	inline bool is_using_instance_shader_parameters() const {
+		return _use_instance_shader_parameters;
+	}
+
+	void apply_instance_shader_parameters(zylann::godot::DirectMeshInstance &mi) const;
+
 	// Transform
 
 	void set_parent_transform(const Transform3D &parent_transform);
@@ -94,16 +125,38 @@ public:
 
 private:
 	void _set_visible(bool visible);
+	void _update_material_override();
+
+	inline bool _is_mesh_instance_visible() const {
+		return _visible && _parent_visible && !_batched;
+	}
+
+	inline Ref<Material> _get_material_override() const {
+		if (_shader_material.is_valid()) {
+			return _shader_material;
+		}
+		return _shared_material;
+	}
 
 	inline bool _is_transition_visible(unsigned int side) const {
 		return _transition_mask & (1 << side);
 	}
 
 	Ref<ShaderMaterial> _shader_material;
+	Ref<Material> _shared_material;
+
+	struct ShaderParameter {
+		StringName name;
+		Variant value;
+	};
+	// Only a few parameters are per-block, so a vector is enough
+	StdVector<ShaderParameter> _shader_parameters;
 
 	FixedArray<zylann::godot::DirectMeshInstance, Cube::SIDE_COUNT> _transition_mesh_instances;
 
 	uint8_t _transition_mask = 0;
+	bool _batched = false;
+	bool _use_instance_shader_parameters = false;
 
 #ifdef VOXEL_DEBUG_LOD_MATERIALS
 	Ref<Material> _debug_material;
@@ -55,6 +55,8 @@ void VoxelMeshBlock::set_mesh(Ref<Mesh> mesh, GeometryInstance3D::GIMode gi_mode
 	// which is killing performance when LOD is used (i.e many meshes are in pool but hidden)
 	// This needs investigation.
 
+	_mesh_signature = MeshSignature();
+
 	if (mesh.is_valid()) {
 		if (!_mesh_instance.is_valid()) {
 			// Create instance if it doesn't exist
@@ -90,10 +92,16 @@ bool VoxelMeshBlock::has_mesh() const {
 	return _mesh_instance.get_mesh().is_valid();
 }
 
+bool VoxelMeshBlock::is_mesh_exclusively_owned() const {
+	const Mesh *mesh = _mesh_instance.get_mesh_ptr();
+	return mesh != nullptr && mesh->get_reference_count() == 1;
+}
+
 void VoxelMeshBlock::drop_mesh() {
 	if (_mesh_instance.is_valid()) {
 		_mesh_instance.destroy();
 	}
+	_mesh_signature = MeshSignature();
 }
 
 void VoxelMeshBlock::set_visible(bool visible) {
@@ -2,6 +2,7 @@
 #define VOXEL_MESH_BLOCK_H
 
 #include "../constants/cube_tables.h"
+#include "../meshers/mesh_recycling.h"
 #include "../meshers/voxel_mesher.h"
 #include "../util/containers/fixed_array.h"
 #include "../util/containers/span.h"
@@ -40,6 +41,18 @@ public:
 	Ref<Mesh> get_mesh() const;
 	bool has_mesh() const;
 	void drop_mesh();
+	// Returns true if the block holds the only reference to its mesh, which can then be modified without affecting
+	// anything else (the mesh could also be cached, or have been obtained from scripts).
+	bool is_mesh_exclusively_owned() const;
+
+	// Describes what the current mesh was built from, if known. Setting a new mesh or dropping it resets the
+	// signature. Used to recycle the mesh when the block gets remeshed.
+	inline void set_mesh_signature(const MeshSignature &signature) {
+		_mesh_signature = signature;
+	}
+	inline const MeshSignature &get_mesh_signature() const {
+		return _mesh_signature;
+	}
 
 	// Note, GIMode is not stored per block, it is a shared option so we provide it in several functions.
 	// Call this function only if the mesh block already exists and has not changed mesh
@@ -88,6 +101,7 @@ protected:
 	zylann::godot::DirectMeshInstance _mesh_instance;
 	zylann::godot::DirectStaticBody _static_body;
 	Ref<World3D> _world;
+	MeshSignature _mesh_signature;
 
 	// Must match default value of `active`
 	bool _visible = false;
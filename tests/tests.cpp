@@ -2,28 +2,41 @@
 #include "../util/profiling.h"
 #include "testing.h"
 
+#include "util/test_arena_allocator.h"
 #include "util/test_box3i.h"
 #include "util/test_container_funcs.h"
 #include "util/test_expression_parser.h"
 #include "util/test_flat_map.h"
 #include "util/test_island_finder.h"
 #include "util/test_math_funcs.h"
+#include "util/test_shader.h"
 #include "util/test_slot_map.h"
 #include "util/test_spatial_lock.h"
 #include "util/test_threaded_task_runner.h"
 
 #include "voxel/test_block_serializer.h"
+#include "voxel/test_blocky_type_library.h"
 #include "voxel/test_curve_range.h"
 #include "voxel/test_detail_rendering_gpu.h"
 #include "voxel/test_edition_funcs.h"
+#include "voxel/test_generator_block_cache.h"
+#include "voxel/test_mesh_batch_vlt.h"
+#include "voxel/test_mesh_block_task.h"
+#include "voxel/test_mesh_cache_vlt.h"
+#include "voxel/test_mesh_recycling.h"
 #include "voxel/test_mesh_sdf.h"
 #include "voxel/test_octree.h"
 #include "voxel/test_region_file.h"
 #include "voxel/test_storage_funcs.h"
+#include "voxel/test_stream_memory.h"
+#include "voxel/test_transvoxel.h"
+#include "voxel/test_vox_import.h"
+#include "voxel/test_vox_scene_to_stream.h"
 #include "voxel/test_voxel_buffer.h"
 #include "voxel/test_voxel_data_map.h"
 #include "voxel/test_voxel_graph.h"
 #include "voxel/test_voxel_instancer.h"
+#include "voxel/test_voxel_lod_terrain_transitions.h"
 #include "voxel/test_voxel_mesher_cubes.h"
 
 #ifdef VOXEL_ENABLE_FAST_NOISE_2
@@ -47,12 +60,17 @@ void run_voxel_tests() {
 	VOXEL_TEST(test_wrap);
 	VOXEL_TEST(test_voxel_buffer_paste_masked);
 	VOXEL_TEST(test_image_range_grid);
+	VOXEL_TEST(test_float_heightmap);
 	VOXEL_TEST(test_box3i_intersects);
 	VOXEL_TEST(test_box3i_for_inner_outline);
 	VOXEL_TEST(test_voxel_data_map_paste_fill);
 	VOXEL_TEST(test_voxel_data_map_paste_mask);
 	VOXEL_TEST(test_voxel_data_map_copy);
 	VOXEL_TEST(test_encode_weights_packed_u16);
+	VOXEL_TEST(test_decode_packed_u16_bulk);
+	VOXEL_TEST(test_transvoxel_texture_selection_same_indices);
+	VOXEL_TEST(test_transvoxel_regular_mesh_matches_reference);
+	VOXEL_TEST(test_transvoxel_simplify_keeps_texture_blending);
 	VOXEL_TEST(test_copy_3d_region_zxy);
 	VOXEL_TEST(test_voxel_graph_invalid_connection);
 	VOXEL_TEST(test_voxel_graph_generator_default_graph_compilation);
@@ -79,8 +97,11 @@ void run_voxel_tests() {
 	VOXEL_TEST(test_voxel_graph_issue471);
 	VOXEL_TEST(test_voxel_graph_unused_single_texture_output);
 	VOXEL_TEST(test_voxel_graph_spots2d_optimized_execution_map);
+	VOXEL_TEST(test_spot_noise_batch);
 	VOXEL_TEST(test_voxel_graph_unused_inner_output);
 	VOXEL_TEST(test_voxel_graph_function_execute);
+	VOXEL_TEST(test_voxel_graph_low_frequency_function);
+	VOXEL_TEST(test_voxel_graph_low_frequency_function_cycle);
 	VOXEL_TEST(test_voxel_graph_image);
 	VOXEL_TEST(test_voxel_graph_many_weight_outputs);
 	VOXEL_TEST(test_voxel_graph_many_subdivisions);
@@ -91,6 +112,7 @@ void run_voxel_tests() {
 	VOXEL_TEST(test_octree_update);
 	VOXEL_TEST(test_octree_find_in_box);
 	VOXEL_TEST(test_get_curve_monotonic_sections);
+	VOXEL_TEST(test_curve_lut);
 	VOXEL_TEST(test_voxel_buffer_create);
 	VOXEL_TEST(test_block_serializer);
 	VOXEL_TEST(test_block_serializer_stream_peer);
@@ -106,12 +128,30 @@ void run_voxel_tests() {
 	VOXEL_TEST(test_voxel_buffer_metadata);
 	VOXEL_TEST(test_voxel_buffer_metadata_gd);
 	VOXEL_TEST(test_voxel_mesher_cubes);
+	VOXEL_TEST(test_mesh_signature);
+	VOXEL_TEST(test_mesh_recycling_update_allocates_nothing);
+	VOXEL_TEST(test_mesh_batch_vlt_append_surfaces);
+	VOXEL_TEST(test_mesh_cache_vlt_invalidate_in_flight);
+	VOXEL_TEST(test_mesh_block_task_repeated_reschedules);
+	VOXEL_TEST(test_voxel_lod_terrain_transition_masks_incremental);
+	VOXEL_TEST(test_blocky_type_library_id_map);
+	VOXEL_TEST(test_generator_block_cache);
+	VOXEL_TEST(test_generator_block_cache_parameter_change);
+	VOXEL_TEST(test_stream_memory);
+	VOXEL_TEST(test_vox_find_unique_models);
+#ifdef TOOLS_ENABLED
+	VOXEL_TEST(test_vox_mesh_unique_models);
+#endif
+	VOXEL_TEST(test_vox_scene_to_stream);
+	VOXEL_TEST(test_arena_allocator);
 	VOXEL_TEST(test_threaded_task_runner_misc);
 	VOXEL_TEST(test_threaded_task_runner_debug_names);
+	VOXEL_TEST(test_threaded_task_runner_concurrent_enqueue);
 	VOXEL_TEST(test_task_priority_values);
 	VOXEL_TEST(test_voxel_mesh_sdf_issue463);
 	VOXEL_TEST(test_normalmap_render_gpu);
 	VOXEL_TEST(test_slot_map);
+	VOXEL_TEST(test_shader_has_instance_uniform);
 	VOXEL_TEST(test_box_blur);
 	VOXEL_TEST(test_threaded_task_postponing);
 	VOXEL_TEST(test_spatial_lock_misc);
@@ -0,0 +1,36 @@
+#include "test_arena_allocator.h"
+#include "../../util/memory/arena_allocator.h"
+#include "../testing.h"
+
+namespace zylann::tests {
+
+void test_arena_allocator() {
+	ArenaAllocator arena(1024);
+
+	void *a = arena.allocate(100);
+	void *b = arena.allocate(10);
+	ZN_TEST_ASSERT(a != nullptr && b != nullptr);
+	ZN_TEST_ASSERT(reinterpret_cast<uintptr_t>(b) % ArenaAllocator::ALIGNMENT == 0);
+	ZN_TEST_ASSERT(arena.get_used_size() == 128);
+
+	// Freeing the last allocation gives its memory back
+	arena.free(b, 10);
+	ZN_TEST_ASSERT(arena.get_used_size() == 112);
+	void *c = arena.allocate(10);
+	ZN_TEST_ASSERT(c == b);
+
+	// Other allocations wait until the arena is empty
+	arena.free(a, 100);
+	ZN_TEST_ASSERT(arena.get_used_size() == 128);
+	arena.free(c, 10);
+	ZN_TEST_ASSERT(arena.get_used_size() == 0);
+	ZN_TEST_ASSERT(arena.get_allocation_count() == 0);
+
+	// Too large, falls back to the heap
+	void *d = arena.allocate(2000);
+	ZN_TEST_ASSERT(d != nullptr);
+	ZN_TEST_ASSERT(arena.get_used_size() == 0);
+	arena.free(d, 2000);
+}
+
+} // namespace zylann::tests
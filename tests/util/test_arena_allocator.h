@@ -0,0 +1,10 @@
+#ifndef ZN_TESTS_ARENA_ALLOCATOR_H
+#define ZN_TESTS_ARENA_ALLOCATOR_H
+
+namespace zylann::tests {
+
+void test_arena_allocator();
+
+} // namespace zylann::tests
+
+#endif // ZN_TESTS_ARENA_ALLOCATOR_H
@@ -0,0 +1,58 @@
+#include "test_shader.h"
+#include "../../util/godot/classes/shader.h"
+#include "../testing.h"
+
+namespace zylann::tests {
+
+void test_shader_has_instance_uniform() {
+	struct L {
+		static bool has_instance_uniform(const char *code, const char *uniform_name) {
+			Ref<Shader> shader;
+			shader.instantiate();
+			shader->set_code(code);
+			return zylann::godot::shader_has_instance_uniform(**shader, uniform_name);
+		}
+	};
+
+	ZN_TEST_ASSERT(L::has_instance_uniform("shader_type spatial;\n"
+										   "instance uniform float u_lod_fade;\n",
+			"u_lod_fade"));
+
+	ZN_TEST_ASSERT(L::has_instance_uniform("shader_type spatial;\n"
+										   "instance uniform vec2 u_lod_fade : hint_range(0, 1) = vec2(0.0);\n",
+			"u_lod_fade"));
+
+	// Other names don't match, even when they share a prefix
+	ZN_TEST_ASSERT(!L::has_instance_uniform("shader_type spatial;\n"
+											"instance uniform float u_lod_fade_other;\n",
+			"u_lod_fade"));
+
+	// Regular uniforms are not instance uniforms
+	ZN_TEST_ASSERT(!L::has_instance_uniform("shader_type spatial;\n"
+											"uniform float u_lod_fade;\n",
+			"u_lod_fade"));
+
+	// Extra whitespace and line breaks
+	ZN_TEST_ASSERT(L::has_instance_uniform("shader_type spatial;\n"
+										   "instance  uniform\n"
+										   "\thighp float\n"
+										   "\tu_lod_fade ;\n",
+			"u_lod_fade"));
+
+	// Commented out
+	ZN_TEST_ASSERT(!L::has_instance_uniform("shader_type spatial;\n"
+											"// instance uniform float u_lod_fade;\n",
+			"u_lod_fade"));
+	ZN_TEST_ASSERT(!L::has_instance_uniform("shader_type spatial;\n"
+											"/*\n"
+											"instance uniform float u_lod_fade;\n"
+											"*/\n",
+			"u_lod_fade"));
+
+	// Comments in the middle of a declaration
+	ZN_TEST_ASSERT(L::has_instance_uniform("shader_type spatial;\n"
+										   "instance/* per block */uniform float u_lod_fade; // Fading\n",
+			"u_lod_fade"));
+}
+
+} // namespace zylann::tests
@@ -0,0 +1,10 @@
+#ifndef ZN_TEST_SHADER_H
+#define ZN_TEST_SHADER_H
+
+namespace zylann::tests {
+
+void test_shader_has_instance_uniform();
+
+} // namespace zylann::tests
+
+#endif // ZN_TEST_SHADER_H
@@ -266,6 +266,86 @@ void test_threaded_task_runner_debug_names() {
 	print_line(ss.str());
 }
 
+// Many threads scheduling tasks at the same time, like when tasks spawn other tasks
+void test_threaded_task_runner_concurrent_enqueue() {
+	static const unsigned int producer_count = 4;
+	static const unsigned int batch_count_per_producer = 200;
+	static const unsigned int batch_size = 5;
+	static const unsigned int total_task_count = producer_count * batch_count_per_producer * batch_size;
+
+	class TestTask : public IThreadedTask {
+	public:
+		std::atomic_uint32_t &run_count;
+
+		TestTask(std::atomic_uint32_t &p_run_count) : run_count(p_run_count) {}
+
+		void run(ThreadedTaskContext &ctx) override {
+			++run_count;
+		}
+
+		void apply_result() override {}
+	};
+
+	struct Producer {
+		ThreadedTaskRunner *runner = nullptr;
+		std::atomic_uint32_t *run_count = nullptr;
+		unsigned int index = 0;
+
+		static void thread_func(void *userdata) {
+			Producer &p = *static_cast<Producer *>(userdata);
+			FixedArray<IThreadedTask *, batch_size> tasks;
+			for (unsigned int batch_index = 0; batch_index < batch_count_per_producer; ++batch_index) {
+				for (unsigned int i = 0; i < tasks.size(); ++i) {
+					tasks[i] = ZN_NEW(TestTask(*p.run_count));
+				}
+				if (batch_index % 3 == 0) {
+					// Parallel and serial tasks in the same batch
+					p.runner->enqueue(to_span(tasks, 2), Span<IThreadedTask *>(tasks.data() + 2, tasks.size() - 2));
+				} else if (batch_index % 3 == 1) {
+					// One by one
+					for (IThreadedTask *task : tasks) {
+						p.runner->enqueue(task, (p.index & 1) == 1);
+					}
+				} else {
+					p.runner->enqueue(to_span(tasks), (p.index & 1) == 1);
+				}
+			}
+		}
+	};
+
+	std::atomic_uint32_t run_count = { 0 };
+
+	ThreadedTaskRunner runner;
+	runner.set_thread_count(4);
+	runner.set_name("Test");
+
+	FixedArray<Producer, producer_count> producers;
+	FixedArray<Thread, producer_count> producer_threads;
+	for (unsigned int i = 0; i < producers.size(); ++i) {
+		Producer &p = producers[i];
+		p.runner = &runner;
+		p.run_count = &run_count;
+		p.index = i;
+		producer_threads[i].start(Producer::thread_func, &p);
+	}
+	for (unsigned int i = 0; i < producer_threads.size(); ++i) {
+		producer_threads[i].wait_to_finish();
+	}
+
+	runner.wait_for_all_tasks();
+
+	unsigned int completed_count = 0;
+	runner.dequeue_completed_tasks([&completed_count](IThreadedTask *task) {
+		ZN_ASSERT(task != nullptr);
+		++completed_count;
+		ZN_DELETE(task);
+	});
+
+	ZN_TEST_ASSERT(run_count == total_task_count);
+	ZN_TEST_ASSERT(completed_count == total_task_count);
+	ZN_TEST_ASSERT(runner.get_debug_remaining_tasks() == 0);
+}
+
 void test_task_priority_values() {
 	ZN_TEST_ASSERT(TaskPriority(0, 0, 0, 0) < TaskPriority(1, 0, 0, 0));
 	ZN_TEST_ASSERT(TaskPriority(0, 0, 0, 0) < TaskPriority(0, 0, 0, 1));
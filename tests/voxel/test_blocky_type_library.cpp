@@ -0,0 +1,37 @@
+#include "test_blocky_type_library.h"
+#include "../../meshers/blocky/types/voxel_blocky_type_library.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+void test_blocky_type_library_id_map() {
+	Ref<VoxelBlockyTypeLibrary> library;
+	library.instantiate();
+	library->load_default();
+
+	// Model index 0 is free, 1 is already used by `air`
+	PackedStringArray id_map;
+	id_map.append("");
+	id_map.append("air");
+	ZN_TEST_ASSERT(library->load_id_map_from_string_array(id_map));
+
+	library->bake();
+
+	const int air_index = library->get_model_index_default("air");
+	const int cube_index = library->get_model_index_default("cube");
+	ZN_TEST_ASSERT(air_index == 1);
+	ZN_TEST_ASSERT(cube_index == 0);
+	ZN_TEST_ASSERT(library->get_model_index_default("unknown") == -1);
+
+	// Indices remain the same after baking again
+	library->bake();
+	ZN_TEST_ASSERT(library->get_model_index_default("air") == air_index);
+	ZN_TEST_ASSERT(library->get_model_index_default("cube") == cube_index);
+
+	const PackedStringArray serialized_id_map = library->serialize_id_map_to_string_array();
+	ZN_TEST_ASSERT(serialized_id_map.size() == 2);
+	ZN_TEST_ASSERT(serialized_id_map[0] == "cube");
+	ZN_TEST_ASSERT(serialized_id_map[1] == "air");
+}
+
+} // namespace zylann::voxel::tests
@@ -0,0 +1,10 @@
+#ifndef VOXEL_TESTS_BLOCKY_TYPE_LIBRARY_H
+#define VOXEL_TESTS_BLOCKY_TYPE_LIBRARY_H
+
+namespace zylann::voxel::tests {
+
+void test_blocky_type_library_id_map();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_BLOCKY_TYPE_LIBRARY_H
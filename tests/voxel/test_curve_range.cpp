@@ -1,5 +1,7 @@
 #include "test_curve_range.h"
+#include "../../generators/graph/curve_lut.h"
 #include "../../generators/graph/range_utility.h"
+#include "../../util/containers/fixed_array.h"
 #include "../../util/containers/std_vector.h"
 #include "../../util/godot/classes/curve.h"
 #include "../testing.h"
@@ -20,25 +22,27 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0, 0));
 		curve->add_point(Vector2(1, 1));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 1);
 		ZN_TEST_ASSERT(sections[0].x_min == 0.f);
 		ZN_TEST_ASSERT(sections[0].x_max == 1.f);
 		ZN_TEST_ASSERT(sections[0].y_min == 0.f);
 		ZN_TEST_ASSERT(sections[0].y_max == 1.f);
 		{
-			math::Interval yi = get_curve_range(**curve, sections, math::Interval(0.f, 1.f));
+			math::Interval yi = get_curve_range(lut, sections, math::Interval(0.f, 1.f));
 			ZN_TEST_ASSERT(L::is_equal_approx(yi.min, 0.f));
 			ZN_TEST_ASSERT(L::is_equal_approx(yi.max, 1.f));
 		}
 		{
-			math::Interval yi = get_curve_range(**curve, sections, math::Interval(-2.f, 2.f));
+			math::Interval yi = get_curve_range(lut, sections, math::Interval(-2.f, 2.f));
 			ZN_TEST_ASSERT(L::is_equal_approx(yi.min, 0.f));
 			ZN_TEST_ASSERT(L::is_equal_approx(yi.max, 1.f));
 		}
 		{
 			math::Interval xi(0.2f, 0.8f);
-			math::Interval yi = get_curve_range(**curve, sections, xi);
+			math::Interval yi = get_curve_range(lut, sections, xi);
 			math::Interval yi_expected(curve->sample_baked(xi.min), curve->sample_baked(xi.max));
 			ZN_TEST_ASSERT(L::is_equal_approx(yi.min, yi_expected.min));
 			ZN_TEST_ASSERT(L::is_equal_approx(yi.max, yi_expected.max));
@@ -51,7 +55,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0, 0));
 		curve->add_point(Vector2(1, 0));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 1);
 		ZN_TEST_ASSERT(sections[0].x_min == 0.f);
 		ZN_TEST_ASSERT(sections[0].x_max == 1.f);
@@ -66,7 +72,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0.5, 1));
 		curve->add_point(Vector2(1, 1));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 1);
 	}
 	{
@@ -77,7 +85,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0.5, 0));
 		curve->add_point(Vector2(1, 1));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 1);
 	}
 	{
@@ -89,7 +99,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0.6, 1));
 		curve->add_point(Vector2(1, 1));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 1);
 	}
 	{
@@ -101,7 +113,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0.6, 0));
 		curve->add_point(Vector2(1, 1));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 3);
 		ZN_TEST_ASSERT(sections[0].x_min == 0.f);
 		ZN_TEST_ASSERT(sections[2].x_max == 1.f);
@@ -114,7 +128,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0.5, 1));
 		curve->add_point(Vector2(1, 0));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 2);
 	}
 	{
@@ -124,7 +140,9 @@ void test_get_curve_monotonic_sections() {
 		curve->add_point(Vector2(0, 0), 0.f, 1.f);
 		curve->add_point(Vector2(1, 0));
 		StdVector<CurveMonotonicSection> sections;
-		get_curve_monotonic_sections(**curve, sections);
+		CurveLUT lut;
+		lut.create(**curve);
+		get_curve_monotonic_sections(lut, sections);
 		ZN_TEST_ASSERT(sections.size() == 2);
 		ZN_TEST_ASSERT(sections[0].x_min == 0.f);
 		ZN_TEST_ASSERT(sections[0].y_max >= 0.1f);
@@ -132,4 +150,34 @@ void test_get_curve_monotonic_sections() {
 	}
 }
 
+void test_curve_lut() {
+	Ref<Curve> curve;
+	curve.instantiate();
+	curve->add_point(Vector2(0, 0.5));
+	curve->add_point(Vector2(0.3, 1));
+	curve->add_point(Vector2(1, -1));
+	CurveLUT lut;
+	lut.create(**curve);
+	ZN_TEST_ASSERT(lut.get_resolution() == static_cast<unsigned int>(curve->get_bake_resolution()));
+
+	// Including values outside of the curve's range
+	FixedArray<float, 8> x_values;
+	x_values[0] = -1.f;
+	x_values[1] = 0.f;
+	x_values[2] = 0.05f;
+	x_values[3] = 0.3f;
+	x_values[4] = 0.5f;
+	x_values[5] = 0.777f;
+	x_values[6] = 1.f;
+	x_values[7] = 2.f;
+	FixedArray<float, 8> y_values;
+	lut.sample(Span<const float>(x_values.data(), x_values.size()), to_span(y_values));
+
+	for (unsigned int i = 0; i < x_values.size(); ++i) {
+		const float expected = curve->sample_baked(x_values[i]);
+		ZN_TEST_ASSERT(Math::is_equal_approx(lut.sample(x_values[i]), expected));
+		ZN_TEST_ASSERT(Math::is_equal_approx(y_values[i], expected));
+	}
+}
+
 } // namespace zylann::voxel::tests
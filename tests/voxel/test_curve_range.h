@@ -4,6 +4,7 @@
 namespace zylann::voxel::tests {
 
 void test_get_curve_monotonic_sections();
+void test_curve_lut();
 
 } // namespace zylann::voxel::tests
 
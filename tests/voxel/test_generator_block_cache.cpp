@@ -0,0 +1,107 @@
+#include "test_generator_block_cache.h"
+#include "../../generators/simple/voxel_generator_flat.h"
+#include "../../generators/voxel_generator_block_cache.h"
+#include "../../storage/voxel_buffer.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+namespace {
+
+VolumeID make_volume_id(uint16_t index) {
+	VolumeID id;
+	id.index = index;
+	return id;
+}
+
+} // namespace
+
+void test_generator_block_cache() {
+	const VolumeID volume_a = make_volume_id(0);
+	const VolumeID volume_b = make_volume_id(1);
+	const Vector3i bpos(1, -2, 3);
+	const uint8_t block_size = 16;
+
+	VoxelBuffer generated(VoxelBuffer::ALLOCATOR_DEFAULT);
+	generated.create(Vector3iUtil::create(block_size));
+	generated.set_voxel(42, Vector3i(1, 2, 3), VoxelBuffer::CHANNEL_TYPE);
+
+	VoxelBuffer obtained(VoxelBuffer::ALLOCATOR_DEFAULT);
+	bool max_lod_hint = false;
+
+	VoxelGeneratorBlockCache cache;
+	cache.register_user(volume_a);
+
+	// A single volume doesn't share anything
+	cache.put(bpos, 0, block_size, volume_a, generated, true, cache.get_revision());
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, block_size, volume_a, obtained, max_lod_hint));
+
+	cache.register_user(volume_b);
+
+	// Outdated results are ignored
+	const uint32_t old_revision = cache.get_revision();
+	cache.clear();
+	cache.put(bpos, 0, block_size, volume_a, generated, true, old_revision);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+
+	cache.put(bpos, 0, block_size, volume_a, generated, true, cache.get_revision());
+	// Different LOD or block size
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 1, block_size, volume_b, obtained, max_lod_hint));
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, 32, volume_b, obtained, max_lod_hint));
+
+	ZN_TEST_ASSERT(cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+	ZN_TEST_ASSERT(max_lod_hint);
+	ZN_TEST_ASSERT(obtained.equals(generated));
+
+	// Both volumes got it, so it is no longer kept
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+
+	// A block still awaited by the remaining volume is kept when the volume that generated it goes away
+	const VolumeID volume_c = make_volume_id(2);
+	cache.register_user(volume_c);
+	cache.put(bpos, 0, block_size, volume_a, generated, false, cache.get_revision());
+	cache.unregister_user(volume_a);
+	ZN_TEST_ASSERT(cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+	ZN_TEST_ASSERT(!max_lod_hint);
+}
+
+void test_generator_block_cache_parameter_change() {
+	const VolumeID volume_a = make_volume_id(0);
+	const VolumeID volume_b = make_volume_id(1);
+	const Vector3i bpos(0, 0, 0);
+	const uint8_t block_size = 16;
+
+	Ref<VoxelGeneratorFlat> generator;
+	generator.instantiate();
+	VoxelGeneratorBlockCache &cache = generator->get_block_cache();
+	cache.register_user(volume_a);
+	cache.register_user(volume_b);
+
+	VoxelBuffer generated(VoxelBuffer::ALLOCATOR_DEFAULT);
+	generated.create(Vector3iUtil::create(block_size));
+	VoxelBuffer obtained(VoxelBuffer::ALLOCATOR_DEFAULT);
+	bool max_lod_hint = false;
+
+	// Setter not emitting `changed`
+	cache.put(bpos, 0, block_size, volume_a, generated, false, cache.get_revision());
+	generator->set_height(generator->get_height() + 10.f);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+
+	// Setter emitting `changed`
+	cache.put(bpos, 0, block_size, volume_a, generated, false, cache.get_revision());
+	const VoxelBuffer::ChannelId other_channel =
+			generator->get_channel() == VoxelBuffer::CHANNEL_SDF ? VoxelBuffer::CHANNEL_TYPE : VoxelBuffer::CHANNEL_SDF;
+	generator->set_channel(other_channel);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+
+	// Result of a generation started before the change
+	const uint32_t revision = cache.get_revision();
+	generator->set_voxel_type(generator->get_voxel_type() + 1);
+	cache.put(bpos, 0, block_size, volume_a, generated, false, revision);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, block_size, volume_b, obtained, max_lod_hint));
+
+	cache.unregister_user(volume_a);
+	cache.unregister_user(volume_b);
+}
+
+} // namespace zylann::voxel::tests
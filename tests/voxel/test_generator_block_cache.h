@@ -0,0 +1,11 @@
+#ifndef VOXEL_TESTS_GENERATOR_BLOCK_CACHE_H
+#define VOXEL_TESTS_GENERATOR_BLOCK_CACHE_H
+
+namespace zylann::voxel::tests {
+
+void test_generator_block_cache();
+void test_generator_block_cache_parameter_change();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_GENERATOR_BLOCK_CACHE_H
@@ -0,0 +1,108 @@
+#include "test_mesh_batch_vlt.h"
+#include "../../terrain/variable_lod/mesh_batch_vlt.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+void test_mesh_batch_vlt_append_surfaces() {
+	struct L {
+		static VoxelMesher::Output::Surface make_triangle(Vector3 origin, bool with_normals) {
+			PackedVector3Array positions;
+			positions.push_back(origin);
+			positions.push_back(origin + Vector3(1, 0, 0));
+			positions.push_back(origin + Vector3(0, 1, 0));
+
+			PackedInt32Array indices;
+			indices.push_back(0);
+			indices.push_back(1);
+			indices.push_back(2);
+
+			VoxelMesher::Output::Surface surface;
+			surface.arrays.resize(Mesh::ARRAY_MAX);
+			surface.arrays[Mesh::ARRAY_VERTEX] = positions;
+			surface.arrays[Mesh::ARRAY_INDEX] = indices;
+
+			if (with_normals) {
+				PackedVector3Array normals;
+				normals.resize(3);
+				normals.fill(Vector3(0, 0, 1));
+				surface.arrays[Mesh::ARRAY_NORMAL] = normals;
+			}
+			return surface;
+		}
+	};
+
+	StdVector<VoxelMesher::Output::Surface> dst;
+
+	// Merging two blocks
+	{
+		const VoxelMesher::Output::Surface s0 = L::make_triangle(Vector3(), true);
+		const VoxelMesher::Output::Surface s1 = L::make_triangle(Vector3(), true);
+		ZN_TEST_ASSERT(append_mesh_block_surfaces(dst, Span<const VoxelMesher::Output::Surface>(&s0, 1), Vector3(), 0));
+		const Vector3 offset(16, 0, 0);
+		ZN_TEST_ASSERT(append_mesh_block_surfaces(dst, Span<const VoxelMesher::Output::Surface>(&s1, 1), offset, 0));
+
+		// Source arrays must not have been modified
+		const PackedVector3Array s1_positions = s1.arrays[Mesh::ARRAY_VERTEX];
+		ZN_TEST_ASSERT(s1_positions[0] == Vector3());
+	}
+
+	ZN_TEST_ASSERT(dst.size() == 1);
+	{
+		const PackedVector3Array positions = dst[0].arrays[Mesh::ARRAY_VERTEX];
+		const PackedVector3Array normals = dst[0].arrays[Mesh::ARRAY_NORMAL];
+		const PackedInt32Array indices = dst[0].arrays[Mesh::ARRAY_INDEX];
+		ZN_TEST_ASSERT(positions.size() == 6);
+		ZN_TEST_ASSERT(normals.size() == 6);
+		ZN_TEST_ASSERT(indices.size() == 6);
+		ZN_TEST_ASSERT(positions[0] == Vector3(0, 0, 0));
+		ZN_TEST_ASSERT(positions[3] == Vector3(16, 0, 0));
+		ZN_TEST_ASSERT(positions[4] == Vector3(17, 0, 0));
+		// Indices of the second block are rebased after vertices of the first one
+		ZN_TEST_ASSERT(indices[0] == 0);
+		ZN_TEST_ASSERT(indices[3] == 3);
+		ZN_TEST_ASSERT(indices[5] == 5);
+	}
+
+	// A block with a different format can't be merged, and must not leave anything partially appended
+	{
+		FixedArray<VoxelMesher::Output::Surface, 2> src;
+		// This one is compatible, but comes before the incompatible one
+		src[0] = L::make_triangle(Vector3(), true);
+		src[1] = L::make_triangle(Vector3(), false);
+		src[1].material_index = 1;
+		// Same material as the incompatible one, so they would end up in the same surface
+		VoxelMesher::Output::Surface s2 = L::make_triangle(Vector3(), true);
+		s2.material_index = 1;
+		ZN_TEST_ASSERT(append_mesh_block_surfaces(dst, Span<const VoxelMesher::Output::Surface>(&s2, 1), Vector3(), 0));
+		ZN_TEST_ASSERT(dst.size() == 2);
+
+		ZN_TEST_ASSERT(!append_mesh_block_surfaces(dst, to_span_const(src), Vector3(32, 0, 0), 0));
+
+		ZN_TEST_ASSERT(dst.size() == 2);
+		const PackedVector3Array positions = dst[0].arrays[Mesh::ARRAY_VERTEX];
+		const PackedInt32Array indices = dst[0].arrays[Mesh::ARRAY_INDEX];
+		ZN_TEST_ASSERT(positions.size() == 6);
+		ZN_TEST_ASSERT(indices.size() == 6);
+		const PackedVector3Array positions1 = dst[1].arrays[Mesh::ARRAY_VERTEX];
+		ZN_TEST_ASSERT(positions1.size() == 3);
+	}
+
+	// Released surfaces only keep what's needed to reload them from the mesh
+	{
+		StdVector<VoxelMesher::Output::Surface> surfaces;
+		surfaces.push_back(L::make_triangle(Vector3(), true));
+		// Empty surface, would not be present in the mesh
+		surfaces.push_back(VoxelMesher::Output::Surface());
+		surfaces.push_back(L::make_triangle(Vector3(), true));
+		surfaces[2].material_index = 2;
+
+		release_mesh_block_surfaces(surfaces);
+		ZN_TEST_ASSERT(surfaces.size() == 2);
+		ZN_TEST_ASSERT(surfaces[1].material_index == 2);
+		ZN_TEST_ASSERT(surfaces[0].arrays.is_empty());
+		ZN_TEST_ASSERT(are_mesh_block_surfaces_released(to_span(surfaces)));
+	}
+}
+
+} // namespace zylann::voxel::tests
@@ -0,0 +1,10 @@
+#ifndef VOXEL_TESTS_MESH_BATCH_VLT_H
+#define VOXEL_TESTS_MESH_BATCH_VLT_H
+
+namespace zylann::voxel::tests {
+
+void test_mesh_batch_vlt_append_surfaces();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_MESH_BATCH_VLT_H
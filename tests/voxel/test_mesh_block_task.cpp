@@ -0,0 +1,91 @@
+#include "test_mesh_block_task.h"
+#include "../../meshers/cubes/voxel_mesher_cubes.h"
+#include "../../meshers/mesh_block_task.h"
+#include "../../storage/voxel_data.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+namespace {
+
+// Simulates events happening while a meshing task runs, by cancelling a token when voxels get generated
+class TestCancellingGenerator : public VoxelGenerator {
+public:
+	TaskCancellationToken token_to_cancel;
+	unsigned int call_count = 0;
+
+	Result generate_block(VoxelQueryData &input) override {
+		++call_count;
+		if (token_to_cancel.is_valid()) {
+			token_to_cancel.cancel();
+		}
+		return Result();
+	}
+};
+
+} // namespace
+
+void test_mesh_block_task_repeated_reschedules() {
+	Ref<VoxelMesherCubes> mesher;
+	mesher.instantiate();
+
+	Ref<TestCancellingGenerator> generator;
+	generator.instantiate();
+
+	std::shared_ptr<MeshingDependency> meshing_dependency;
+	MeshingDependency::reset(meshing_dependency, mesher, generator);
+
+	std::shared_ptr<VoxelData> data = make_shared_instance<VoxelData>();
+
+	struct L {
+		static MeshBlockTask *create_task(
+				std::shared_ptr<MeshingDependency> meshing_dependency, std::shared_ptr<VoxelData> data) {
+			MeshBlockTask *task = ZN_NEW(MeshBlockTask);
+			task->meshing_dependency = meshing_dependency;
+			task->data = data;
+			task->require_visual = false;
+			// No blocks are provided, so all voxels get generated
+			task->blocks_count = 27;
+			return task;
+		}
+	};
+
+	// A block gets edited every frame, so a new task is scheduled for it every frame
+
+	// Frame 1: task A is scheduled
+	TaskCancellationToken start_token_a = TaskCancellationToken::create();
+	MeshBlockTask *task_a = L::create_task(meshing_dependency, data);
+	task_a->start_cancellation_token = start_token_a;
+
+	// Frame 2: task B replaces task A before A started. A doesn't need to run anymore.
+	start_token_a.cancel();
+	TaskCancellationToken start_token_b = TaskCancellationToken::create();
+	MeshBlockTask *task_b = L::create_task(meshing_dependency, data);
+	task_b->start_cancellation_token = start_token_b;
+	ZN_TEST_ASSERT(task_a->is_cancelled());
+	ZN_TEST_ASSERT(!task_b->is_cancelled());
+
+	// Frame 3: task C gets scheduled while B is running. B must finish, otherwise with continuous edits no mesh would
+	// ever complete.
+	generator->token_to_cancel = start_token_b;
+	ThreadedTaskContext ctx(0, TaskPriority());
+	task_b->run(ctx);
+	ZN_TEST_ASSERT(generator->call_count > 0);
+	ZN_TEST_ASSERT(start_token_b.is_cancelled());
+	ZN_TEST_ASSERT(!task_b->is_cancelled());
+
+	// The block gets unloaded while task C is running. That one can stop early.
+	TaskCancellationToken unload_token = TaskCancellationToken::create();
+	MeshBlockTask *task_c = L::create_task(meshing_dependency, data);
+	task_c->cancellation_token = unload_token;
+	task_c->start_cancellation_token = TaskCancellationToken::create();
+	generator->token_to_cancel = unload_token;
+	task_c->run(ctx);
+	ZN_TEST_ASSERT(task_c->is_cancelled());
+
+	ZN_DELETE(task_a);
+	ZN_DELETE(task_b);
+	ZN_DELETE(task_c);
+}
+
+} // namespace zylann::voxel::tests
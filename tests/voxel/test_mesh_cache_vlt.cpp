@@ -0,0 +1,65 @@
+#include "test_mesh_cache_vlt.h"
+#include "../../terrain/variable_lod/mesh_cache_vlt.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+void test_mesh_cache_vlt_invalidate_in_flight() {
+	struct L {
+		static VoxelEngine::BlockMeshOutput make_output(Vector3i bpos, uint8_t lod_index) {
+			VoxelEngine::BlockMeshOutput output;
+			output.type = VoxelEngine::BlockMeshOutput::TYPE_MESHED;
+			output.position = bpos;
+			output.lod = lod_index;
+			output.has_mesh_resource = true;
+			output.visual_was_required = true;
+			return output;
+		}
+	};
+
+	MeshCacheVLT cache;
+	cache.set_capacity(16);
+
+	const Vector3i bpos(1, 2, 3);
+	VoxelEngine::BlockMeshOutput cached_output;
+
+	// Meshing is scheduled with the current revision
+	const uint32_t revision0 = cache.get_revision();
+
+	// Voxels get edited while the task is running. It might have read voxels before the edit.
+	cache.invalidate(Box3i(bpos, Vector3i(1, 1, 1)), 0);
+
+	// The result comes back, and must not be cached, even though the block itself is up to date again by then
+	cache.put(L::make_output(bpos, 0), revision0);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, cached_output));
+
+	// Edits elsewhere also prevent caching, since which blocks a task read is not tracked
+	const uint32_t revision1 = cache.get_revision();
+	cache.invalidate(Box3i(Vector3i(10, 10, 10), Vector3i(1, 1, 1)), 1);
+	cache.put(L::make_output(bpos, 0), revision1);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, cached_output));
+
+	// Without invalidation in the meantime, the result is cached
+	const uint32_t revision2 = cache.get_revision();
+	cache.put(L::make_output(bpos, 0), revision2);
+	ZN_TEST_ASSERT(cache.try_get(bpos, 0, cached_output));
+	ZN_TEST_ASSERT(cached_output.position == bpos);
+
+	// Invalidating after the result was cached removes it
+	cache.invalidate(Box3i(bpos - Vector3i(1, 1, 1), Vector3i(3, 3, 3)), 0);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, cached_output));
+
+	// Other LODs are not affected
+	const uint32_t revision3 = cache.get_revision();
+	cache.put(L::make_output(bpos, 1), revision3);
+	cache.invalidate(Box3i(bpos, Vector3i(1, 1, 1)), 0);
+	ZN_TEST_ASSERT(cache.try_get(bpos, 1, cached_output));
+
+	// Clearing is an invalidation too
+	const uint32_t revision4 = cache.get_revision();
+	cache.clear();
+	cache.put(L::make_output(bpos, 0), revision4);
+	ZN_TEST_ASSERT(!cache.try_get(bpos, 0, cached_output));
+}
+
+} // namespace zylann::voxel::tests
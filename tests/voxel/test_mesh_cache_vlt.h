@@ -0,0 +1,10 @@
+#ifndef VOXEL_TESTS_MESH_CACHE_VLT_H
+#define VOXEL_TESTS_MESH_CACHE_VLT_H
+
+namespace zylann::voxel::tests {
+
+void test_mesh_cache_vlt_invalidate_in_flight();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_MESH_CACHE_VLT_H
@@ -0,0 +1,149 @@
+#include "test_mesh_recycling.h"
+#include "../../meshers/cubes/voxel_mesher_cubes.h"
+#include "../../meshers/mesh_block_task.h"
+#include "../../meshers/mesh_recycling.h"
+#include "../../storage/voxel_buffer.h"
+#include "../../util/godot/classes/rendering_server.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+void test_mesh_signature() {
+	Ref<VoxelMesherCubes> mesher;
+	mesher.instantiate();
+	mesher->set_color_mode(VoxelMesherCubes::COLOR_RAW);
+
+	struct L {
+		static MeshSignature build(VoxelMesherCubes &mesher, const VoxelBuffer &vb) {
+			VoxelMesher::Input input{ vb, nullptr, nullptr, Vector3i(), 0, false };
+			VoxelMesher::Output output;
+			mesher.build(output, input);
+			StdVector<uint16_t> material_indices;
+			return compute_mesh_signature(output, material_indices);
+		}
+	};
+
+	VoxelBuffer vb(VoxelBuffer::ALLOCATOR_DEFAULT);
+	vb.create(8, 8, 8);
+	vb.set_channel_depth(VoxelBuffer::CHANNEL_COLOR, VoxelBuffer::DEPTH_16_BIT);
+	vb.set_voxel(Color8(0, 255, 0, 255).to_u16(), Vector3i(3, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+
+	const MeshSignature s0 = L::build(**mesher, vb);
+	ZN_TEST_ASSERT(s0.valid);
+
+	// Same voxels produce the same mesh
+	const MeshSignature s1 = L::build(**mesher, vb);
+	ZN_TEST_ASSERT(s0 == s1);
+
+	// Different color: same topology, different vertex data
+	vb.set_voxel(Color8(255, 0, 0, 255).to_u16(), Vector3i(3, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	const MeshSignature s2 = L::build(**mesher, vb);
+	ZN_TEST_ASSERT(s2.layout_hash == s0.layout_hash);
+	ZN_TEST_ASSERT(s2.content_hash != s0.content_hash);
+
+	// Moved cube: same topology, different vertex data
+	vb.set_voxel(0, Vector3i(3, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	vb.set_voxel(Color8(255, 0, 0, 255).to_u16(), Vector3i(2, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	const MeshSignature s3 = L::build(**mesher, vb);
+	ZN_TEST_ASSERT(s3.layout_hash == s0.layout_hash);
+	ZN_TEST_ASSERT(s3.content_hash != s2.content_hash);
+
+	// Additional cube: different topology
+	vb.set_voxel(Color8(255, 0, 0, 255).to_u16(), Vector3i(5, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	const MeshSignature s4 = L::build(**mesher, vb);
+	ZN_TEST_ASSERT(s4.layout_hash != s0.layout_hash);
+}
+
+namespace {
+
+// RIDs get their ID from a global counter, so the difference between the IDs of two probes tells how many RIDs were
+// allocated in between.
+uint64_t allocate_probe_rid_id() {
+	RenderingServer &rs = *RenderingServer::get_singleton();
+	const RID rid = rs.mesh_create();
+	const uint64_t id = rid.get_id();
+	zylann::godot::free_rendering_server_rid(rs, rid);
+	return id;
+}
+
+} // namespace
+
+void test_mesh_recycling_update_allocates_nothing() {
+	Ref<VoxelMesherCubes> mesher;
+	mesher.instantiate();
+	mesher->set_color_mode(VoxelMesherCubes::COLOR_RAW);
+
+	VoxelBuffer vb(VoxelBuffer::ALLOCATOR_DEFAULT);
+	vb.create(8, 8, 8);
+	vb.set_channel_depth(VoxelBuffer::CHANNEL_COLOR, VoxelBuffer::DEPTH_16_BIT);
+
+	struct L {
+		static void build(VoxelMesherCubes &mesher, const VoxelBuffer &vb, VoxelMesher::Output &output) {
+			VoxelMesher::Input input{ vb, nullptr, nullptr, Vector3i(), 0, false };
+			mesher.build(output, input);
+		}
+	};
+
+	vb.set_voxel(Color8(0, 255, 0, 255).to_u16(), Vector3i(3, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	VoxelMesher::Output output0;
+	L::build(**mesher, vb, output0);
+
+	// Moved cube: same layout, different vertex data outside of the initial bounds
+	vb.set_voxel(0, Vector3i(3, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	vb.set_voxel(Color8(0, 255, 0, 255).to_u16(), Vector3i(2, 4, 4), VoxelBuffer::CHANNEL_COLOR);
+	VoxelMesher::Output output1;
+	L::build(**mesher, vb, output1);
+
+	StdVector<uint16_t> material_indices;
+	ZN_TEST_ASSERT(compute_mesh_signature(output0, material_indices).layout_hash ==
+			compute_mesh_signature(output1, material_indices).layout_hash);
+
+	StdVector<MeshSurfaceVertexData> vertex_data1;
+	if (!pack_mesh_vertex_data(output1, vertex_data1)) {
+		// Not supported, meshes are always built normally
+		return;
+	}
+	StdVector<MeshSurfaceVertexData> vertex_data0;
+	ZN_TEST_ASSERT(pack_mesh_vertex_data(output0, vertex_data0));
+
+	material_indices.clear();
+	Ref<ArrayMesh> mesh =
+			build_mesh(to_span_const(output0.surfaces), output0.primitive_type, output0.mesh_flags, material_indices);
+	ZN_TEST_ASSERT(mesh.is_valid());
+	const RID mesh_rid = mesh->get_rid();
+	const AABB built_aabb = mesh->get_aabb();
+
+	{
+		const uint64_t id0 = allocate_probe_rid_id();
+		update_mesh_vertex_data(**mesh, to_span_const(vertex_data1));
+		const uint64_t id1 = allocate_probe_rid_id();
+		// Only the second probe allocated a RID
+		ZN_TEST_ASSERT(id1 == id0 + 1);
+	}
+	ZN_TEST_ASSERT(mesh->get_rid() == mesh_rid);
+	// Vertices moved outside of the bounds the mesh was built with
+	ZN_TEST_ASSERT(mesh->get_custom_aabb() != AABB());
+	ZN_TEST_ASSERT(mesh->get_custom_aabb().encloses(vertex_data1[0].aabb));
+
+	{
+		const uint64_t id0 = allocate_probe_rid_id();
+		update_mesh_vertex_data(**mesh, to_span_const(vertex_data0));
+		const uint64_t id1 = allocate_probe_rid_id();
+		ZN_TEST_ASSERT(id1 == id0 + 1);
+	}
+	// Vertices are back inside the initial bounds, the custom AABB is no longer needed
+	ZN_TEST_ASSERT(mesh->get_custom_aabb() == AABB());
+	ZN_TEST_ASSERT(mesh->get_aabb() == built_aabb);
+
+	// Building a new mesh instead does allocate, which makes sure the probes detect it
+	{
+		const uint64_t id0 = allocate_probe_rid_id();
+		material_indices.clear();
+		Ref<ArrayMesh> mesh1 = build_mesh(
+				to_span_const(output1.surfaces), output1.primitive_type, output1.mesh_flags, material_indices);
+		const uint64_t id1 = allocate_probe_rid_id();
+		ZN_TEST_ASSERT(id1 > id0 + 1);
+	}
+}
+
+} // namespace zylann::voxel::tests
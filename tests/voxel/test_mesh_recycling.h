@@ -0,0 +1,11 @@
+#ifndef VOXEL_TESTS_MESH_RECYCLING_H
+#define VOXEL_TESTS_MESH_RECYCLING_H
+
+namespace zylann::voxel::tests {
+
+void test_mesh_signature();
+void test_mesh_recycling_update_allocates_nothing();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_MESH_RECYCLING_H
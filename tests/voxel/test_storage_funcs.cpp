@@ -20,6 +20,31 @@ void test_encode_weights_packed_u16() {
 	ZN_TEST_ASSERT(weights == decoded_weights);
 }
 
+void test_decode_packed_u16_bulk() {
+	// Bulk decoding must give the same results as decoding voxels one by one
+	StdVector<uint16_t> packed_values;
+	for (unsigned int i = 0; i < 1000; ++i) {
+		// Some arbitrary values covering all nibbles
+		packed_values.push_back((i * 7919) & 0xffff);
+	}
+	packed_values.push_back(0);
+	packed_values.push_back(0xffff);
+
+	StdVector<uint32_t> decoded_indices;
+	decoded_indices.resize(packed_values.size());
+	decode_indices_from_packed_u16(to_span_const(packed_values), to_span(decoded_indices));
+
+	StdVector<uint32_t> decoded_weights;
+	decoded_weights.resize(packed_values.size());
+	decode_weights_from_packed_u16(to_span_const(packed_values), to_span(decoded_weights));
+
+	for (unsigned int i = 0; i < packed_values.size(); ++i) {
+		const uint16_t packed = packed_values[i];
+		ZN_TEST_ASSERT(unpack_bytes_u32(decoded_indices[i]) == decode_indices_from_packed_u16(packed));
+		ZN_TEST_ASSERT(unpack_bytes_u32(decoded_weights[i]) == decode_weights_from_packed_u16(packed));
+	}
+}
+
 void test_copy_3d_region_zxy() {
 	struct L {
 		static void compare(Span<const uint16_t> srcs, Vector3i src_size, Vector3i src_min, Vector3i src_max,
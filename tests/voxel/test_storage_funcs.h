@@ -4,6 +4,7 @@
 namespace zylann::voxel::tests {
 
 void test_encode_weights_packed_u16();
+void test_decode_packed_u16_bulk();
 void test_copy_3d_region_zxy();
 void test_transform_3d_array_zxy();
 
@@ -0,0 +1,56 @@
+#include "test_stream_memory.h"
+#include "../../storage/voxel_buffer.h"
+#include "../../streams/voxel_stream_memory.h"
+#include "../testing.h"
+
+namespace zylann::voxel::tests {
+
+void test_stream_memory() {
+	Ref<VoxelStreamMemory> stream;
+	stream.instantiate();
+
+	VoxelBuffer saved_voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+	saved_voxels.create(Vector3i(16, 16, 16));
+	saved_voxels.set_channel_depth(VoxelBuffer::CHANNEL_SDF, VoxelBuffer::DEPTH_16_BIT);
+	saved_voxels.fill_f(1.f, VoxelBuffer::CHANNEL_SDF);
+	for (int z = 0; z < 16; ++z) {
+		for (int x = 0; x < 16; ++x) {
+			saved_voxels.set_voxel_f(-0.5f, Vector3i(x, 3, z), VoxelBuffer::CHANNEL_SDF);
+		}
+	}
+	saved_voxels.set_voxel(7, Vector3i(1, 2, 3), VoxelBuffer::CHANNEL_TYPE);
+
+	const Vector3i bpos(-1, 2, 3);
+	const uint8_t lod_index = 1;
+
+	{
+		VoxelStream::VoxelQueryData q{ saved_voxels, bpos, lod_index, VoxelStream::RESULT_ERROR };
+		stream->save_voxel_block(q);
+	}
+	{
+		VoxelBuffer loaded_voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+		VoxelStream::VoxelQueryData q{ loaded_voxels, bpos, lod_index, VoxelStream::RESULT_ERROR };
+		stream->load_voxel_block(q);
+		ZN_TEST_ASSERT(q.result == VoxelStream::RESULT_BLOCK_FOUND);
+		ZN_TEST_ASSERT(loaded_voxels.equals(saved_voxels));
+	}
+	{
+		// Same position, other LOD
+		VoxelBuffer loaded_voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+		VoxelStream::VoxelQueryData q{ loaded_voxels, bpos, 0, VoxelStream::RESULT_ERROR };
+		stream->load_voxel_block(q);
+		ZN_TEST_ASSERT(q.result == VoxelStream::RESULT_BLOCK_NOT_FOUND);
+	}
+	{
+		VoxelStream::FullLoadingResult result;
+		stream->load_all_blocks(result);
+		ZN_TEST_ASSERT(result.blocks.size() == 1);
+		const VoxelStream::FullLoadingResult::Block &block = result.blocks[0];
+		ZN_TEST_ASSERT(block.position == bpos);
+		ZN_TEST_ASSERT(block.lod == lod_index);
+		ZN_TEST_ASSERT(block.voxels != nullptr);
+		ZN_TEST_ASSERT(block.voxels->equals(saved_voxels));
+	}
+}
+
+} // namespace zylann::voxel::tests
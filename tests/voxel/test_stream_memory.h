@@ -0,0 +1,10 @@
+#ifndef VOXEL_TESTS_STREAM_MEMORY_H
+#define VOXEL_TESTS_STREAM_MEMORY_H
+
+namespace zylann::voxel::tests {
+
+void test_stream_memory();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_STREAM_MEMORY_H
@@ -0,0 +1,385 @@
+#include "test_transvoxel.h"
+#include "../../meshers/transvoxel/transvoxel.h"
+#include "../../meshers/transvoxel/transvoxel_tables.cpp"
+#include "../../meshers/transvoxel/voxel_mesher_transvoxel.h"
+#include "../../storage/materials_4i4w.h"
+#include "../../storage/voxel_buffer.h"
+#include "../../util/godot/core/packed_arrays.h"
+#include "../../util/math/conv.h"
+#include "../../util/math/triangle.h"
+#include "../testing.h"
+
+#include <cstring>
+#include <utility>
+
+namespace zylann::voxel::tests {
+
+namespace {
+
+struct TransvoxelTestVertex {
+	Vector3f position;
+	Vector3f normal;
+};
+
+using TransvoxelTestTriangle = FixedArray<TransvoxelTestVertex, 3>;
+
+Vector3f normalized_not_null(Vector3f n) {
+	const float lengthsq = math::length_squared(n);
+	if (lengthsq == 0) {
+		return Vector3f(0, 1, 0);
+	} else {
+		const float length = Math::sqrt(lengthsq);
+		return Vector3f(n.x / length, n.y / length, n.z / length);
+	}
+}
+
+// Straightforward version of the regular mesh, as it was built when cells were iterated in XYZ order, one cell at a
+// time, before corner data got cached. Vertices are not shared, and only positions and normals are produced.
+// Expects 32-bit SDF.
+void build_regular_mesh_reference(
+		const VoxelBuffer &voxels, uint32_t lod_index, StdVector<TransvoxelTestTriangle> &out_triangles) {
+	struct L {
+		// Transvoxel expects the opposite sign convention
+		static float get_sdf(const VoxelBuffer &voxels, Vector3i pos) {
+			return -voxels.get_voxel_f(pos, VoxelBuffer::CHANNEL_SDF);
+		}
+
+		static Vector3f get_gradient(const VoxelBuffer &voxels, Vector3i pos) {
+			return Vector3f( //
+					get_sdf(voxels, pos - Vector3i(1, 0, 0)) - get_sdf(voxels, pos + Vector3i(1, 0, 0)),
+					get_sdf(voxels, pos - Vector3i(0, 1, 0)) - get_sdf(voxels, pos + Vector3i(0, 1, 0)),
+					get_sdf(voxels, pos - Vector3i(0, 0, 1)) - get_sdf(voxels, pos + Vector3i(0, 0, 1)));
+		}
+	};
+
+	const Vector3i min_pos = Vector3iUtil::create(transvoxel::MIN_PADDING);
+	const Vector3i max_pos = voxels.get_size() - Vector3iUtil::create(transvoxel::MAX_PADDING);
+
+	Vector3i pos;
+	for (pos.z = min_pos.z; pos.z < max_pos.z; ++pos.z) {
+		for (pos.y = min_pos.y; pos.y < max_pos.y; ++pos.y) {
+			for (pos.x = min_pos.x; pos.x < max_pos.x; ++pos.x) {
+				FixedArray<Vector3i, 8> corners;
+				FixedArray<float, 8> samples;
+				uint8_t case_code = 0;
+				for (unsigned int i = 0; i < corners.size(); ++i) {
+					corners[i] = pos + Vector3i(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+					samples[i] = L::get_sdf(voxels, corners[i]);
+					case_code |= (samples[i] < 0.f ? 1 : 0) << i;
+				}
+				if (case_code == 0 || case_code == 255) {
+					continue;
+				}
+
+				const transvoxel::tables::RegularCellData &cell_data = transvoxel::tables::get_regular_cell_data(
+						transvoxel::tables::get_regular_cell_class(case_code));
+				const unsigned int triangle_count = cell_data.geometryCounts & 0x0f;
+				const unsigned int vertex_count = (cell_data.geometryCounts & 0xf0) >> 4;
+
+				FixedArray<TransvoxelTestVertex, 12> cell_vertices;
+
+				for (unsigned int vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+					const unsigned short rvd = transvoxel::tables::get_regular_vertex_data(case_code, vertex_index);
+					const uint8_t v0 = (rvd >> 4) & 0xf;
+					const uint8_t v1 = rvd & 0xf;
+
+					const float sample0 = samples[v0];
+					const float sample1 = samples[v1];
+					const float t = sample1 / (sample1 - sample0);
+
+					const Vector3i p0 = (corners[v0] - min_pos) << lod_index;
+					const Vector3i p1 = (corners[v1] - min_pos) << lod_index;
+
+					TransvoxelTestVertex &vertex = cell_vertices[vertex_index];
+
+					if (t > 0.f && t < 1.f) {
+						const float t0 = t;
+						const float t1 = 1.f - t;
+						vertex.position = to_vec3f(p0) * t0 + to_vec3f(p1) * t1;
+						const Vector3f cg0 = L::get_gradient(voxels, corners[v0]);
+						const Vector3f cg1 = L::get_gradient(voxels, corners[v1]);
+						vertex.normal = normalized_not_null(cg0 * t0 + cg1 * t1);
+
+					} else {
+						// On one of the corners
+						const unsigned int vi = t == 0 ? v1 : v0;
+						vertex.position = to_vec3f(t == 0 ? p1 : p0);
+						vertex.normal = normalized_not_null(L::get_gradient(voxels, corners[vi]));
+					}
+				}
+
+				for (unsigned int ti = 0; ti < triangle_count; ++ti) {
+					TransvoxelTestTriangle triangle;
+					for (unsigned int j = 0; j < 3; ++j) {
+						triangle[j] = cell_vertices[cell_data.get_vertex_index(ti * 3 + j)];
+					}
+					if (math::is_triangle_degenerate_approx(
+								triangle[0].position, triangle[1].position, triangle[2].position, 0.000001f)) {
+						continue;
+					}
+					out_triangles.push_back(triangle);
+				}
+			}
+		}
+	}
+}
+
+void get_triangles(const transvoxel::MeshArrays &mesh, StdVector<TransvoxelTestTriangle> &out_triangles) {
+	ZN_TEST_ASSERT(mesh.normals.size() == mesh.vertices.size());
+	for (unsigned int ii = 0; ii < mesh.indices.size(); ii += 3) {
+		TransvoxelTestTriangle triangle;
+		for (unsigned int j = 0; j < 3; ++j) {
+			const unsigned int vi = mesh.indices[ii + j];
+			triangle[j] = TransvoxelTestVertex{ mesh.vertices[vi], mesh.normals[vi] };
+		}
+		out_triangles.push_back(triangle);
+	}
+}
+
+bool is_equal_approx(const TransvoxelTestTriangle &a, const TransvoxelTestTriangle &b) {
+	const float epsilon = 0.0001f;
+	for (unsigned int j = 0; j < 3; ++j) {
+		if (math::distance_squared(a[j].position, b[j].position) > epsilon * epsilon ||
+				math::distance_squared(a[j].normal, b[j].normal) > epsilon * epsilon) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+void test_transvoxel_texture_selection_same_indices() {
+	// Cells where all voxels have the same indices take a faster path to select textures. It must give the same results
+	// as the generic path, including when some textures have zero weight.
+
+	struct L {
+		static void build(transvoxel::MeshArrays &output, bool permute_indices) {
+			const Vector3i block_size(16 + transvoxel::MIN_PADDING + transvoxel::MAX_PADDING);
+
+			VoxelBuffer voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+			voxels.create(block_size);
+			voxels.set_channel_depth(VoxelBuffer::CHANNEL_INDICES, VoxelBuffer::DEPTH_16_BIT);
+			voxels.set_channel_depth(VoxelBuffer::CHANNEL_WEIGHTS, VoxelBuffer::DEPTH_16_BIT);
+
+			Vector3i pos;
+			for (pos.z = 0; pos.z < block_size.z; ++pos.z) {
+				for (pos.x = 0; pos.x < block_size.x; ++pos.x) {
+					for (pos.y = 0; pos.y < block_size.y; ++pos.y) {
+						// Bumpy ground
+						const float height = 8.5f + 0.3f * static_cast<float>((pos.x * 7 + pos.z * 3) % 5);
+						voxels.set_voxel_f(static_cast<float>(pos.y) - height, pos, VoxelBuffer::CHANNEL_SDF);
+
+						// Indices differ across the block so they don't take the uniform path
+						uint8_t indices[4];
+						uint8_t weights[4];
+						if (pos.x < 9) {
+							indices[0] = 1;
+							indices[1] = 2;
+							indices[2] = 3;
+							indices[3] = 4;
+							weights[0] = 255;
+							weights[1] = pos.z < 6 ? 0 : 128;
+							// Textures 3 and 4 have no weight at all
+							weights[2] = 0;
+							weights[3] = 0;
+						} else {
+							indices[0] = 5;
+							indices[1] = 6;
+							indices[2] = 7;
+							indices[3] = 8;
+							for (unsigned int i = 0; i < 4; ++i) {
+								weights[i] = 64;
+							}
+						}
+
+						if (permute_indices && ((pos.x + pos.y + pos.z) & 1) != 0) {
+							// Same textures stored in a different order. Neighbor voxels no longer have equal indices,
+							// so the generic path gets used for every cell.
+							std::swap(indices[0], indices[1]);
+							std::swap(weights[0], weights[1]);
+						}
+
+						voxels.set_voxel(encode_indices_to_packed_u16(indices[0], indices[1], indices[2], indices[3]),
+								pos, VoxelBuffer::CHANNEL_INDICES);
+						voxels.set_voxel(
+								encode_weights_to_packed_u16_lossy(weights[0], weights[1], weights[2], weights[3]), pos,
+								VoxelBuffer::CHANNEL_WEIGHTS);
+					}
+				}
+			}
+
+			transvoxel::Cache cache;
+			transvoxel::build_regular_mesh(voxels, VoxelBuffer::CHANNEL_SDF, 0, transvoxel::TEXTURES_BLEND_4_OVER_16,
+					cache, output, nullptr, nullptr);
+		}
+	};
+
+	transvoxel::MeshArrays fast_output;
+	L::build(fast_output, false);
+
+	transvoxel::MeshArrays generic_output;
+	L::build(generic_output, true);
+
+	ZN_TEST_ASSERT(fast_output.vertices.size() > 0);
+	ZN_TEST_ASSERT(fast_output.vertices == generic_output.vertices);
+	ZN_TEST_ASSERT(fast_output.indices == generic_output.indices);
+	ZN_TEST_ASSERT(fast_output.texturing_data.size() == generic_output.texturing_data.size());
+	for (unsigned int i = 0; i < fast_output.texturing_data.size(); ++i) {
+		ZN_TEST_ASSERT(fast_output.texturing_data[i] == generic_output.texturing_data[i]);
+	}
+}
+
+void test_transvoxel_regular_mesh_matches_reference() {
+	// Cells are iterated in an order optimized for the layout of voxels, with vertices reused between cells and corner
+	// data cached. The result must be the same triangles as a plain cell-by-cell polygonization.
+
+	const Vector3i block_size(16 + transvoxel::MIN_PADDING + transvoxel::MAX_PADDING);
+
+	VoxelBuffer voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+	voxels.create(block_size);
+	voxels.set_channel_depth(VoxelBuffer::CHANNEL_SDF, VoxelBuffer::DEPTH_32_BIT);
+	voxels.set_channel_depth(VoxelBuffer::CHANNEL_INDICES, VoxelBuffer::DEPTH_16_BIT);
+	voxels.set_channel_depth(VoxelBuffer::CHANNEL_WEIGHTS, VoxelBuffer::DEPTH_16_BIT);
+
+	Vector3i pos;
+	for (pos.z = 0; pos.z < block_size.z; ++pos.z) {
+		for (pos.x = 0; pos.x < block_size.x; ++pos.x) {
+			for (pos.y = 0; pos.y < block_size.y; ++pos.y) {
+				// Wavy ground with noise. Steps of 0.5 make some voxels land exactly on the isolevel, so vertices
+				// placed on corners get tested too.
+				const uint32_t h = Vector3iHasher::hash(pos);
+				const float noise = static_cast<float>(static_cast<int>(h % 7) - 3) * 0.5f;
+				const float wave = 3.f * Math::sin(pos.x * 0.4f) * Math::cos(pos.z * 0.3f);
+				const float sd = Math::round((static_cast<float>(pos.y) - 9.f + wave) * 2.f) * 0.5f + noise;
+				voxels.set_voxel_f(sd, pos, VoxelBuffer::CHANNEL_SDF);
+
+				// Texture indices change across the block, so some vertices can't be shared between cells
+				const uint8_t i0 = pos.x < 9 ? 1 : 5;
+				voxels.set_voxel(encode_indices_to_packed_u16(i0, i0 + 1, i0 + 2, i0 + 3), pos,
+						VoxelBuffer::CHANNEL_INDICES);
+				voxels.set_voxel(encode_weights_to_packed_u16_lossy(255, static_cast<uint8_t>(h >> 8), 0, 0), pos,
+						VoxelBuffer::CHANNEL_WEIGHTS);
+			}
+		}
+	}
+
+	for (uint32_t lod_index = 0; lod_index < 2; ++lod_index) {
+		StdVector<TransvoxelTestTriangle> expected_triangles;
+		build_regular_mesh_reference(voxels, lod_index, expected_triangles);
+		ZN_TEST_ASSERT(expected_triangles.size() > 0);
+
+		for (const transvoxel::TexturingMode texturing_mode :
+				{ transvoxel::TEXTURES_NONE, transvoxel::TEXTURES_BLEND_4_OVER_16 }) {
+			transvoxel::Cache cache;
+			transvoxel::MeshArrays mesh;
+			transvoxel::build_regular_mesh(
+					voxels, VoxelBuffer::CHANNEL_SDF, lod_index, texturing_mode, cache, mesh, nullptr, nullptr);
+
+			StdVector<TransvoxelTestTriangle> triangles;
+			get_triangles(mesh, triangles);
+			ZN_TEST_ASSERT(triangles.size() == expected_triangles.size());
+
+			// Order doesn't matter. Each triangle must match a different expected triangle.
+			StdVector<bool> matched;
+			matched.resize(expected_triangles.size(), false);
+			for (const TransvoxelTestTriangle &triangle : triangles) {
+				bool found = false;
+				for (unsigned int i = 0; i < expected_triangles.size(); ++i) {
+					if (!matched[i] && is_equal_approx(triangle, expected_triangles[i])) {
+						matched[i] = true;
+						found = true;
+						break;
+					}
+				}
+				ZN_TEST_ASSERT(found);
+			}
+		}
+	}
+}
+
+void test_transvoxel_simplify_keeps_texture_blending() {
+	// Flat ground where the weights of two textures swap sharply along X. The simplifier only looks at positions, so
+	// if nothing prevented it, vertices along that line could collapse into each other and textures would bleed.
+
+	Ref<VoxelMesherTransvoxel> mesher;
+	mesher.instantiate();
+	mesher->set_texturing_mode(VoxelMesherTransvoxel::TEXTURES_BLEND_4_OVER_16);
+	mesher->set_mesh_optimization_enabled(true);
+	mesher->set_mesh_optimization_target_ratio(0.1f);
+	mesher->set_mesh_optimization_error_threshold(0.5f);
+
+	const Vector3i block_size(16 + transvoxel::MIN_PADDING + transvoxel::MAX_PADDING);
+	const int boundary_x = 9;
+
+	VoxelBuffer voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+	voxels.create(block_size);
+	voxels.set_channel_depth(VoxelBuffer::CHANNEL_INDICES, VoxelBuffer::DEPTH_16_BIT);
+	voxels.set_channel_depth(VoxelBuffer::CHANNEL_WEIGHTS, VoxelBuffer::DEPTH_16_BIT);
+	// Same indices everywhere, so no seams are produced by texture changes
+	voxels.fill(encode_indices_to_packed_u16(1, 2, 3, 4), VoxelBuffer::CHANNEL_INDICES);
+
+	Vector3i pos;
+	for (pos.z = 0; pos.z < block_size.z; ++pos.z) {
+		for (pos.x = 0; pos.x < block_size.x; ++pos.x) {
+			for (pos.y = 0; pos.y < block_size.y; ++pos.y) {
+				voxels.set_voxel_f(static_cast<float>(pos.y) - 8.5f, pos, VoxelBuffer::CHANNEL_SDF);
+				const uint16_t weights = pos.x < boundary_x ? encode_weights_to_packed_u16_lossy(255, 0, 0, 0)
+															: encode_weights_to_packed_u16_lossy(0, 255, 0, 0);
+				voxels.set_voxel(weights, pos, VoxelBuffer::CHANNEL_WEIGHTS);
+			}
+		}
+	}
+
+	VoxelMesher::Input input{ voxels, nullptr, nullptr, Vector3i(), 0, false };
+	VoxelMesher::Output output;
+	mesher->build(output, input);
+	ZN_TEST_ASSERT(output.surfaces.size() == 1);
+
+	// The mesh before simplification remains in the thread-local cache of the mesher
+	const transvoxel::MeshArrays &src_mesh = VoxelMesherTransvoxel::get_mesh_cache_from_current_thread();
+	ZN_TEST_ASSERT(src_mesh.texturing_data.size() == src_mesh.vertices.size());
+
+	struct L {
+		static uint8_t get_weight0(const Vector2f texturing_data) {
+			uint32_t packed_weights;
+			memcpy(&packed_weights, &texturing_data.y, sizeof(packed_weights));
+			return packed_weights & 0xff;
+		}
+	};
+
+	// Vertices of triangles spanning both textures
+	StdVector<Vector3f> boundary_positions;
+	for (unsigned int ii = 0; ii < src_mesh.indices.size(); ii += 3) {
+		unsigned int first_texture_count = 0;
+		for (unsigned int j = 0; j < 3; ++j) {
+			if (L::get_weight0(src_mesh.texturing_data[src_mesh.indices[ii + j]]) > 128) {
+				++first_texture_count;
+			}
+		}
+		if (first_texture_count == 0 || first_texture_count == 3) {
+			continue;
+		}
+		for (unsigned int j = 0; j < 3; ++j) {
+			boundary_positions.push_back(src_mesh.vertices[src_mesh.indices[ii + j]]);
+		}
+	}
+	ZN_TEST_ASSERT(boundary_positions.size() > 0);
+
+	const Array &arrays = output.surfaces[0].arrays;
+	const PackedVector3Array dst_vertices = arrays[Mesh::ARRAY_VERTEX];
+	const PackedInt32Array dst_indices = arrays[Mesh::ARRAY_INDEX];
+
+	// Regions with a single texture must still have been simplified
+	ZN_TEST_ASSERT(static_cast<size_t>(dst_indices.size()) < src_mesh.indices.size());
+
+	for (const Vector3f boundary_pos : boundary_positions) {
+		bool found = false;
+		for (int i = 0; i < dst_vertices.size() && !found; ++i) {
+			found = to_vec3f(dst_vertices[i]) == boundary_pos;
+		}
+		ZN_TEST_ASSERT(found);
+	}
+}
+
+} // namespace zylann::voxel::tests
@@ -0,0 +1,12 @@
+#ifndef VOXEL_TESTS_TRANSVOXEL_H
+#define VOXEL_TESTS_TRANSVOXEL_H
+
+namespace zylann::voxel::tests {
+
+void test_transvoxel_texture_selection_same_indices();
+void test_transvoxel_regular_mesh_matches_reference();
+void test_transvoxel_simplify_keeps_texture_blending();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_TRANSVOXEL_H
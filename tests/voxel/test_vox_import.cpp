@@ -0,0 +1,121 @@
+#include "test_vox_import.h"
+#include "../../streams/vox/vox_data.h"
+#include "../testing.h"
+
+#ifdef TOOLS_ENABLED
+#include "../../editor/vox/vox_import_funcs.h"
+#include "../../meshers/cubes/voxel_mesher_cubes.h"
+#endif
+
+namespace zylann::voxel::tests {
+
+namespace {
+
+// Two identical boxes filled with color 1, and a row of two voxels of color 2 separated by an empty one.
+// Color indexes are in ZXY order, like models loaded from a .vox file.
+void make_test_models(FixedArray<magica::Model, 3> &models) {
+	magica::Model &box = models[0];
+	box.size = Vector3i(2, 2, 2);
+	box.color_indexes.resize(Vector3iUtil::get_volume(box.size), 1);
+
+	models[1] = box;
+
+	magica::Model &row = models[2];
+	row.size = Vector3i(3, 1, 1);
+	row.color_indexes = { 2, 0, 2 };
+}
+
+} // namespace
+
+void test_vox_find_unique_models() {
+	FixedArray<magica::Model, 3> models;
+	make_test_models(models);
+
+	StdVector<const magica::Model *> model_ptrs;
+	for (const magica::Model &model : models) {
+		model_ptrs.push_back(&model);
+	}
+
+	StdVector<unsigned int> model_to_unique;
+	magica::find_unique_models(to_span_const(model_ptrs), model_to_unique);
+
+	ZN_TEST_ASSERT(model_to_unique.size() == 3);
+	ZN_TEST_ASSERT(model_to_unique[0] == 0);
+	ZN_TEST_ASSERT(model_to_unique[1] == 0);
+	ZN_TEST_ASSERT(model_to_unique[2] == 2);
+
+	// Same contents but a different shape must not be merged
+	magica::Model transposed = models[2];
+	transposed.size = Vector3i(1, 1, 3);
+	model_ptrs.push_back(&transposed);
+
+	magica::find_unique_models(to_span_const(model_ptrs), model_to_unique);
+
+	ZN_TEST_ASSERT(model_to_unique.size() == 4);
+	ZN_TEST_ASSERT(model_to_unique[2] == 2);
+	ZN_TEST_ASSERT(model_to_unique[3] == 3);
+}
+
+#ifdef TOOLS_ENABLED
+
+void test_vox_mesh_unique_models() {
+	FixedArray<magica::Model, 3> models;
+	make_test_models(models);
+
+	StdVector<const magica::Model *> model_ptrs;
+	for (const magica::Model &model : models) {
+		model_ptrs.push_back(&model);
+	}
+
+	StdVector<unsigned int> model_to_unique;
+	magica::find_unique_models(to_span_const(model_ptrs), model_to_unique);
+
+	StdVector<const magica::Model *> unique_models;
+	for (unsigned int model_index = 0; model_index < model_to_unique.size(); ++model_index) {
+		if (model_to_unique[model_index] == model_index) {
+			unique_models.push_back(model_ptrs[model_index]);
+		}
+	}
+	ZN_TEST_ASSERT(unique_models.size() == 2);
+
+	Ref<VoxelColorPalette> palette;
+	palette.instantiate();
+	palette->set_color8(0, Color8(0, 0, 0, 0));
+	palette->set_color8(1, Color8(255, 0, 0, 255));
+	palette->set_color8(2, Color8(0, 255, 0, 255));
+
+	Ref<VoxelMesherCubes> mesher;
+	mesher.instantiate();
+	mesher->set_color_mode(VoxelMesherCubes::COLOR_MESHER_PALETTE);
+	mesher->set_palette(palette);
+	mesher->set_greedy_meshing_enabled(true);
+
+	// Meshing runs on the thread pool of the voxel engine
+	std::shared_ptr<magica::ModelMeshingOutputs> outputs = magica::mesh_models(to_span_const(unique_models), mesher);
+
+	ZN_TEST_ASSERT(outputs != nullptr);
+	ZN_TEST_ASSERT(outputs->outputs.size() == 2);
+	ZN_TEST_ASSERT(outputs->padded_sizes.size() == 2);
+
+	// Outputs are in the same order as the models that were passed in
+	const Vector3i padding = Vector3iUtil::create(VoxelMesherCubes::PADDING * 2);
+	ZN_TEST_ASSERT(outputs->padded_sizes[0] == models[0].size + padding);
+	ZN_TEST_ASSERT(outputs->padded_sizes[1] == models[2].size + padding);
+
+	// Only opaque colors are used, so each mesh has one surface
+	const VoxelMesher::Output &box_output = outputs->outputs[0];
+	ZN_TEST_ASSERT(box_output.surfaces.size() == 1);
+	const PackedVector3Array box_vertices = box_output.surfaces[0].arrays[Mesh::ARRAY_VERTEX];
+	// Greedy meshing turns the filled box into 6 quads
+	ZN_TEST_ASSERT(box_vertices.size() == 6 * 4);
+
+	const VoxelMesher::Output &row_output = outputs->outputs[1];
+	ZN_TEST_ASSERT(row_output.surfaces.size() == 1);
+	const PackedVector3Array row_vertices = row_output.surfaces[0].arrays[Mesh::ARRAY_VERTEX];
+	// The row is two separate cubes
+	ZN_TEST_ASSERT(row_vertices.size() == 2 * 6 * 4);
+}
+
+#endif // TOOLS_ENABLED
+
+} // namespace zylann::voxel::tests
@@ -0,0 +1,13 @@
+#ifndef VOXEL_TESTS_VOX_IMPORT_H
+#define VOXEL_TESTS_VOX_IMPORT_H
+
+namespace zylann::voxel::tests {
+
+void test_vox_find_unique_models();
+#ifdef TOOLS_ENABLED
+void test_vox_mesh_unique_models();
+#endif
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_VOX_IMPORT_H
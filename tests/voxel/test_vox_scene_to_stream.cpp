@@ -0,0 +1,228 @@
+#include "test_vox_scene_to_stream.h"
+#include "../../streams/vox/vox_scene_to_stream.h"
+#include "../../streams/voxel_stream_memory.h"
+#include "../../util/containers/container_funcs.h"
+#include "../../util/containers/std_unordered_map.h"
+#include "../../util/godot/classes/file_access.h"
+#include "../../util/math/box3i.h"
+#include "../../util/math/conv.h"
+#include "../testing.h"
+#include <cstring>
+
+namespace zylann::voxel::tests {
+
+namespace {
+
+// Writes the few parts of the .vox format needed to describe a scene
+
+void put_u8(StdVector<uint8_t> &dst, uint8_t v) {
+	dst.push_back(v);
+}
+
+void put_u32(StdVector<uint8_t> &dst, uint32_t v) {
+	for (unsigned int i = 0; i < 4; ++i) {
+		dst.push_back((v >> (i * 8)) & 0xff);
+	}
+}
+
+void put_bytes(StdVector<uint8_t> &dst, const char *s, unsigned int len) {
+	for (unsigned int i = 0; i < len; ++i) {
+		dst.push_back(s[i]);
+	}
+}
+
+void put_string(StdVector<uint8_t> &dst, const char *s) {
+	const uint32_t len = strlen(s);
+	put_u32(dst, len);
+	put_bytes(dst, s, len);
+}
+
+void put_dictionary(StdVector<uint8_t> &dst, Span<const std::pair<const char *, const char *>> items) {
+	put_u32(dst, items.size());
+	for (const std::pair<const char *, const char *> &item : items) {
+		put_string(dst, item.first);
+		put_string(dst, item.second);
+	}
+}
+
+void put_chunk(StdVector<uint8_t> &dst, const char *id, const StdVector<uint8_t> &content, uint32_t children_size) {
+	put_bytes(dst, id, 4);
+	put_u32(dst, content.size());
+	put_u32(dst, children_size);
+	append_array(dst, content);
+}
+
+void put_transform_node(StdVector<uint8_t> &dst, int node_id, int child_node_id,
+		Span<const std::pair<const char *, const char *>> frame) {
+	StdVector<uint8_t> c;
+	put_u32(c, node_id);
+	put_dictionary(c, Span<const std::pair<const char *, const char *>>());
+	put_u32(c, child_node_id);
+	put_u32(c, -1); // Reserved
+	put_u32(c, -1); // Layer
+	put_u32(c, 1); // Frame count
+	put_dictionary(c, frame);
+	put_chunk(dst, "nTRN", c, 0);
+}
+
+} // namespace
+
+void test_vox_scene_to_stream() {
+	// Odd size in every axis, so the center of the model does not fall on a voxel corner
+	const Vector3i magica_model_size(3, 5, 7);
+	// Not a multiple of the block size, so the model overlaps several blocks
+	const char *magica_translation = "14 -3 31";
+	// Rows pick axes 1, 2 and 0, with the first two flipped, which is a rotation: 1 | (2 << 2) | (1 << 4) | (1 << 5)
+	const char *magica_rotation = "57";
+	const unsigned int lod_count = 2;
+
+	zylann::testing::TestDirectory test_dir;
+	ZN_TEST_ASSERT(test_dir.is_valid());
+	const String fpath = test_dir.get_path().path_join("test_scene.vox");
+
+	{
+		StdVector<uint8_t> chunks;
+		StdVector<uint8_t> c;
+
+		put_u32(c, magica_model_size.x);
+		put_u32(c, magica_model_size.y);
+		put_u32(c, magica_model_size.z);
+		put_chunk(chunks, "SIZE", c, 0);
+
+		// Fill the whole model with different colors, so any misplaced voxel gets noticed
+		c.clear();
+		put_u32(c, Vector3iUtil::get_volume(magica_model_size));
+		unsigned int i = 0;
+		for (int z = 0; z < magica_model_size.z; ++z) {
+			for (int y = 0; y < magica_model_size.y; ++y) {
+				for (int x = 0; x < magica_model_size.x; ++x) {
+					put_u8(c, x);
+					put_u8(c, y);
+					put_u8(c, z);
+					put_u8(c, 1 + i % 255);
+					++i;
+				}
+			}
+		}
+		put_chunk(chunks, "XYZI", c, 0);
+
+		// Root transform -> group -> transform -> shape
+		put_transform_node(chunks, 0, 1, Span<const std::pair<const char *, const char *>>());
+
+		c.clear();
+		put_u32(c, 1);
+		put_dictionary(c, Span<const std::pair<const char *, const char *>>());
+		put_u32(c, 1); // Child count
+		put_u32(c, 2);
+		put_chunk(chunks, "nGRP", c, 0);
+
+		const std::pair<const char *, const char *> frame[] = { //
+			{ "_t", magica_translation },
+			{ "_r", magica_rotation }
+		};
+		put_transform_node(chunks, 2, 3, Span<const std::pair<const char *, const char *>>(frame, 2));
+
+		c.clear();
+		put_u32(c, 3);
+		put_dictionary(c, Span<const std::pair<const char *, const char *>>());
+		put_u32(c, 1); // Model count
+		put_u32(c, 0); // Model ID
+		put_dictionary(c, Span<const std::pair<const char *, const char *>>());
+		put_chunk(chunks, "nSHP", c, 0);
+
+		StdVector<uint8_t> file_bytes;
+		put_bytes(file_bytes, "VOX ", 4);
+		put_u32(file_bytes, 150);
+		put_chunk(file_bytes, "MAIN", StdVector<uint8_t>(), chunks.size());
+		append_array(file_bytes, chunks);
+
+		Error err;
+		Ref<FileAccess> f = zylann::godot::open_file(fpath, FileAccess::WRITE, err);
+		ZN_TEST_ASSERT(f.is_valid());
+		zylann::godot::store_buffer(**f, to_span_const(file_bytes));
+	}
+
+	magica::Data data;
+	ZN_TEST_ASSERT(data.load_from_file(fpath) == OK);
+	ZN_TEST_ASSERT(data.get_model_count() == 1);
+	const magica::Model &model = data.get_model(0);
+	const magica::Node *node = data.get_node(2);
+	ZN_TEST_ASSERT(node != nullptr && node->type == magica::Node::TYPE_TRANSFORM);
+	const magica::TransformNode &transform_node = *reinterpret_cast<const magica::TransformNode *>(node);
+	ZN_TEST_ASSERT(transform_node.rotation.basis != Basis());
+
+	// Place voxels the same way the scene importer places meshes: the mesh of a model has its origin at the lower
+	// corner of the model, and is offset by `-(size / 2)` so it rotates around the pivot of the transform.
+	StdUnorderedMap<Vector3i, uint8_t> expected_voxels;
+	Box3i expected_box;
+	{
+		const Vector3 pivot = Vector3(model.size / 2);
+		const Vector3 translation = Vector3(transform_node.position);
+		Vector3i min_pos;
+		Vector3i max_pos;
+		bool first = true;
+
+		Vector3i model_pos;
+		for (model_pos.z = 0; model_pos.z < model.size.z; ++model_pos.z) {
+			for (model_pos.x = 0; model_pos.x < model.size.x; ++model_pos.x) {
+				for (model_pos.y = 0; model_pos.y < model.size.y; ++model_pos.y) {
+					const Vector3 local_center = Vector3(model_pos) + Vector3(0.5, 0.5, 0.5) - pivot;
+					const Vector3 center = transform_node.rotation.basis.xform(local_center) + translation;
+					const Vector3i world_pos = math::floor_to_int(center);
+					const uint8_t v = model.color_indexes[Vector3iUtil::get_zxy_index(model_pos, model.size)];
+					// Rotations map voxels one to one
+					ZN_TEST_ASSERT(expected_voxels.insert({ world_pos, v }).second);
+					if (first) {
+						min_pos = world_pos;
+						max_pos = world_pos;
+						first = false;
+					} else {
+						min_pos = math::min(min_pos, world_pos);
+						max_pos = math::max(max_pos, world_pos);
+					}
+				}
+			}
+		}
+
+		expected_box = Box3i::from_min_max(min_pos, max_pos + Vector3i(1, 1, 1));
+	}
+
+	Ref<VoxelStreamMemory> stream;
+	stream.instantiate();
+
+	magica::SceneToStreamParams params;
+	params.channel = VoxelBuffer::CHANNEL_COLOR;
+	params.lod_count = lod_count;
+	params.batch_size = 2;
+	params.thread_count = 2;
+	ZN_TEST_ASSERT(magica::convert_scene_to_stream(data, **stream, params) == OK);
+
+	const int block_size = 1 << stream->get_block_size_po2();
+
+	for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+		// Check every voxel of blocks around the model. Nothing must be written outside of it, and LODs sample the
+		// lowest corner of the voxels they cover.
+		const Box3i blocks_box = expected_box.downscaled(block_size << lod_index).padded(1);
+
+		blocks_box.for_each_cell_zxy([&stream, &expected_voxels, block_size, lod_index](Vector3i bpos) {
+			VoxelBuffer voxels(VoxelBuffer::ALLOCATOR_DEFAULT);
+			VoxelStream::VoxelQueryData q{ voxels, bpos, static_cast<uint8_t>(lod_index), VoxelStream::RESULT_ERROR };
+			stream->load_voxel_block(q);
+			ZN_TEST_ASSERT(q.result != VoxelStream::RESULT_ERROR);
+			const bool found = q.result == VoxelStream::RESULT_BLOCK_FOUND;
+
+			const Vector3i block_origin = bpos * block_size;
+			const Box3i local_box(Vector3i(), Vector3iUtil::create(block_size));
+
+			local_box.for_each_cell_zxy([&](Vector3i local_pos) {
+				const Vector3i world_pos = (block_origin + local_pos) << lod_index;
+				auto it = expected_voxels.find(world_pos);
+				const uint8_t expected = it != expected_voxels.end() ? it->second : 0;
+				const uint8_t v = found ? voxels.get_voxel(local_pos, VoxelBuffer::CHANNEL_COLOR) : 0;
+				ZN_TEST_ASSERT(v == expected);
+			});
+		});
+	}
+}
+
+} // namespace zylann::voxel::tests
@@ -0,0 +1,10 @@
+#ifndef VOXEL_TESTS_VOX_SCENE_TO_STREAM_H
+#define VOXEL_TESTS_VOX_SCENE_TO_STREAM_H
+
+namespace zylann::voxel::tests {
+
+void test_vox_scene_to_stream();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_VOX_SCENE_TO_STREAM_H
@@ -1,4 +1,5 @@
 #include "test_voxel_graph.h"
+#include "../../generators/float_heightmap.h"
 #include "../../generators/graph/image_range_grid.h"
 #include "../../generators/graph/node_type_db.h"
 #include "../../generators/graph/range_utility.h"
@@ -13,10 +14,12 @@
 #include "../../util/math/conv.h"
 #include "../../util/math/sdf.h"
 #include "../../util/noise/fast_noise_lite/fast_noise_lite.h"
+#include "../../util/noise/spot_noise.h"
 #include "../../util/string/format.h"
 #include "../../util/string/std_string.h"
 #include "../testing.h"
 #include "test_util.h"
+#include <limits>
 #include <sstream>
 
 #ifdef VOXEL_ENABLE_FAST_NOISE_2
@@ -1760,6 +1763,71 @@ void test_voxel_graph_spots2d_optimized_execution_map() {
 	}*/
 }
 
+void test_spot_noise_batch() {
+	static constexpr float cell_size = 8.f;
+	static constexpr float jitter = 0.9f;
+	static constexpr int seed = 1337;
+
+	struct L {
+		static void test(Span<const float> x, Span<const float> y, Span<const float> z, Span<const float> spot_size) {
+			StdVector<float> out;
+			out.resize(x.size());
+
+			SpotNoise::spot_noise_2d(x, y, spot_size, cell_size, jitter, seed, to_span(out));
+			for (unsigned int i = 0; i < out.size(); ++i) {
+				const float expected =
+						SpotNoise::spot_noise_2d(Vector2f(x[i], y[i]), cell_size, spot_size[i], jitter, seed);
+				ZN_TEST_ASSERT(out[i] == expected);
+			}
+
+			SpotNoise::spot_noise_3d(x, y, z, spot_size, cell_size, jitter, seed, to_span(out));
+			for (unsigned int i = 0; i < out.size(); ++i) {
+				const float expected =
+						SpotNoise::spot_noise_3d(Vector3f(x[i], y[i], z[i]), cell_size, spot_size[i], jitter, seed);
+				ZN_TEST_ASSERT(out[i] == expected);
+			}
+		}
+	};
+
+	StdVector<float> x;
+	StdVector<float> y;
+	StdVector<float> z;
+	StdVector<float> spot_size;
+
+	// Positions of a block, covering a few cells
+	for (int zi = 0; zi < 16; ++zi) {
+		for (int xi = 0; xi < 16; ++xi) {
+			for (int yi = 0; yi < 16; ++yi) {
+				x.push_back(xi - 5.f);
+				y.push_back(yi * 0.5f - 3.f);
+				z.push_back(zi + 100.f);
+				spot_size.push_back((xi + yi) % 5);
+			}
+		}
+	}
+	L::test(to_span(x), to_span(y), to_span(z), to_span(spot_size));
+
+	// NaNs don't contribute to the bounds of the batch, and must not be used to lookup cells
+	x[17] = std::numeric_limits<float>::quiet_NaN();
+	L::test(to_span(x), to_span(y), to_span(z), to_span(spot_size));
+	// Also as the first position, which initializes the bounds
+	y[0] = std::numeric_limits<float>::quiet_NaN();
+	L::test(to_span(x), to_span(y), to_span(z), to_span(spot_size));
+
+	// Sparse positions covering more cells than there are positions
+	x.clear();
+	y.clear();
+	z.clear();
+	spot_size.clear();
+	for (int i = 0; i < 64; ++i) {
+		x.push_back(i * 37.f);
+		y.push_back(i * -23.f);
+		z.push_back(i * 11.f);
+		spot_size.push_back(3.f);
+	}
+	L::test(to_span(x), to_span(y), to_span(z), to_span(spot_size));
+}
+
 void test_voxel_graph_unused_inner_output() {
 	// When compiling a graph with an unused output in one if its inner nodes (not an Output* node), compiling in debug
 	// would crash because it tries to allocate an output buffer with 0 users, which should be allowed specifically in
@@ -1879,6 +1947,167 @@ void test_voxel_graph_function_execute() {
 	}
 }
 
+void test_voxel_graph_low_frequency_function() {
+	const float stride = 4.f;
+
+	// Depends on X and Z only, and is linear along Z
+	// f = sin(x * 0.1) + z * 0.5
+	Ref<VoxelGraphFunction> inner_function;
+	inner_function.instantiate();
+	{
+		const uint32_t n_x = inner_function->create_node(VoxelGraphFunction::NODE_INPUT_X, Vector2());
+		const uint32_t n_z = inner_function->create_node(VoxelGraphFunction::NODE_INPUT_Z, Vector2());
+		const uint32_t n_mul_x = inner_function->create_node(VoxelGraphFunction::NODE_MULTIPLY, Vector2());
+		const uint32_t n_mul_z = inner_function->create_node(VoxelGraphFunction::NODE_MULTIPLY, Vector2());
+		const uint32_t n_sin = inner_function->create_node(VoxelGraphFunction::NODE_SIN, Vector2());
+		const uint32_t n_add = inner_function->create_node(VoxelGraphFunction::NODE_ADD, Vector2());
+		const uint32_t n_out = inner_function->create_node(VoxelGraphFunction::NODE_OUTPUT_SDF, Vector2());
+
+		inner_function->set_node_default_input(n_mul_x, 1, 0.1f);
+		inner_function->set_node_default_input(n_mul_z, 1, 0.5f);
+
+		inner_function->add_connection(n_x, 0, n_mul_x, 0);
+		inner_function->add_connection(n_mul_x, 0, n_sin, 0);
+		inner_function->add_connection(n_z, 0, n_mul_z, 0);
+		inner_function->add_connection(n_sin, 0, n_add, 0);
+		inner_function->add_connection(n_mul_z, 0, n_add, 1);
+		inner_function->add_connection(n_add, 0, n_out, 0);
+	}
+
+	//  X ---
+	//  Y --- LowFrequencyFunction --- out
+	//  Z ---
+
+	Ref<VoxelGraphFunction> function;
+	function.instantiate();
+	{
+		const uint32_t n_x = function->create_node(VoxelGraphFunction::NODE_INPUT_X, Vector2());
+		const uint32_t n_y = function->create_node(VoxelGraphFunction::NODE_INPUT_Y, Vector2());
+		const uint32_t n_z = function->create_node(VoxelGraphFunction::NODE_INPUT_Z, Vector2());
+		const uint32_t n_lf = function->create_node(VoxelGraphFunction::NODE_LOW_FREQUENCY_FUNCTION, Vector2());
+		const uint32_t n_out = function->create_node(VoxelGraphFunction::NODE_OUTPUT_SDF, Vector2());
+
+		function->set_node_param(n_lf, 0, inner_function);
+		function->set_node_param(n_lf, 1, stride);
+
+		function->add_connection(n_x, 0, n_lf, 0);
+		function->add_connection(n_y, 0, n_lf, 1);
+		function->add_connection(n_z, 0, n_lf, 2);
+		function->add_connection(n_lf, 0, n_out, 0);
+
+		function->auto_pick_inputs_and_outputs();
+		const CompilationResult result = function->compile(false);
+		ZN_TEST_ASSERT(result.success);
+	}
+
+	// Large enough for the lattice to be used, starting at a position not aligned with the stride
+	const Vector3i origin(-7, 3, 5);
+	const Vector3i size(16, 16, 16);
+	const int volume = Vector3iUtil::get_volume(size);
+
+	StdVector<float> x_buffer;
+	StdVector<float> y_buffer;
+	StdVector<float> z_buffer;
+	StdVector<float> sd_buffer;
+
+	x_buffer.resize(volume);
+	y_buffer.resize(volume);
+	z_buffer.resize(volume);
+	sd_buffer.resize(volume);
+
+	{
+		unsigned int i = 0;
+		for (int z = 0; z < size.z; ++z) {
+			for (int y = 0; y < size.y; ++y) {
+				for (int x = 0; x < size.x; ++x) {
+					x_buffer[i] = origin.x + x;
+					y_buffer[i] = origin.y + y;
+					z_buffer[i] = origin.z + z;
+					++i;
+				}
+			}
+		}
+	}
+
+	Span<float> inputs[3] = { to_span(x_buffer), to_span(y_buffer), to_span(z_buffer) };
+	Span<float> outputs = to_span(sd_buffer);
+	function->execute(Span<Span<float>>(inputs, 3), Span<Span<float>>(&outputs, 1));
+
+	for (int i = 0; i < volume; ++i) {
+		const float x = x_buffer[i];
+		const float z = z_buffer[i];
+		const float obtained_result = sd_buffer[i];
+		const float expected_result = Math::sin(x * 0.1f) + z * 0.5f;
+
+		if (Math::fposmod(x, stride) == 0.f) {
+			// On the lattice along X, and linear along Z, so interpolation is exact
+			ZN_TEST_ASSERT(Math::is_equal_approx(obtained_result, expected_result, 0.001f));
+		} else {
+			// The function doesn't vary much within one stride
+			ZN_TEST_ASSERT(Math::abs(obtained_result - expected_result) < 0.025f);
+		}
+	}
+}
+
+void test_voxel_graph_low_frequency_function_cycle() {
+	struct L {
+		static Ref<VoxelGraphFunction> create_function(uint32_t &out_lf_node_id) {
+			//  X ---
+			//  Y --- LowFrequencyFunction --- out
+			//  Z ---
+			Ref<VoxelGraphFunction> function;
+			function.instantiate();
+			const uint32_t n_x = function->create_node(VoxelGraphFunction::NODE_INPUT_X, Vector2());
+			const uint32_t n_y = function->create_node(VoxelGraphFunction::NODE_INPUT_Y, Vector2());
+			const uint32_t n_z = function->create_node(VoxelGraphFunction::NODE_INPUT_Z, Vector2());
+			const uint32_t n_lf = function->create_node(VoxelGraphFunction::NODE_LOW_FREQUENCY_FUNCTION, Vector2());
+			const uint32_t n_out = function->create_node(VoxelGraphFunction::NODE_OUTPUT_SDF, Vector2());
+			function->add_connection(n_x, 0, n_lf, 0);
+			function->add_connection(n_y, 0, n_lf, 1);
+			function->add_connection(n_z, 0, n_lf, 2);
+			function->add_connection(n_lf, 0, n_out, 0);
+			function->auto_pick_inputs_and_outputs();
+			out_lf_node_id = n_lf;
+			return function;
+		}
+	};
+
+	uint32_t n_lf1;
+	Ref<VoxelGraphFunction> function1 = L::create_function(n_lf1);
+	uint32_t n_lf2;
+	Ref<VoxelGraphFunction> function2 = L::create_function(n_lf2);
+
+	// Referencing itself is rejected, directly or not
+	function1->set_node_param(n_lf1, 0, function1);
+	ZN_TEST_ASSERT(function1->get_node_param(n_lf1, 0) == Variant());
+	function1->set_node_param(n_lf1, 0, function2);
+	ZN_TEST_ASSERT(function1->get_node_param(n_lf1, 0) == Variant(function2));
+	function2->set_node_param(n_lf2, 0, function1);
+	ZN_TEST_ASSERT(function2->get_node_param(n_lf2, 0) == Variant());
+	function1->set_node_param(n_lf1, 0, Variant());
+
+	// Loaded data is not checked the same way, so compiling must still detect the cycle instead of recursing forever
+	{
+		Dictionary data = function1->get_graph_as_variant_data();
+		Dictionary nodes_data = data["nodes"];
+		const Array keys = nodes_data.keys();
+		for (int i = 0; i < keys.size(); ++i) {
+			Dictionary node_data = nodes_data[keys[i]];
+			if (String(node_data["type"]) == "LowFrequencyFunction") {
+				node_data["function"] = function1;
+			}
+		}
+		ZN_TEST_ASSERT(function1->load_graph_from_variant_data(data));
+	}
+	ZN_TEST_ASSERT(function1->get_node_param(n_lf1, 0) == Variant(function1));
+
+	const CompilationResult result = function1->compile(false);
+	ZN_TEST_ASSERT(!result.success);
+
+	// Break the cycle, otherwise the function would reference itself and never be freed
+	function1->set_node_param(n_lf1, 0, Variant());
+}
+
 void test_voxel_graph_image() {
 	struct L {
 		static void test_range(Ref<Image> image, Box3i box, math::Interval expected_bound) {
@@ -2084,6 +2313,62 @@ void test_image_range_grid() {
 			Interval(5 * image_height + image_height - 5, 5 * image_height + image_height + 20));
 }
 
+void test_float_heightmap() {
+	// Not square and not a power of two, to test wrapping
+	Ref<Image> image_ref = zylann::godot::create_empty_image(37, 20, false, Image::FORMAT_RF);
+	Image &image = **image_ref;
+
+	for (int y = 0; y < image.get_height(); ++y) {
+		for (int x = 0; x < image.get_width(); ++x) {
+			const float h = 0.3 * x + 0.1 * y + 0.01f * (x * y % 7);
+			image.set_pixel(x, y, Color(h, h, h));
+		}
+	}
+
+	FloatHeightmap heightmap;
+	heightmap.create_from_image(image, false);
+	ZN_TEST_ASSERT(heightmap.get_mip_count() == 1);
+
+	heightmap.create_from_image(image, true);
+	ZN_TEST_ASSERT(heightmap.get_width() == image.get_width());
+	ZN_TEST_ASSERT(heightmap.get_height() == image.get_height());
+	ZN_TEST_ASSERT(heightmap.get_mip_count() > 1);
+
+	// Nearest sampling matches the image
+	StdVector<float> x_buffer;
+	StdVector<float> y_buffer;
+	StdVector<float> values;
+	for (int y = -25; y < 45; y += 3) {
+		for (int x = -40; x < 80; x += 7) {
+			x_buffer.push_back(x);
+			y_buffer.push_back(y);
+		}
+	}
+	values.resize(x_buffer.size());
+	heightmap.sample_nearest_repeat(to_span(x_buffer), to_span(y_buffer), to_span(values));
+
+	for (unsigned int i = 0; i < values.size(); ++i) {
+		const int x = x_buffer[i];
+		const int y = y_buffer[i];
+		const float expected = image.get_pixel(math::wrap(x, image.get_width()), math::wrap(y, image.get_height())).r;
+		ZN_TEST_ASSERT(values[i] == expected);
+	}
+
+	// Bilinear sampling at pixel positions gives the pixels
+	heightmap.sample_bilinear_repeat(to_span(x_buffer), to_span(y_buffer), to_span(values));
+	for (unsigned int i = 0; i < values.size(); ++i) {
+		const float expected = heightmap.get_pixel_repeat(static_cast<int>(x_buffer[i]), static_cast<int>(y_buffer[i]));
+		ZN_TEST_ASSERT(Math::is_equal_approx(values[i], expected));
+	}
+
+	// Mips of a uniform image are uniform
+	image.fill(Color(0.5f, 0.5f, 0.5f));
+	heightmap.create_from_image(image, true);
+	for (unsigned int mip_index = 0; mip_index < heightmap.get_mip_count() + 1; ++mip_index) {
+		ZN_TEST_ASSERT(Math::is_equal_approx(heightmap.sample_bilinear_repeat(13.3f, -7.6f, mip_index), 0.5f));
+	}
+}
+
 void test_voxel_graph_many_subdivisions() {
 	Ref<VoxelGeneratorGraph> generator;
 	generator.instantiate();
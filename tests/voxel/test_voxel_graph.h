@@ -28,11 +28,15 @@ void test_voxel_graph_hash();
 void test_voxel_graph_issue471();
 void test_voxel_graph_unused_single_texture_output();
 void test_voxel_graph_spots2d_optimized_execution_map();
+void test_spot_noise_batch();
 void test_voxel_graph_unused_inner_output();
 void test_voxel_graph_function_execute();
+void test_voxel_graph_low_frequency_function();
+void test_voxel_graph_low_frequency_function_cycle();
 void test_voxel_graph_image();
 void test_voxel_graph_many_weight_outputs();
 void test_image_range_grid();
+void test_float_heightmap();
 void test_voxel_graph_many_subdivisions();
 
 } // namespace zylann::voxel::tests
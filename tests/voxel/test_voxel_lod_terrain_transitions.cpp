@@ -0,0 +1,146 @@
+#include "test_voxel_lod_terrain_transitions.h"
+#include "../../terrain/variable_lod/voxel_lod_terrain_update_task.h"
+#include "../testing.h"
+
+#include <memory>
+
+namespace zylann::voxel::tests {
+
+void test_voxel_lod_terrain_transition_masks_incremental() {
+	typedef VoxelLodTerrainUpdateData::State State;
+	typedef VoxelLodTerrainUpdateData::MeshBlockState MeshBlockState;
+
+	const unsigned int lod_count = 3;
+
+	struct L {
+		static MeshBlockState &get_or_create(State &state, Vector3i bpos, unsigned int lod_index) {
+			// Mesh block states are not movable, this default-constructs them in place
+			MeshBlockState &block = state.lods[lod_index].mesh_map_state.map[bpos];
+			if (block.mesh_viewers.get() == 0) {
+				block.mesh_viewers.add();
+			}
+			return block;
+		}
+
+		static void activate(State &state, Vector3i bpos, unsigned int lod_index) {
+			get_or_create(state, bpos, lod_index).visual_active = true;
+			state.lods[lod_index].mesh_blocks_to_activate_visuals.push_back(bpos);
+		}
+
+		static void deactivate(State &state, Vector3i bpos, unsigned int lod_index) {
+			get_or_create(state, bpos, lod_index).visual_active = false;
+			state.lods[lod_index].mesh_blocks_to_deactivate_visuals.push_back(bpos);
+		}
+
+		static void split(State &state, Vector3i parent_bpos, unsigned int parent_lod_index) {
+			deactivate(state, parent_bpos, parent_lod_index);
+			for (unsigned int i = 0; i < 8; ++i) {
+				activate(state, (parent_bpos << 1) + Vector3i(i & 1, (i >> 1) & 1, (i >> 2) & 1),
+						parent_lod_index - 1);
+			}
+		}
+
+		static void merge(State &state, Vector3i parent_bpos, unsigned int parent_lod_index) {
+			for (unsigned int i = 0; i < 8; ++i) {
+				deactivate(state, (parent_bpos << 1) + Vector3i(i & 1, (i >> 1) & 1, (i >> 2) & 1),
+						parent_lod_index - 1);
+			}
+			activate(state, parent_bpos, parent_lod_index);
+		}
+
+		static void clear_outputs(State &state) {
+			for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+				VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+				lod.mesh_blocks_to_activate_visuals.clear();
+				lod.mesh_blocks_to_deactivate_visuals.clear();
+				lod.mesh_blocks_to_unload.clear();
+				lod.mesh_blocks_to_update_transitions.clear();
+			}
+		}
+
+		// Masks must be the same as if they were all recomputed
+		static bool check_masks(const State &state) {
+			for (unsigned int lod_index = 0; lod_index < lod_count; ++lod_index) {
+				const VoxelLodTerrainUpdateData::Lod &lod = state.lods[lod_index];
+				for (auto it = lod.mesh_map_state.map.begin(); it != lod.mesh_map_state.map.end(); ++it) {
+					const MeshBlockState &block = it->second;
+					if (!block.visual_active || block.mesh_viewers.get() == 0) {
+						continue;
+					}
+					const uint8_t expected_mask =
+							VoxelLodTerrainUpdateTask::get_transition_mask(state, it->first, lod_index, lod_count);
+					if (block.transition_mask != expected_mask) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		static bool has_transition_update(const State &state, Vector3i bpos, unsigned int lod_index) {
+			for (const VoxelLodTerrainUpdateData::TransitionUpdate &tu :
+					state.lods[lod_index].mesh_blocks_to_update_transitions) {
+				if (tu.block_position == bpos) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	// The state is large, don't put it on the stack
+	std::unique_ptr<State> state_ptr = std::make_unique<State>();
+	State &state = *state_ptr;
+
+	// Start with a 4x4x4 area of LOD1 blocks
+	for (int z = 0; z < 4; ++z) {
+		for (int x = 0; x < 4; ++x) {
+			for (int y = 0; y < 4; ++y) {
+				L::activate(state, Vector3i(x, y, z), 1);
+			}
+		}
+	}
+	update_transition_masks(state, lod_count, true);
+	ZN_TEST_ASSERT(L::check_masks(state));
+	L::clear_outputs(state);
+
+	// Viewer comes closer: the middle block subdivides, its children need transitions towards LOD1 neighbors
+	L::split(state, Vector3i(1, 1, 1), 1);
+	update_transition_masks(state, lod_count, true);
+	ZN_TEST_ASSERT(L::check_masks(state));
+	ZN_TEST_ASSERT(L::has_transition_update(state, Vector3i(2, 2, 2), 0));
+	L::clear_outputs(state);
+
+	// A block of LOD0 gets edited. Its mesh is pending an update, which doesn't change its visual state.
+	const Vector3i edited_bpos(3, 2, 2);
+	L::get_or_create(state, edited_bpos, 0).state = VoxelLodTerrainUpdateData::MESH_NEED_UPDATE;
+
+	// Viewer moves: the LOD1 block next to the edited block subdivides too, and the first one merges back.
+	// This changes LOD around the edited block on both sides.
+	L::split(state, Vector3i(2, 1, 1), 1);
+	L::merge(state, Vector3i(1, 1, 1), 1);
+	// A block without viewers doesn't get its mask updated
+	const Vector3i unviewed_bpos(5, 3, 3);
+	MeshBlockState &unviewed_block = L::get_or_create(state, unviewed_bpos, 0);
+	unviewed_block.mesh_viewers.remove();
+
+	update_transition_masks(state, lod_count, true);
+	ZN_TEST_ASSERT(L::check_masks(state));
+	ZN_TEST_ASSERT(!L::has_transition_update(state, unviewed_bpos, 0));
+	ZN_TEST_ASSERT(unviewed_block.transition_mask == 0);
+	// The edited block was deactivated by the merge
+	ZN_TEST_ASSERT(!L::has_transition_update(state, edited_bpos, 0));
+	// Its neighbor across the new boundary now has LOD1 on its -X side
+	ZN_TEST_ASSERT(L::has_transition_update(state, Vector3i(4, 2, 2), 0));
+	L::clear_outputs(state);
+
+	// Without refcounts, blocks without viewers are updated too
+	state.lods[0].mesh_blocks_to_activate_visuals.push_back(unviewed_bpos);
+	update_transition_masks(state, lod_count, false);
+	ZN_TEST_ASSERT(L::has_transition_update(state, unviewed_bpos, 0));
+	ZN_TEST_ASSERT(unviewed_block.transition_mask != 0);
+	ZN_TEST_ASSERT(unviewed_block.transition_mask ==
+			VoxelLodTerrainUpdateTask::get_transition_mask(state, unviewed_bpos, 0, lod_count));
+}
+
+} // namespace zylann::voxel::tests
@@ -0,0 +1,10 @@
+#ifndef VOXEL_TESTS_VOXEL_LOD_TERRAIN_TRANSITIONS_H
+#define VOXEL_TESTS_VOXEL_LOD_TERRAIN_TRANSITIONS_H
+
+namespace zylann::voxel::tests {
+
+void test_voxel_lod_terrain_transition_masks_incremental();
+
+} // namespace zylann::voxel::tests
+
+#endif // VOXEL_TESTS_VOXEL_LOD_TERRAIN_TRANSITIONS_H
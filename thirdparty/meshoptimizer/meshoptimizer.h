@@ -313,6 +313,14 @@ MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterExp(void* buffer, size_t ver
  */
 MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error);
 
+/**
+ * Zylann: Experimental: Mesh simplifier with locked vertices
+ * Same as meshopt_simplify, but vertices can be prevented from moving, for example to preserve attributes that are not taken into account by the simplifier.
+ *
+ * vertex_lock can be NULL; when it's not NULL, it should have vertex_count elements, non-zero for vertices that can't move. Vertices with the same position as a locked vertex are also locked.
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithVertexLock(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned char* vertex_lock, size_t target_index_count, float target_error, float* result_error);
+
 /**
  * Experimental: Mesh simplifier (sloppy)
  * Reduces the number of triangles in the mesh, sacrificing mesh apperance for simplification performance
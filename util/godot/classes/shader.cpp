@@ -4,6 +4,80 @@
 
 namespace zylann::godot {
 
+namespace {
+
+// Comments are replaced with a space, so tokens on both sides remain separate
+String remove_shader_comments(const String &code) {
+	String result;
+	int pos = 0;
+	while (pos < code.length()) {
+		const int line_comment_pos = code.find("//", pos);
+		const int block_comment_pos = code.find("/*", pos);
+
+		int comment_pos;
+		int comment_end;
+		if (line_comment_pos != -1 && (block_comment_pos == -1 || line_comment_pos < block_comment_pos)) {
+			comment_pos = line_comment_pos;
+			comment_end = code.find("\n", line_comment_pos);
+		} else if (block_comment_pos != -1) {
+			comment_pos = block_comment_pos;
+			comment_end = code.find("*/", block_comment_pos);
+			if (comment_end != -1) {
+				comment_end += 2;
+			}
+		} else {
+			result += code.substr(pos, code.length() - pos);
+			break;
+		}
+
+		result += code.substr(pos, comment_pos - pos);
+		result += " ";
+		if (comment_end == -1) {
+			// Comment runs until the end of the code
+			break;
+		}
+		pos = comment_end;
+	}
+	return result;
+}
+
+// Turns every sequence of whitespace into a single space
+String normalize_shader_whitespace(const String &code) {
+	String result = code.replace("\t", " ").replace("\r", " ").replace("\n", " ");
+	while (result.find("  ") != -1) {
+		result = result.replace("  ", " ");
+	}
+	return result;
+}
+
+} // namespace
+
+bool shader_has_instance_uniform(const Shader &shader, const String &uniform_name) {
+	const String code = normalize_shader_whitespace(remove_shader_comments(shader.get_code()));
+	const String keyword = "instance uniform ";
+
+	int pos = code.find(keyword);
+	while (pos != -1) {
+		const int end = code.find(";", pos);
+		if (end == -1) {
+			break;
+		}
+		// Must not be the end of another identifier
+		if (pos == 0 || code[pos - 1] == ' ' || code[pos - 1] == ';' || code[pos - 1] == '}') {
+			// instance uniform [precision] <type> <name> [: hints] [= default];
+			const String declaration = code.substr(pos + keyword.length(), end - pos - keyword.length());
+			const String name_part = declaration.get_slice(":", 0).get_slice("=", 0).strip_edges();
+			const PackedStringArray tokens = name_part.split(" ", false);
+			if (tokens.size() > 0 && tokens[tokens.size() - 1] == uniform_name) {
+				return true;
+			}
+		}
+		pos = code.find(keyword, end);
+	}
+
+	return false;
+}
+
 #ifdef TOOLS_ENABLED
 
 // TODO Cannot use `Shader.has_uniform()` because it is unreliable.
@@ -8,12 +8,22 @@
 using namespace godot;
 #endif
 
-#ifdef TOOLS_ENABLED
-
 #include "../../containers/span.h"
 
 namespace zylann::godot {
 
+// Tells if the shader declares an `instance uniform` with the given name. Those are not listed by
+// `get_shader_parameter_list`, because they are set on geometry instances rather than materials.
+// This only parses the code of the shader itself, ignoring comments and formatting. Declarations coming from
+// `#include` files or produced by preprocessor macros are not found.
+bool shader_has_instance_uniform(const Shader &shader, const String &uniform_name);
+
+} // namespace zylann::godot
+
+#ifdef TOOLS_ENABLED
+
+namespace zylann::godot {
+
 // TODO Cannot use `Shader.has_uniform()` because it is unreliable.
 // See https://github.com/godotengine/godot/issues/64467
 bool shader_has_uniform(const Shader &shader, StringName uniform_name);
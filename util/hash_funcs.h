@@ -43,6 +43,16 @@ inline uint32_t hash_fmix32(uint32_t h) {
 	return h;
 }
 
+inline uint64_t hash_fmix64(uint64_t k) {
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+
+	return k;
+}
+
 } // namespace zylann
 
 #endif // ZN_HASH_FUNCS_H
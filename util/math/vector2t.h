@@ -96,6 +96,16 @@ T cross(const Vector2T<T> &a, const Vector2T<T> &b) {
 	return a.x * b.y - a.y * b.x;
 }
 
+template <typename T>
+inline Vector2T<T> min(const Vector2T<T> a, const Vector2T<T> b) {
+	return Vector2T<T>(min(a.x, b.x), min(a.y, b.y));
+}
+
+template <typename T>
+inline Vector2T<T> max(const Vector2T<T> a, const Vector2T<T> b) {
+	return Vector2T<T>(max(a.x, b.x), max(a.y, b.y));
+}
+
 template <typename T>
 inline Vector2T<T> abs(const Vector2T<T> v) {
 	return Vector2T<T>(Math::abs(v.x), Math::abs(v.y));
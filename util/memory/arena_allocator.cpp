@@ -0,0 +1,63 @@
+#include "arena_allocator.h"
+#include "../errors.h"
+#include "../io/log.h"
+#include "memory.h"
+
+namespace zylann {
+
+ArenaAllocator::ArenaAllocator(size_t capacity) : _capacity(capacity) {}
+
+ArenaAllocator::~ArenaAllocator() {
+	if (_allocation_count > 0) {
+		// Leaking is preferable to freeing memory that is still in use
+		ZN_PRINT_ERROR("Arena destroyed while memory allocated from it is still in use");
+		return;
+	}
+	if (_data != nullptr) {
+		ZN_FREE(_data);
+	}
+}
+
+void *ArenaAllocator::allocate(size_t size) {
+	const size_t aligned_size = get_aligned_size(size);
+
+	if (_data == nullptr) {
+		_data = static_cast<uint8_t *>(ZN_ALLOC(_capacity));
+		ZN_ASSERT(_data != nullptr);
+		// Godot's allocator aligns to at least 16 bytes
+		ZN_ASSERT((reinterpret_cast<uintptr_t>(_data) % ALIGNMENT) == 0);
+	}
+
+	if (_offset + aligned_size > _capacity) {
+		// Doesn't fit
+		return ZN_ALLOC(size);
+	}
+
+	uint8_t *ptr = _data + _offset;
+	_offset += aligned_size;
+	++_allocation_count;
+	return ptr;
+}
+
+void ArenaAllocator::free(void *ptr, size_t size) {
+	if (ptr == nullptr) {
+		return;
+	}
+	if (!owns(ptr)) {
+		ZN_FREE(ptr);
+		return;
+	}
+
+	ZN_ASSERT(_allocation_count > 0);
+	--_allocation_count;
+
+	if (_allocation_count == 0) {
+		_offset = 0;
+
+	} else if (static_cast<uint8_t *>(ptr) + get_aligned_size(size) == _data + _offset) {
+		// Last allocation
+		_offset -= get_aligned_size(size);
+	}
+}
+
+} // namespace zylann
@@ -0,0 +1,54 @@
+#ifndef ZYLANN_ARENA_ALLOCATOR_H
+#define ZYLANN_ARENA_ALLOCATOR_H
+
+#include "../non_copyable.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace zylann {
+
+// Allocates memory by bumping an offset into a buffer of fixed capacity, which is faster than general-purpose
+// allocators and doesn't cause fragmentation. Intended for short-lived allocations, such as temporary buffers used
+// within a task:
+// - Freeing the last allocation gives its memory back immediately;
+// - Other allocations only give their memory back once all allocations are freed, at which point the arena is reset.
+// Allocations that don't fit in the remaining capacity fall back to the heap.
+// Not thread-safe. Memory must be freed on the same thread it was allocated from.
+class ArenaAllocator : public NonCopyable {
+public:
+	static const unsigned int ALIGNMENT = 16;
+
+	ArenaAllocator(size_t capacity);
+	~ArenaAllocator();
+
+	void *allocate(size_t size);
+	// `size` must be the same as the one used when allocating.
+	void free(void *ptr, size_t size);
+
+	inline size_t get_used_size() const {
+		return _offset;
+	}
+
+	inline unsigned int get_allocation_count() const {
+		return _allocation_count;
+	}
+
+private:
+	inline bool owns(const void *ptr) const {
+		return ptr >= _data && ptr < _data + _capacity;
+	}
+
+	static inline size_t get_aligned_size(size_t size) {
+		return (size + ALIGNMENT - 1) & ~(static_cast<size_t>(ALIGNMENT) - 1);
+	}
+
+	// Allocated on first use, so threads that never need temporary memory don't pay for it
+	uint8_t *_data = nullptr;
+	size_t _capacity;
+	size_t _offset = 0;
+	unsigned int _allocation_count = 0;
+};
+
+} // namespace zylann
+
+#endif // ZYLANN_ARENA_ALLOCATOR_H
@@ -0,0 +1,144 @@
+#include "spot_noise.h"
+#include "../containers/std_vector.h"
+#include "../errors.h"
+#include "../profiling.h"
+
+namespace zylann::SpotNoise {
+
+// Positions in a batch are usually close to each other (they often come from the same block of voxels), so they share
+// the same few cells. Instead of hashing the cell of every position, spots of all cells covered by the batch are
+// computed once into a small table. Results are exactly the same as the single-position functions.
+// If the batch covers more cells than it has positions, they are probably too sparse to benefit from this, so we fall
+// back on the single-position functions.
+
+void spot_noise_2d(Span<const float> x_buffer, Span<const float> y_buffer, Span<const float> spot_size_buffer,
+		float cell_size, float jitter, int seed, Span<float> out_values) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT_RETURN(x_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(y_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(spot_size_buffer.size() == out_values.size());
+
+	if (out_values.size() == 0) {
+		return;
+	}
+
+	vec2 min_pos(x_buffer[0], y_buffer[0]);
+	vec2 max_pos = min_pos;
+	for (unsigned int i = 1; i < out_values.size(); ++i) {
+		const vec2 pos(x_buffer[i], y_buffer[i]);
+		min_pos = math::min(min_pos, pos);
+		max_pos = math::max(max_pos, pos);
+	}
+
+	const vec2 min_cell_origin_norm = math::floor(min_pos / cell_size);
+	const vec2 cell_count_f = math::floor(max_pos / cell_size) - min_cell_origin_norm + vec2(1.f);
+
+	// Written this way so it is also false with NaNs
+	if (!(cell_count_f.x * cell_count_f.y <= static_cast<float>(out_values.size()))) {
+		for (unsigned int i = 0; i < out_values.size(); ++i) {
+			out_values[i] = spot_noise_2d(
+					vec2(x_buffer[i], y_buffer[i]), cell_size, spot_size_buffer[i], jitter, seed);
+		}
+		return;
+	}
+
+	const ivec2 min_cell = to_vec2i(min_cell_origin_norm);
+	const ivec2 cell_count = to_vec2i(cell_count_f);
+
+	static thread_local StdVector<vec2> tls_spot_positions;
+	StdVector<vec2> &spot_positions = tls_spot_positions;
+	spot_positions.resize(Vector2iUtil::get_area(cell_count));
+
+	unsigned int spot_index = 0;
+	for (int cy = 0; cy < cell_count.y; ++cy) {
+		for (int cx = 0; cx < cell_count.x; ++cx) {
+			const vec2 cell_origin_norm = min_cell_origin_norm + vec2(cx, cy);
+			const vec2 spot_pos_norm = get_spot_position_2d_norm(min_cell + ivec2(cx, cy), jitter, seed);
+			spot_positions[spot_index] = (cell_origin_norm + spot_pos_norm) * cell_size;
+			++spot_index;
+		}
+	}
+
+	for (unsigned int i = 0; i < out_values.size(); ++i) {
+		const vec2 pos(x_buffer[i], y_buffer[i]);
+		const ivec2 cell = to_vec2i(math::floor(pos / cell_size)) - min_cell;
+		if (cell.x < 0 || cell.y < 0 || cell.x >= cell_count.x || cell.y >= cell_count.y) {
+			// NaNs are not accounted for in bounds
+			out_values[i] = spot_noise_2d(pos, cell_size, spot_size_buffer[i], jitter, seed);
+			continue;
+		}
+		const vec2 spot_pos = spot_positions[cell.x + cell.y * cell_count.x];
+		const float spot_size = spot_size_buffer[i];
+		out_values[i] = float(math::distance_squared(spot_pos, pos) < spot_size * spot_size);
+	}
+}
+
+void spot_noise_3d(Span<const float> x_buffer, Span<const float> y_buffer, Span<const float> z_buffer,
+		Span<const float> spot_size_buffer, float cell_size, float jitter, int seed, Span<float> out_values) {
+	ZN_PROFILE_SCOPE();
+	ZN_ASSERT_RETURN(x_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(y_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(z_buffer.size() == out_values.size());
+	ZN_ASSERT_RETURN(spot_size_buffer.size() == out_values.size());
+
+	if (out_values.size() == 0) {
+		return;
+	}
+
+	vec3 min_pos(x_buffer[0], y_buffer[0], z_buffer[0]);
+	vec3 max_pos = min_pos;
+	for (unsigned int i = 1; i < out_values.size(); ++i) {
+		const vec3 pos(x_buffer[i], y_buffer[i], z_buffer[i]);
+		min_pos = math::min(min_pos, pos);
+		max_pos = math::max(max_pos, pos);
+	}
+
+	const vec3 min_cell_origin_norm = math::floor(min_pos / cell_size);
+	const vec3 cell_count_f = math::floor(max_pos / cell_size) - min_cell_origin_norm + vec3(1.f);
+
+	// Written this way so it is also false with NaNs
+	if (!(cell_count_f.x * cell_count_f.y * cell_count_f.z <= static_cast<float>(out_values.size()))) {
+		for (unsigned int i = 0; i < out_values.size(); ++i) {
+			out_values[i] = spot_noise_3d(vec3(x_buffer[i], y_buffer[i], z_buffer[i]), cell_size,
+					spot_size_buffer[i], jitter, seed);
+		}
+		return;
+	}
+
+	const ivec3 min_cell = to_vec3i(min_cell_origin_norm);
+	const ivec3 cell_count = to_vec3i(cell_count_f);
+
+	static thread_local StdVector<vec3> tls_spot_positions;
+	StdVector<vec3> &spot_positions = tls_spot_positions;
+	spot_positions.resize(Vector3iUtil::get_volume(cell_count));
+
+	unsigned int spot_index = 0;
+	for (int cz = 0; cz < cell_count.z; ++cz) {
+		for (int cy = 0; cy < cell_count.y; ++cy) {
+			for (int cx = 0; cx < cell_count.x; ++cx) {
+				const vec3 cell_origin_norm = min_cell_origin_norm + vec3(cx, cy, cz);
+				const vec3 spot_pos_norm = get_spot_position_3d_norm(min_cell + ivec3(cx, cy, cz), jitter, seed);
+				spot_positions[spot_index] = (cell_origin_norm + spot_pos_norm) * cell_size;
+				++spot_index;
+			}
+		}
+	}
+
+	const int cell_count_xy = cell_count.x * cell_count.y;
+
+	for (unsigned int i = 0; i < out_values.size(); ++i) {
+		const vec3 pos(x_buffer[i], y_buffer[i], z_buffer[i]);
+		const ivec3 cell = to_vec3i(math::floor(pos / cell_size)) - min_cell;
+		if (cell.x < 0 || cell.y < 0 || cell.z < 0 || cell.x >= cell_count.x || cell.y >= cell_count.y ||
+				cell.z >= cell_count.z) {
+			// NaNs are not accounted for in bounds
+			out_values[i] = spot_noise_3d(pos, cell_size, spot_size_buffer[i], jitter, seed);
+			continue;
+		}
+		const vec3 spot_pos = spot_positions[cell.x + cell.y * cell_count.x + cell.z * cell_count_xy];
+		const float spot_size = spot_size_buffer[i];
+		out_values[i] = float(math::distance_squared(spot_pos, pos) < spot_size * spot_size);
+	}
+}
+
+} // namespace zylann::SpotNoise
@@ -1,6 +1,7 @@
 #ifndef ZN_SPOT_NOISE_H
 #define ZN_SPOT_NOISE_H
 
+#include "../containers/span.h"
 #include "../math/conv.h"
 #include "../math/interval.h"
 
@@ -102,6 +103,12 @@ inline float spot_noise_3d(vec3 pos, float cell_size, float spot_size, float jit
 	return float(ds < spot_size * spot_size);
 }
 
+// Batched versions, faster when positions are close to each other
+void spot_noise_2d(Span<const float> x_buffer, Span<const float> y_buffer, Span<const float> spot_size_buffer,
+		float cell_size, float jitter, int seed, Span<float> out_values);
+void spot_noise_3d(Span<const float> x_buffer, Span<const float> y_buffer, Span<const float> z_buffer,
+		Span<const float> spot_size_buffer, float cell_size, float jitter, int seed, Span<float> out_values);
+
 inline bool box_intersects(Vector2f a_min, Vector2f a_max, Vector2f b_min, Vector2f b_max) {
 	if (a_min.x >= b_max.x) {
 		return false;
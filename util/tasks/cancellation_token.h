@@ -39,6 +39,11 @@ public:
 		return *_cancelled;
 	}
 
+	// For use in code where a token is optional. Returns true only if the token is valid and was cancelled.
+	inline bool is_valid_and_cancelled() const {
+		return _cancelled != nullptr && *_cancelled;
+	}
+
 private:
 	std::shared_ptr<std::atomic_bool> _cancelled;
 };
@@ -1,6 +1,7 @@
 #include "threaded_task_runner.h"
 #include "../dstack.h"
 #include "../godot/classes/time.h"
+#include "../memory/memory.h"
 #include "../profiling.h"
 #include "../string/format.h"
 
@@ -12,8 +13,10 @@ ThreadedTaskRunner::~ThreadedTaskRunner() {
 	destroy_all_threads();
 
 	// We don't have ownership over tasks, so it's an error to destroy the pool without handling them
-	if (_staged_tasks.size() != 0) {
+	StagedBatch *staged_batches = take_staged_batches();
+	if (staged_batches != nullptr) {
 		ZN_PRINT_ERROR("There are staged tasks remaining!");
+		delete_staged_batches(staged_batches);
 	}
 	if (_tasks.size() != 0) {
 		ZN_PRINT_ERROR("There are tasks remaining!");
@@ -104,50 +107,94 @@ void ThreadedTaskRunner::set_priority_update_period(uint32_t milliseconds) {
 void ThreadedTaskRunner::enqueue(IThreadedTask *task, bool serial) {
 	ZN_PROFILE_SCOPE();
 	ZN_ASSERT(task != nullptr);
-	TaskItem t;
-	t.task = task;
-	t.is_serial = serial;
-	{
-		MutexLock lock(_staged_tasks_mutex);
-		_staged_tasks.push_back(t);
-		++_debug_received_tasks;
-
+	StagedBatch *batch = ZN_NEW(StagedBatch);
+	batch->single_task.task = task;
+	batch->single_task.is_serial = serial;
 #ifdef ZN_THREADED_TASK_RUNNER_CHECK_DUPLICATE_TASKS
-		debug_add_owned_task(task);
+	debug_add_owned_task(task);
 #endif
-	}
+	push_staged_batch(batch);
 	// TODO Do I need to post a certain amount of times?
 	// I feel like this causes the semaphore to be passed too many times when tasks become empty
 	_tasks_semaphore.post();
 }
 
 void ThreadedTaskRunner::enqueue(Span<IThreadedTask *> new_tasks, bool serial) {
-#ifdef DEBUG_ENABLED
-	for (size_t i = 0; i < new_tasks.size(); ++i) {
-		ZN_ASSERT(new_tasks[i] != nullptr);
+	if (new_tasks.size() == 0) {
+		return;
 	}
+	if (new_tasks.size() == 1) {
+		// Doesn't need a vector
+		enqueue(new_tasks[0], serial);
+		return;
+	}
+	StagedBatch *batch = ZN_NEW(StagedBatch);
+	append_staged_tasks(*batch, new_tasks, serial);
+	push_staged_batch(batch);
+	// TODO Do I need to post a certain amount of times?
+	// Should it be the number of threads instead of number of tasks?
+	_tasks_semaphore.post(new_tasks.size());
+}
+
+void ThreadedTaskRunner::enqueue(Span<IThreadedTask *> parallel_tasks, Span<IThreadedTask *> serial_tasks) {
+	const size_t count = parallel_tasks.size() + serial_tasks.size();
+	if (count == 0) {
+		return;
+	}
+	StagedBatch *batch = ZN_NEW(StagedBatch);
+	batch->tasks.reserve(count);
+	append_staged_tasks(*batch, parallel_tasks, false);
+	append_staged_tasks(*batch, serial_tasks, true);
+	push_staged_batch(batch);
+	_tasks_semaphore.post(count);
+}
+
+void ThreadedTaskRunner::append_staged_tasks(StagedBatch &batch, Span<IThreadedTask *> new_tasks, bool serial) {
+	const size_t dst_begin = batch.tasks.size();
+	batch.tasks.resize(dst_begin + new_tasks.size());
+	for (size_t i = 0; i < new_tasks.size(); ++i) {
+		IThreadedTask *new_task = new_tasks[i];
+#ifdef DEBUG_ENABLED
+		ZN_ASSERT(new_task != nullptr);
 #endif
-	{
-		MutexLock lock(_staged_tasks_mutex);
-		const size_t dst_begin = _staged_tasks.size();
-		_staged_tasks.resize(_staged_tasks.size() + new_tasks.size());
-		for (size_t i = 0; i < new_tasks.size(); ++i) {
-			IThreadedTask *new_task = new_tasks[i];
-			TaskItem t;
-			t.task = new_task;
-			t.is_serial = serial;
-			_staged_tasks[dst_begin + i] = t;
+		TaskItem t;
+		t.task = new_task;
+		t.is_serial = serial;
+		batch.tasks[dst_begin + i] = t;
 
 #ifdef ZN_THREADED_TASK_RUNNER_CHECK_DUPLICATE_TASKS
-			debug_add_owned_task(new_task);
+		debug_add_owned_task(new_task);
 #endif
-		}
-		_debug_received_tasks += new_tasks.size();
 	}
-	// TODO Do I need to post a certain amount of times?
-	// Should it be the number of threads instead of number of tasks?
-	for (size_t i = 0; i < new_tasks.size(); ++i) {
-		_tasks_semaphore.post();
+}
+
+void ThreadedTaskRunner::push_staged_batch(StagedBatch *batch) {
+	_debug_received_tasks.fetch_add(batch->get_tasks().size(), std::memory_order_relaxed);
+	batch->next = _staged_batches.load(std::memory_order_relaxed);
+	// If another thread pushed a batch in the meantime, `next` is updated to the new head and we try again
+	while (!_staged_batches.compare_exchange_weak(
+			batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+}
+
+ThreadedTaskRunner::StagedBatch *ThreadedTaskRunner::take_staged_batches() {
+	StagedBatch *batch = _staged_batches.exchange(nullptr, std::memory_order_acquire);
+	// Batches are pushed at the head, so reverse them to get older tasks first
+	StagedBatch *first = nullptr;
+	while (batch != nullptr) {
+		StagedBatch *next = batch->next;
+		batch->next = first;
+		first = batch;
+		batch = next;
+	}
+	return first;
+}
+
+void ThreadedTaskRunner::delete_staged_batches(StagedBatch *first) {
+	while (first != nullptr) {
+		StagedBatch *next = first->next;
+		ZN_DELETE(first);
+		first = next;
 	}
 }
 
@@ -176,6 +223,7 @@ void ThreadedTaskRunner::thread_func(ThreadData &data) {
 	while (!data.stop) {
 		bool is_running_serial_task = false;
 		bool task_queue_was_empty = false;
+		StagedBatch *staged_batches = nullptr;
 		{
 			ZN_PROFILE_SCOPE_NAMED("Task pickup");
 
@@ -202,12 +250,13 @@ void ThreadedTaskRunner::thread_func(ThreadData &data) {
 				//
 				MutexLock lock(_tasks_mutex);
 
-				// Move tasks from the staging queue.
-				// Lock with minimal risk of blocking the main thread, it should be very short.
-				if (_staged_tasks_mutex.try_lock()) {
-					append_array(_tasks, _staged_tasks);
-					_staged_tasks.clear();
-					_staged_tasks_mutex.unlock();
+				// Move tasks from the staging list.
+				// This doesn't block threads scheduling tasks, they can keep pushing new batches meanwhile.
+				staged_batches = take_staged_batches();
+				for (const StagedBatch *batch = staged_batches; batch != nullptr; batch = batch->next) {
+					for (const TaskItem &item : batch->get_tasks()) {
+						_tasks.push_back(item);
+					}
 				}
 
 				// Pick best tasks from the prioritized queue
@@ -292,6 +341,9 @@ void ThreadedTaskRunner::thread_func(ThreadData &data) {
 			} // Tasks queue mutex lock
 		}
 
+		// Freed outside of the lock, other threads may be waiting for it
+		delete_staged_batches(staged_batches);
+
 		if (cancelled_tasks.size() > 0) {
 			MutexLock lock(_completed_tasks_mutex);
 			const size_t count = cancelled_tasks.size();
@@ -415,11 +467,7 @@ void ThreadedTaskRunner::wait_for_all_tasks() {
 	while (true) {
 		// TODO this is not really precise, because running tasks can schedule more tasks. Not sure if we need it?
 		// Waiting for all threads to be in waiting state is a more definitive solution.
-		bool any_staged_tasks = false;
-		{
-			MutexLock lock3(_staged_tasks_mutex);
-			any_staged_tasks = _staged_tasks.size() > 0;
-		}
+		const bool any_staged_tasks = _staged_batches.load(std::memory_order_acquire) != nullptr;
 		if (!any_staged_tasks) {
 			MutexLock lock(_tasks_mutex);
 			if (_tasks.size() == 0) {
@@ -64,9 +64,12 @@ public:
 	// Tasks scheduled with `serial=false` can run in parallel using multiple threads.
 	// Serial execution is useful when such tasks cannot run in parallel due to locking a shared resource. This avoids
 	// clogging up all threads with waiting tasks.
+	// Scheduling doesn't lock, so it stays cheap when many threads schedule tasks at the same time.
 	void enqueue(IThreadedTask *task, bool serial);
-	// Schedules multiple tasks at once. Involves less internal locking.
+	// Schedules multiple tasks at once, which is cheaper than scheduling them one by one.
 	void enqueue(Span<IThreadedTask *> new_tasks, bool serial);
+	// Schedules parallel and serial tasks at once.
+	void enqueue(Span<IThreadedTask *> parallel_tasks, Span<IThreadedTask *> serial_tasks);
 
 	template <typename F>
 	void dequeue_completed_tasks(F f) {
@@ -127,6 +130,27 @@ private:
 		}
 	};
 
+	// Tasks scheduled together
+	struct StagedBatch {
+		// Tasks scheduled one by one are stored here instead of `tasks`, so they only need one allocation
+		TaskItem single_task;
+		StdVector<TaskItem> tasks;
+		StagedBatch *next = nullptr;
+
+		inline Span<const TaskItem> get_tasks() const {
+			if (single_task.task != nullptr) {
+				return Span<const TaskItem>(&single_task, 1);
+			}
+			return to_span(tasks);
+		}
+	};
+
+	void append_staged_tasks(StagedBatch &batch, Span<IThreadedTask *> new_tasks, bool serial);
+	void push_staged_batch(StagedBatch *batch);
+	// Removes all staged batches, in the order they were pushed. Returns the first one.
+	StagedBatch *take_staged_batches();
+	static void delete_staged_batches(StagedBatch *first);
+
 	static void thread_func_static(void *p_data);
 	void thread_func(ThreadData &data);
 
@@ -143,8 +167,9 @@ private:
 
 	// Scheduled tasks are put here first. They will be moved to the main waiting queue by the next available thread.
 	// This is because the main waiting queue can be locked for longer due to dynamic priority sorting.
-	StdVector<TaskItem> _staged_tasks;
-	Mutex _staged_tasks_mutex;
+	// It is a lock-free linked list of batches, so threads scheduling tasks don't block each other. Batches are pushed
+	// at the head, and are only ever taken out all at once, which avoids the ABA problem.
+	std::atomic<StagedBatch *> _staged_batches = { nullptr };
 
 	// Main waiting list. Tasks are picked from it by priority. Priority can also change while tasks are in this list,
 	// so we can't use a simple queue or sort at insertion. Every available thread has to find it and potentially update
@@ -169,7 +194,7 @@ private:
 
 	StdString _name;
 
-	unsigned int _debug_received_tasks = 0;
+	std::atomic_uint32_t _debug_received_tasks = { 0 };
 	unsigned int _debug_completed_tasks = 0;
 	unsigned int _debug_taken_out_tasks = 0;
 
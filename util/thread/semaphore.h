@@ -14,6 +14,20 @@ public:
 		_condition.notify_one();
 	}
 
+	// Same as calling `post()` multiple times, but locks only once
+	inline void post(unsigned int count) const {
+		if (count == 0) {
+			return;
+		}
+		std::lock_guard<decltype(_mutex)> lock(_mutex);
+		_count += count;
+		if (count == 1) {
+			_condition.notify_one();
+		} else {
+			_condition.notify_all();
+		}
+	}
+
 	inline void wait() const {
 		std::unique_lock<decltype(_mutex)> lock(_mutex);
 		while (_count == 0) { // Handle spurious wake-ups.